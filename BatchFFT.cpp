@@ -0,0 +1,221 @@
+#include "BatchFFT.h"
+#include <thread>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BATCHFFT_USE_SSE2 1
+#endif
+
+BatchFFT::BatchFFT(unsigned maxThreads)
+    : m_maxThreads(1)
+    , m_scratch(1)
+    , m_generation(0)
+    , m_pending(0)
+    , m_stop(false)
+    , m_plan(nullptr)
+    , m_data(nullptr)
+    , m_channels(0)
+{
+    setMaxThreads(maxThreads);
+}
+
+BatchFFT::~BatchFFT()
+{
+    stopWorkers();
+}
+
+void BatchFFT::setMaxThreads(unsigned maxThreads)
+{
+    if (maxThreads == 0) {
+        maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (maxThreads != m_maxThreads) {
+        // The pool is restarted at the new size on the next parallel call
+        stopWorkers();
+    }
+    m_maxThreads = maxThreads;
+}
+
+void BatchFFT::startWorkers()
+{
+    const size_t workers = m_maxThreads - 1;
+    m_scratch.resize(workers + 1);
+    m_ranges.resize(workers + 1);
+    m_workers.reserve(workers);
+    for (size_t w = 0; w < workers; ++w) {
+        m_workers.emplace_back(&BatchFFT::workerLoop, this, w + 1);
+    }
+}
+
+void BatchFFT::stopWorkers()
+{
+    if (m_workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    m_scratch.resize(1);
+    // Workers started later begin from generation 0 again
+    m_generation = 0;
+    m_stop = false;
+}
+
+void BatchFFT::workerLoop(size_t index)
+{
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [&]() { return m_stop || m_generation != seen; });
+        if (m_stop) return;
+        seen = m_generation;
+
+        // Workers past the job's thread count sit this one out
+        const BlockRange range = m_ranges[index];
+        if (range.begin == range.end) continue;
+        const FFTPlan& plan = *m_plan;
+        std::complex<float>* data = m_data;
+        const size_t channels = m_channels;
+
+        lock.unlock();
+        transformBlocks(plan, data, channels, range.begin, range.end, m_scratch[index]);
+        lock.lock();
+        if (--m_pending == 0) {
+            m_done.notify_one();
+        }
+    }
+}
+
+void BatchFFT::forward(std::complex<float>* data, size_t channels, size_t n)
+{
+    if (channels == 0 || n <= 1) return;
+
+    // Build (or fetch) the plan on the calling thread; workers only read it
+    const FFTPlan& plan = m_engine.plan(n, FFTPlan::Kind::Complex);
+
+    const size_t blocks = (channels + LANES - 1) / LANES;
+    size_t threads = 1;
+    if (channels * n >= MIN_PARALLEL_SAMPLES) {
+        threads = std::min<size_t>(m_maxThreads, blocks);
+    }
+
+    if (threads <= 1) {
+        transformBlocks(plan, data, channels, 0, blocks, m_scratch[0]);
+        return;
+    }
+
+    if (m_workers.empty()) {
+        startWorkers();
+    }
+
+    // Contiguous block ranges per thread; the calling thread takes the first range
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const size_t perThread = blocks / threads;
+        const size_t remainder = blocks % threads;
+        size_t begin = 0;
+        for (size_t t = 0; t < m_ranges.size(); ++t) {
+            size_t end = t < threads ? begin + perThread + (t < remainder ? 1 : 0) : begin;
+            m_ranges[t].begin = begin;
+            m_ranges[t].end = end;
+            begin = end;
+        }
+        m_plan = &plan;
+        m_data = data;
+        m_channels = channels;
+        m_pending = threads - 1;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    transformBlocks(plan, data, channels, m_ranges[0].begin, m_ranges[0].end, m_scratch[0]);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]() { return m_pending == 0; });
+}
+
+void BatchFFT::transformBlocks(const FFTPlan& plan, std::complex<float>* data, size_t channels,
+                               size_t firstBlock, size_t lastBlock, std::vector<float>& scratch)
+{
+    // Lane-interleaved scratch, kept per thread across calls: re[n][LANES] then im[n][LANES]
+    scratch.resize(2 * LANES * plan.coreLength);
+    for (size_t b = firstBlock; b < lastBlock; ++b) {
+        const size_t first = b * LANES;
+        const size_t count = std::min(LANES, channels - first);
+        transformBlock(plan, data, first, count, scratch.data());
+    }
+}
+
+void BatchFFT::transformBlock(const FFTPlan& plan, std::complex<float>* data,
+                              size_t firstChannel, size_t count, float* scratch)
+{
+    const size_t n = plan.coreLength;
+    float* re = scratch;
+    float* im = scratch + LANES * n;
+
+    // Transpose into lanes, applying the bit-reversal permutation on the way in
+    for (size_t i = 0; i < n; ++i) {
+        const size_t src = plan.bitReverse[i];
+        for (size_t l = 0; l < LANES; ++l) {
+            if (l < count) {
+                const std::complex<float> v = data[(firstChannel + l) * n + src];
+                re[i * LANES + l] = v.real();
+                im[i * LANES + l] = v.imag();
+            } else {
+                re[i * LANES + l] = 0.0f;
+                im[i * LANES + l] = 0.0f;
+            }
+        }
+    }
+
+    // Butterflies: each step updates the same bin of all LANES channels
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        const size_t step = n / len;
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; ++j) {
+                const std::complex<float> w = plan.twiddles[j * step];
+                const size_t a = (i + j) * LANES;
+                const size_t b = (i + j + half) * LANES;
+#ifdef BATCHFFT_USE_SSE2
+                const __m128 wr = _mm_set1_ps(w.real());
+                const __m128 wi = _mm_set1_ps(w.imag());
+                const __m128 br = _mm_loadu_ps(re + b);
+                const __m128 bi = _mm_loadu_ps(im + b);
+                const __m128 vr = _mm_sub_ps(_mm_mul_ps(br, wr), _mm_mul_ps(bi, wi));
+                const __m128 vi = _mm_add_ps(_mm_mul_ps(br, wi), _mm_mul_ps(bi, wr));
+                const __m128 ur = _mm_loadu_ps(re + a);
+                const __m128 ui = _mm_loadu_ps(im + a);
+                _mm_storeu_ps(re + a, _mm_add_ps(ur, vr));
+                _mm_storeu_ps(im + a, _mm_add_ps(ui, vi));
+                _mm_storeu_ps(re + b, _mm_sub_ps(ur, vr));
+                _mm_storeu_ps(im + b, _mm_sub_ps(ui, vi));
+#else
+                for (size_t l = 0; l < LANES; ++l) {
+                    const float vr = re[b + l] * w.real() - im[b + l] * w.imag();
+                    const float vi = re[b + l] * w.imag() + im[b + l] * w.real();
+                    const float ur = re[a + l];
+                    const float ui = im[a + l];
+                    re[a + l] = ur + vr;
+                    im[a + l] = ui + vi;
+                    re[b + l] = ur - vr;
+                    im[b + l] = ui - vi;
+                }
+#endif
+            }
+        }
+    }
+
+    // Transpose back to each channel's own slot
+    for (size_t l = 0; l < count; ++l) {
+        std::complex<float>* out = data + (firstChannel + l) * n;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::complex<float>(re[i * LANES + l], im[i * LANES + l]);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef BATCHFFT_H
+#define BATCHFFT_H
+
+#include <complex>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "FFTEngine.h"
+
+// Batched forward FFT over many channels of the same length.
+//
+// Channels are processed in blocks of LANES. Each block is transposed into a
+// lane-interleaved scratch buffer (sample-major, channel-minor) so every
+// butterfly updates LANES channels with one SIMD operation, and the block
+// working set (LANES * N complex values, 32 KB at N = 1024) stays in cache
+// for all log2(N) stages. Blocks are split across worker threads in
+// contiguous ranges; each channel is written back to its own slot, so the
+// output layout does not depend on the thread count.
+//
+// The maxThreads - 1 workers are started on the first parallel call and
+// then wait on a condition variable between calls, so a frame costs one
+// wake-up per worker rather than a thread create/join.
+class BatchFFT
+{
+public:
+    static constexpr size_t LANES = 4;
+
+    // maxThreads = 0 uses std::thread::hardware_concurrency()
+    explicit BatchFFT(unsigned maxThreads = 0);
+    ~BatchFFT();
+
+    BatchFFT(const BatchFFT&) = delete;
+    BatchFFT& operator=(const BatchFFT&) = delete;
+
+    void setMaxThreads(unsigned maxThreads);
+    unsigned maxThreads() const { return m_maxThreads; }
+
+    // In-place transform of `channels` contiguous channels of length n
+    // (power of two). Channel c occupies data[c*n, c*n + n) before and after.
+    void forward(std::complex<float>* data, size_t channels, size_t n);
+
+    // Below this many complex samples per call, run on the calling thread
+    static constexpr size_t MIN_PARALLEL_SAMPLES = 16384;
+
+private:
+    struct BlockRange {
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    void startWorkers();
+    void stopWorkers();
+    void workerLoop(size_t index);
+
+    static void transformBlocks(const FFTPlan& plan, std::complex<float>* data, size_t channels,
+                                size_t firstBlock, size_t lastBlock, std::vector<float>& scratch);
+    static void transformBlock(const FFTPlan& plan, std::complex<float>* data,
+                               size_t firstChannel, size_t count, float* scratch);
+
+    FFTEngine m_engine;   // Plan cache (plans are read-only while workers run)
+    unsigned m_maxThreads;
+
+    // Worker pool; range and scratch index 0 belong to the calling thread
+    std::vector<std::thread> m_workers;
+    std::vector<std::vector<float>> m_scratch;
+    std::vector<BlockRange> m_ranges;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;     // New job or shutdown
+    std::condition_variable m_done;     // Last worker finished its range
+    uint64_t m_generation;              // Bumped once per posted job
+    size_t m_pending;                   // Workers still running the current job
+    bool m_stop;
+
+    // Current job, valid while m_pending > 0
+    const FFTPlan* m_plan;
+    std::complex<float>* m_data;
+    size_t m_channels;
+};
+
+#endif // BATCHFFT_H
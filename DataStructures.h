@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <vector>
+#include <complex>
+#include <algorithm>
 #include <math.h>
 #include <QtCore/QDateTime>
 
@@ -82,6 +84,7 @@ struct RawADCFrameTest {
     uint32_t num_samples_per_chirp;  // This should be number of complex samples (32)
     std::vector<ComplexSample> complex_data;  // Changed from sample_data
     std::vector<float> magnitude_data;        // Computed magnitudes
+    Rx_Data_Format_t data_format = Rx_Data_Format_t::COMPLEX_FLOAT;  // REAL_FLOAT frames carry Q = 0
 
     void computeMagnitudes() {
         magnitude_data.clear();
@@ -165,3 +168,41 @@ struct TargetDataPacket_t {
     float    elevation_speed;   // deg/s
 };
 
+// Optional trailer appended after TargetDataPacket_t. Senders that include it
+// let the client group target packets by frame instead of inferring frame
+// boundaries from num_targets.
+#pragma pack(push, 1)
+struct TargetFrameTrailer_t {
+    uint32_t frame_id;          // Incremented once per frame
+};
+#pragma pack(pop)
+
+// Range-FFT output for every chirp and RX antenna of one raw frame.
+// Layout is [chirp][rx][bin]; only the positive-range half of each spectrum is kept.
+struct RangeProfileCube {
+    uint32_t frame_number = 0;
+    uint32_t num_chirps = 0;
+    uint32_t num_rx_antennas = 0;
+    uint32_t num_bins = 0;            // Bins kept per channel (fft_size / 2)
+    uint32_t fft_size = 0;            // Zero-padded FFT length per chirp
+    uint32_t num_samples = 0;         // Valid (complex or real) samples per chirp
+    Rx_Data_Format_t data_format = Rx_Data_Format_t::COMPLEX_FLOAT;
+    qint64 timestamp = 0;             // Receive time (ms since epoch)
+    float bin_spacing = 0.0f;         // Range per bin (m), 0 if radar parameters are unknown
+    std::vector<std::complex<float>> bins;
+
+    bool empty() const { return bins.empty(); }
+    uint32_t numChannels() const { return num_chirps * num_rx_antennas; }
+
+    // Nearest range bin for a radius in metres, clamped to the kept bins
+    uint32_t rangeToBin(float range) const {
+        if (bin_spacing <= 0.0f || num_bins == 0) return 0;
+        float bin = std::round(range / bin_spacing);
+        bin = std::max(0.0f, std::min(bin, static_cast<float>(num_bins - 1)));
+        return static_cast<uint32_t>(bin);
+    }
+
+    const std::complex<float>* channel(uint32_t chirp, uint32_t rx) const {
+        return bins.data() + (static_cast<size_t>(chirp) * num_rx_antennas + rx) * num_bins;
+    }
+};
@@ -0,0 +1,162 @@
+#include "DetectionClusterer.h"
+#include <algorithm>
+
+namespace {
+constexpr int UNVISITED = -2;
+}
+
+DetectionData DetectionClusterer::Cluster::toDetection(uint32_t id) const
+{
+    DetectionData d;
+    d.target_id = id;
+    d.radius = range;
+    d.radial_speed = radialSpeed;
+    d.azimuth = azimuth;
+    d.amplitude = amplitude;
+    d.timestamp = timestamp;
+    return d;
+}
+
+DetectionClusterer::DetectionClusterer()
+    : m_grid(1.0f)
+{
+}
+
+void DetectionClusterer::process(const std::vector<DetectionData>& detections)
+{
+    const size_t n = detections.size();
+    m_clusters.clear();
+    m_labels.assign(n, UNVISITED);
+    if (n == 0) return;
+
+    const float invRange = 1.0f / std::max(1e-6f, m_config.rangeEps);
+    const float invAzimuth = 1.0f / std::max(1e-6f, m_config.azimuthEps);
+    const float invSpeed = 1.0f / std::max(1e-6f, m_config.speedEps);
+
+    m_u.resize(n);
+    m_v.resize(n);
+    m_w.resize(n);
+    m_grid.clear();
+    m_grid.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        m_u[i] = detections[i].radius * invRange;
+        m_v[i] = detections[i].azimuth * invAzimuth;
+        m_w[i] = detections[i].radial_speed * invSpeed;
+        m_grid.addPoint(m_u[i], m_v[i], static_cast<uint32_t>(i));
+    }
+    m_grid.build();
+
+    const size_t minPoints = std::max<uint32_t>(1, m_config.minPoints);
+    int nextCluster = 0;
+
+    for (uint32_t p = 0; p < n; ++p) {
+        if (m_labels[p] != UNVISITED) continue;
+
+        regionQuery(p, m_neighbours);
+        if (m_neighbours.size() < minPoints) {
+            m_labels[p] = NOISE;        // May still become a border point later
+            continue;
+        }
+
+        const int cluster = nextCluster++;
+        m_labels[p] = cluster;
+        m_seeds.assign(m_neighbours.begin(), m_neighbours.end());
+
+        // Expand through density-reachable points; only core points add seeds
+        for (size_t s = 0; s < m_seeds.size(); ++s) {
+            const uint32_t q = m_seeds[s];
+            if (m_labels[q] == NOISE) {
+                m_labels[q] = cluster;
+                continue;
+            }
+            if (m_labels[q] != UNVISITED) continue;
+
+            m_labels[q] = cluster;
+            regionQuery(q, m_neighbours);
+            if (m_neighbours.size() >= minPoints) {
+                for (uint32_t r : m_neighbours) {
+                    if (m_labels[r] == UNVISITED || m_labels[r] == NOISE) {
+                        m_seeds.push_back(r);
+                    }
+                }
+            }
+        }
+    }
+
+    if (m_config.keepNoise) {
+        for (size_t i = 0; i < n; ++i) {
+            if (m_labels[i] == NOISE) {
+                m_labels[i] = nextCluster++;
+            }
+        }
+    }
+
+    m_clusters.resize(static_cast<size_t>(nextCluster));
+    summarise(detections);
+}
+
+void DetectionClusterer::regionQuery(uint32_t point, std::vector<uint32_t>& neighbours) const
+{
+    // Grid gives the unit disk in (range, azimuth); keep those inside the unit ball
+    m_grid.withinRadius(m_u[point], m_v[point], 1.0f, neighbours);
+
+    const float u = m_u[point], v = m_v[point], w = m_w[point];
+    size_t kept = 0;
+    for (uint32_t j : neighbours) {
+        const float du = m_u[j] - u;
+        const float dv = m_v[j] - v;
+        const float dw = m_w[j] - w;
+        neighbours[kept] = j;
+        kept += (du * du + dv * dv + dw * dw <= 1.0f) ? 1 : 0;
+    }
+    neighbours.resize(kept);
+}
+
+void DetectionClusterer::summarise(const std::vector<DetectionData>& detections)
+{
+    for (size_t i = 0; i < detections.size(); ++i) {
+        if (m_labels[i] < 0) continue;
+
+        const DetectionData& d = detections[i];
+        Cluster& c = m_clusters[static_cast<size_t>(m_labels[i])];
+        if (c.numPoints == 0) {
+            c.minRange = c.maxRange = d.radius;
+            c.minAzimuth = c.maxAzimuth = d.azimuth;
+            c.minSpeed = c.maxSpeed = d.radial_speed;
+            c.amplitude = d.amplitude;
+            c.timestamp = d.timestamp;
+        } else {
+            c.minRange = std::min(c.minRange, d.radius);
+            c.maxRange = std::max(c.maxRange, d.radius);
+            c.minAzimuth = std::min(c.minAzimuth, d.azimuth);
+            c.maxAzimuth = std::max(c.maxAzimuth, d.azimuth);
+            c.minSpeed = std::min(c.minSpeed, d.radial_speed);
+            c.maxSpeed = std::max(c.maxSpeed, d.radial_speed);
+            c.amplitude = std::max(c.amplitude, d.amplitude);
+            c.timestamp = std::max(c.timestamp, d.timestamp);
+        }
+        // Running sums, divided below
+        c.range += d.radius;
+        c.azimuth += d.azimuth;
+        c.radialSpeed += d.radial_speed;
+        ++c.numPoints;
+    }
+
+    for (Cluster& c : m_clusters) {
+        if (c.numPoints > 0) {
+            const float inv = 1.0f / static_cast<float>(c.numPoints);
+            c.range *= inv;
+            c.azimuth *= inv;
+            c.radialSpeed *= inv;
+        }
+    }
+}
+
+void DetectionClusterer::centroids(std::vector<DetectionData>& out) const
+{
+    out.clear();
+    out.reserve(m_clusters.size());
+    for (size_t i = 0; i < m_clusters.size(); ++i) {
+        out.push_back(m_clusters[i].toDetection(static_cast<uint32_t>(i)));
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef DETECTIONCLUSTERER_H
+#define DETECTIONCLUSTERER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "structures.h"
+#include "SpatialGrid.h"
+
+// DBSCAN clustering of one frame's point detections into objects.
+//
+// Detections are compared in (range, azimuth, radial speed), each axis
+// scaled by its neighbourhood radius so the neighbourhood is the unit
+// ellipsoid. Range/azimuth go into a uniform grid with unit cells; a region
+// query visits the 3x3 cells around the point and checks the speed axis on
+// the candidates, so clustering costs roughly O(N) for a typical scene.
+// Each cluster is reported as its centroid plus per-axis extents.
+class DetectionClusterer
+{
+public:
+    static constexpr int NOISE = -1;
+
+    struct Config {
+        float rangeEps = 1.5f;          // m
+        float azimuthEps = 4.0f;        // deg
+        float speedEps = 1.0f;          // m/s
+        uint32_t minPoints = 2;         // Neighbours (including the point itself) of a core point
+        bool keepNoise = true;          // Report isolated detections as single-point clusters
+    };
+
+    struct Cluster {
+        float range = 0.0f;             // Centroid (mean of members)
+        float azimuth = 0.0f;
+        float radialSpeed = 0.0f;
+        float amplitude = 0.0f;         // Strongest member
+        float minRange = 0.0f, maxRange = 0.0f;
+        float minAzimuth = 0.0f, maxAzimuth = 0.0f;
+        float minSpeed = 0.0f, maxSpeed = 0.0f;
+        uint32_t numPoints = 0;
+        qint64 timestamp = 0;           // Latest member timestamp
+
+        DetectionData toDetection(uint32_t id) const;
+    };
+
+    DetectionClusterer();
+
+    void setConfig(const Config& config) { m_config = config; }
+    const Config& config() const { return m_config; }
+
+    // Cluster one frame; results stay valid until the next call
+    void process(const std::vector<DetectionData>& detections);
+
+    const std::vector<Cluster>& clusters() const { return m_clusters; }
+    // Cluster index of each input detection, or NOISE if it was dropped
+    const std::vector<int>& labels() const { return m_labels; }
+    // Cluster centroids as detections (target_id = cluster index)
+    void centroids(std::vector<DetectionData>& out) const;
+
+private:
+    void regionQuery(uint32_t point, std::vector<uint32_t>& neighbours) const;
+    void summarise(const std::vector<DetectionData>& detections);
+
+    Config m_config;
+    std::vector<Cluster> m_clusters;
+    std::vector<int> m_labels;
+
+    // Per-frame scratch: coordinates scaled by the eps of each axis
+    std::vector<float> m_u, m_v, m_w;
+    SpatialGrid m_grid;
+    std::vector<uint32_t> m_neighbours;
+    std::vector<uint32_t> m_seeds;
+};
+
+#endif // DETECTIONCLUSTERER_H
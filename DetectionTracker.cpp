@@ -0,0 +1,457 @@
+#include "DetectionTracker.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace {
+constexpr float DEG_TO_RAD = 3.14159265358979f / 180.0f;
+constexpr float INITIAL_VELOCITY_VAR = 100.0f;   // (10 m/s)^2
+constexpr float MAX_DT = 2.0f;                   // s
+constexpr int MAX_GRID_CELLS = 16384;
+constexpr double NOT_GATED = 1e9;
+
+uint32_t countBits(uint32_t v)
+{
+    uint32_t c = 0;
+    for (; v; v &= v - 1) {
+        ++c;
+    }
+    return c;
+}
+}
+
+float DetectionTracker::Track::range() const
+{
+    return std::sqrt(x * x + y * y);
+}
+
+float DetectionTracker::Track::azimuth() const
+{
+    return std::atan2(x, y) / DEG_TO_RAD;
+}
+
+DetectionTracker::DetectionTracker()
+    : m_nextTrackId(1)
+    , m_lastFrameTime(0)
+    , m_gridMinX(0.0f)
+    , m_gridMinY(0.0f)
+    , m_gridCell(1.0f)
+    , m_gridCols(0)
+    , m_gridRows(0)
+{
+}
+
+void DetectionTracker::clear()
+{
+    m_tracks.clear();
+    m_nextTrackId = 1;
+    m_lastFrameTime = 0;
+}
+
+void DetectionTracker::processFrame(const std::vector<DetectionData>& detections, qint64 timestampMs)
+{
+    float dt = 0.0f;
+    if (m_lastFrameTime > 0 && timestampMs > m_lastFrameTime) {
+        dt = std::min(MAX_DT, static_cast<float>(timestampMs - m_lastFrameTime) / 1000.0f);
+    }
+    m_lastFrameTime = timestampMs;
+
+    // Polar -> Cartesian once per detection; non-finite positions are dropped
+    // here so they can neither start tracks nor stretch the gating grid
+    m_measurements.clear();
+    m_measurements.reserve(detections.size());
+    for (const auto& det : detections) {
+        const float az = det.azimuth * DEG_TO_RAD;
+        const float x = det.radius * std::sin(az);
+        const float y = det.radius * std::cos(az);
+        if (!std::isfinite(x) || !std::isfinite(y)) continue;
+        m_measurements.push_back({ x, y, &det });
+    }
+
+    predict(dt);
+    buildGrid();
+    gate();
+    assign();
+
+    for (size_t t = 0; t < m_tracks.size(); ++t) {
+        if (m_trackAssignment[t] >= 0) {
+            updateTrack(m_tracks[t], m_measurements[m_trackAssignment[t]], timestampMs);
+        }
+    }
+    manageTracks(timestampMs);
+}
+
+void DetectionTracker::predict(float dt)
+{
+    if (dt <= 0.0f) return;
+
+    const float q = m_config.processNoise;
+    const float q3 = q * dt * dt * dt / 3.0f;
+    const float q2 = q * dt * dt / 2.0f;
+    const float q1 = q * dt;
+
+    for (auto& t : m_tracks) {
+        t.x += t.vx * dt;
+        t.y += t.vy * dt;
+
+        t.pxx += 2.0f * dt * t.pxv + dt * dt * t.pvv + q3;
+        t.pxv += dt * t.pvv + q2;
+        t.pvv += q1;
+
+        t.pyy += 2.0f * dt * t.pyv + dt * dt * t.pww + q3;
+        t.pyv += dt * t.pww + q2;
+        t.pww += q1;
+    }
+}
+
+void DetectionTracker::buildGrid()
+{
+    m_gridCols = m_gridRows = 0;
+    m_cellStart.clear();
+    m_cellItems.clear();
+    if (m_measurements.empty()) return;
+
+    float minX = m_measurements[0].x, maxX = minX;
+    float minY = m_measurements[0].y, maxY = minY;
+    for (const auto& m : m_measurements) {
+        minX = std::min(minX, m.x); maxX = std::max(maxX, m.x);
+        minY = std::min(minY, m.y); maxY = std::max(maxY, m.y);
+    }
+
+    // Cell size is the maximum gate distance, grown if the scene is very sparse and wide
+    float cell = std::max(0.1f, m_config.maxGateDistance);
+    while ((static_cast<double>((maxX - minX) / cell) + 1.0) *
+           (static_cast<double>((maxY - minY) / cell) + 1.0) > MAX_GRID_CELLS) {
+        cell *= 2.0f;
+    }
+    m_gridCell = cell;
+    m_gridMinX = minX;
+    m_gridMinY = minY;
+    m_gridCols = static_cast<int>((maxX - minX) / cell) + 1;
+    m_gridRows = static_cast<int>((maxY - minY) / cell) + 1;
+
+    // Counting sort of detections into cells (CSR)
+    const size_t cells = static_cast<size_t>(m_gridCols) * m_gridRows;
+    m_cellStart.assign(cells + 1, 0);
+    m_cellOf.resize(m_measurements.size());
+    for (size_t i = 0; i < m_measurements.size(); ++i) {
+        const int cx = std::min(m_gridCols - 1, static_cast<int>((m_measurements[i].x - minX) / cell));
+        const int cy = std::min(m_gridRows - 1, static_cast<int>((m_measurements[i].y - minY) / cell));
+        m_cellOf[i] = static_cast<uint32_t>(cy * m_gridCols + cx);
+        ++m_cellStart[m_cellOf[i] + 1];
+    }
+    for (size_t c = 0; c < cells; ++c) {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+    m_cellItems.resize(m_measurements.size());
+    std::vector<uint32_t>& fill = m_cellFill;
+    fill.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < m_measurements.size(); ++i) {
+        m_cellItems[fill[m_cellOf[i]]++] = static_cast<uint32_t>(i);
+    }
+}
+
+void DetectionTracker::gate()
+{
+    m_edges.clear();
+    if (m_gridCols == 0) return;
+
+    const float r = m_config.measurementStd * m_config.measurementStd;
+    const float maxDist2 = m_config.maxGateDistance * m_config.maxGateDistance;
+
+    for (size_t t = 0; t < m_tracks.size(); ++t) {
+        const Track& track = m_tracks[t];
+        const float sx = track.pxx + r;
+        const float sy = track.pyy + r;
+
+        // Euclidean reach of the gate, bounded by the maximum gate distance
+        const float reach = std::min(m_config.maxGateDistance,
+                                     std::sqrt(m_config.gateThreshold * std::max(sx, sy)));
+        const int cx0 = std::max(0, static_cast<int>(std::floor((track.x - reach - m_gridMinX) / m_gridCell)));
+        const int cx1 = std::min(m_gridCols - 1, static_cast<int>(std::floor((track.x + reach - m_gridMinX) / m_gridCell)));
+        const int cy0 = std::max(0, static_cast<int>(std::floor((track.y - reach - m_gridMinY) / m_gridCell)));
+        const int cy1 = std::min(m_gridRows - 1, static_cast<int>(std::floor((track.y + reach - m_gridMinY) / m_gridCell)));
+
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                const uint32_t cell = static_cast<uint32_t>(cy * m_gridCols + cx);
+                for (uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+                    const uint32_t d = m_cellItems[k];
+                    const float dx = m_measurements[d].x - track.x;
+                    const float dy = m_measurements[d].y - track.y;
+                    if (dx * dx + dy * dy > maxDist2) continue;
+                    const float d2 = dx * dx / sx + dy * dy / sy;
+                    if (d2 < m_config.gateThreshold) {
+                        m_edges.push_back({ static_cast<uint32_t>(t), d, d2 });
+                    }
+                }
+            }
+        }
+    }
+}
+
+uint32_t DetectionTracker::findRoot(uint32_t node)
+{
+    while (m_parent[node] != node) {
+        m_parent[node] = m_parent[m_parent[node]];
+        node = m_parent[node];
+    }
+    return node;
+}
+
+void DetectionTracker::assign()
+{
+    const uint32_t numTracks = static_cast<uint32_t>(m_tracks.size());
+    const uint32_t numDetections = static_cast<uint32_t>(m_measurements.size());
+    m_trackAssignment.assign(numTracks, -1);
+    m_detectionUsed.assign(numDetections, 0);
+    if (m_edges.empty()) return;
+
+    // Connected components of the gating graph
+    m_parent.resize(numTracks + numDetections);
+    for (uint32_t i = 0; i < m_parent.size(); ++i) {
+        m_parent[i] = i;
+    }
+    for (const auto& e : m_edges) {
+        const uint32_t a = findRoot(e.track);
+        const uint32_t b = findRoot(numTracks + e.detection);
+        if (a != b) m_parent[a] = b;
+    }
+
+    // Group edges by component root
+    m_clusterOf.assign(numTracks + numDetections, -1);
+    m_clusterTracks.clear();
+    m_clusterDetections.clear();
+    int clusterCount = 0;
+    for (const auto& e : m_edges) {
+        const uint32_t root = findRoot(e.track);
+        if (m_clusterOf[root] < 0) {
+            m_clusterOf[root] = clusterCount++;
+        }
+    }
+    m_clusterTracks.resize(clusterCount);
+    m_clusterDetections.resize(clusterCount);
+    for (auto& v : m_clusterTracks) v.clear();
+    for (auto& v : m_clusterDetections) v.clear();
+    for (uint32_t n = 0; n < numTracks + numDetections; ++n) {
+        const int c = m_clusterOf[findRoot(n)];
+        if (c < 0) continue;
+        if (n < numTracks) {
+            m_clusterTracks[c].push_back(n);
+        } else {
+            m_clusterDetections[c].push_back(n - numTracks);
+        }
+    }
+
+    // Local index of each node inside its cluster, for building dense cost matrices
+    m_localIndex.resize(numTracks + numDetections);
+    for (int c = 0; c < clusterCount; ++c) {
+        for (size_t i = 0; i < m_clusterTracks[c].size(); ++i) m_localIndex[m_clusterTracks[c][i]] = static_cast<uint32_t>(i);
+        for (size_t j = 0; j < m_clusterDetections[c].size(); ++j) m_localIndex[numTracks + m_clusterDetections[c][j]] = static_cast<uint32_t>(j);
+    }
+
+    // Bucket edges per cluster (CSR)
+    m_clusterEdgeStart.assign(clusterCount + 1, 0);
+    for (const auto& e : m_edges) {
+        ++m_clusterEdgeStart[m_clusterOf[findRoot(e.track)] + 1];
+    }
+    for (int c = 0; c < clusterCount; ++c) {
+        m_clusterEdgeStart[c + 1] += m_clusterEdgeStart[c];
+    }
+    m_clusterEdges.resize(m_edges.size());
+    m_cellFill.assign(m_clusterEdgeStart.begin(), m_clusterEdgeStart.end() - 1);
+    for (uint32_t i = 0; i < m_edges.size(); ++i) {
+        const int c = m_clusterOf[findRoot(m_edges[i].track)];
+        m_clusterEdges[m_cellFill[c]++] = i;
+    }
+
+    for (int c = 0; c < clusterCount; ++c) {
+        solveCluster(c);
+    }
+}
+
+void DetectionTracker::solveCluster(int cluster)
+{
+    const std::vector<uint32_t>& tracks = m_clusterTracks[cluster];
+    const std::vector<uint32_t>& dets = m_clusterDetections[cluster];
+    const uint32_t firstEdge = m_clusterEdgeStart[cluster];
+    const uint32_t lastEdge = m_clusterEdgeStart[cluster + 1];
+
+    // Single gated pair: nothing to resolve
+    if (tracks.size() == 1 && dets.size() == 1) {
+        m_trackAssignment[tracks[0]] = static_cast<int>(dets[0]);
+        m_detectionUsed[dets[0]] = 1;
+        return;
+    }
+
+    // Rows: tracks. Columns: detections, then one "miss" column per track.
+    const int n = static_cast<int>(tracks.size());
+    const int nd = static_cast<int>(dets.size());
+    const int m = nd + n;
+    m_cost.assign(static_cast<size_t>(n) * m, NOT_GATED);
+    for (int i = 0; i < n; ++i) {
+        m_cost[static_cast<size_t>(i) * m + nd + i] = m_config.gateThreshold;
+    }
+    for (uint32_t k = firstEdge; k < lastEdge; ++k) {
+        const Edge& e = m_edges[m_clusterEdges[k]];
+        const uint32_t numTracks = static_cast<uint32_t>(m_tracks.size());
+        const uint32_t row = m_localIndex[e.track];
+        const uint32_t col = m_localIndex[numTracks + e.detection];
+        m_cost[static_cast<size_t>(row) * m + col] = e.cost;
+    }
+
+    // Hungarian algorithm with potentials (1-based, rows <= columns)
+    const double INF = std::numeric_limits<double>::max() / 4;
+    m_u.assign(n + 1, 0.0);
+    m_v.assign(m + 1, 0.0);
+    m_p.assign(m + 1, 0);
+    m_way.assign(m + 1, 0);
+    for (int i = 1; i <= n; ++i) {
+        m_p[0] = i;
+        int j0 = 0;
+        m_minv.assign(m + 1, INF);
+        m_usedCol.assign(m + 1, 0);
+        do {
+            m_usedCol[j0] = 1;
+            const int i0 = m_p[j0];
+            double delta = INF;
+            int j1 = 0;
+            for (int j = 1; j <= m; ++j) {
+                if (m_usedCol[j]) continue;
+                const double cur = m_cost[static_cast<size_t>(i0 - 1) * m + (j - 1)] - m_u[i0] - m_v[j];
+                if (cur < m_minv[j]) {
+                    m_minv[j] = cur;
+                    m_way[j] = j0;
+                }
+                if (m_minv[j] < delta) {
+                    delta = m_minv[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= m; ++j) {
+                if (m_usedCol[j]) {
+                    m_u[m_p[j]] += delta;
+                    m_v[j] -= delta;
+                } else {
+                    m_minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (m_p[j0] != 0);
+        do {
+            const int j1 = m_way[j0];
+            m_p[j0] = m_p[j1];
+            j0 = j1;
+        } while (j0);
+    }
+
+    for (int j = 1; j <= nd; ++j) {
+        const int row = m_p[j];
+        if (row == 0) continue;
+        if (m_cost[static_cast<size_t>(row - 1) * m + (j - 1)] >= NOT_GATED) continue;
+        m_trackAssignment[tracks[row - 1]] = static_cast<int>(dets[j - 1]);
+        m_detectionUsed[dets[j - 1]] = 1;
+    }
+}
+
+void DetectionTracker::updateTrack(Track& track, const Measurement& z, qint64 timestampMs)
+{
+    const float r = m_config.measurementStd * m_config.measurementStd;
+
+    // x axis
+    {
+        const float s = track.pxx + r;
+        const float k0 = track.pxx / s;
+        const float k1 = track.pxv / s;
+        const float y = z.x - track.x;
+        track.x += k0 * y;
+        track.vx += k1 * y;
+        track.pvv -= k1 * track.pxv;
+        track.pxv -= k0 * track.pxv;
+        track.pxx -= k0 * track.pxx;
+    }
+    // y axis
+    {
+        const float s = track.pyy + r;
+        const float k0 = track.pyy / s;
+        const float k1 = track.pyv / s;
+        const float y = z.y - track.y;
+        track.y += k0 * y;
+        track.vy += k1 * y;
+        track.pww -= k1 * track.pyv;
+        track.pyv -= k0 * track.pyv;
+        track.pyy -= k0 * track.pyy;
+    }
+
+    track.radialSpeed = z.source->radial_speed;
+    track.amplitude = z.source->amplitude;
+    track.lastUpdateTime = timestampMs;
+}
+
+void DetectionTracker::manageTracks(qint64 timestampMs)
+{
+    const uint32_t windowMask = (m_config.confirmWindow >= 32) ? 0xFFFFFFFFu : ((1u << m_config.confirmWindow) - 1u);
+
+    // Hit/miss bookkeeping, confirmation and deletion (compacting in place)
+    size_t keep = 0;
+    for (size_t t = 0; t < m_tracks.size(); ++t) {
+        Track& track = m_tracks[t];
+        const bool hit = m_trackAssignment[t] >= 0;
+        ++track.age;
+        track.recentHits = ((track.recentHits << 1) | (hit ? 1u : 0u)) & windowMask;
+        if (hit) {
+            ++track.hits;
+            track.consecutiveMisses = 0;
+        } else {
+            ++track.consecutiveMisses;
+        }
+
+        if (track.status == TrackStatus::Tentative && countBits(track.recentHits) >= m_config.confirmHits) {
+            track.status = TrackStatus::Confirmed;
+        }
+
+        const uint32_t maxMisses = (track.status == TrackStatus::Confirmed)
+            ? m_config.maxMissesConfirmed : m_config.maxMissesTentative;
+        if (track.consecutiveMisses <= maxMisses) {
+            if (keep != t) m_tracks[keep] = track;
+            ++keep;
+        }
+    }
+    m_tracks.resize(keep);
+
+    // Unassigned detections start tentative tracks
+    const float r = m_config.measurementStd * m_config.measurementStd;
+    for (size_t d = 0; d < m_measurements.size(); ++d) {
+        if (m_detectionUsed[d]) continue;
+        Track track;
+        track.id = m_nextTrackId++;
+        track.x = m_measurements[d].x;
+        track.y = m_measurements[d].y;
+        track.pxx = track.pyy = r;
+        track.pvv = track.pww = INITIAL_VELOCITY_VAR;
+        track.radialSpeed = m_measurements[d].source->radial_speed;
+        track.amplitude = m_measurements[d].source->amplitude;
+        track.hits = 1;
+        track.recentHits = 1;
+        track.lastUpdateTime = timestampMs;
+        m_tracks.push_back(track);
+    }
+}
+
+TargetTrackData DetectionTracker::confirmedTracks() const
+{
+    TargetTrackData out;
+    for (const auto& t : m_tracks) {
+        if (t.status != TrackStatus::Confirmed) continue;
+        TargetTrack target;
+        target.target_id = t.id;
+        target.level = t.amplitude;
+        target.radius = t.range();
+        target.azimuth = t.azimuth();
+        target.radial_speed = t.radialSpeed;
+        target.lastUpdateTime = t.lastUpdateTime;
+        out.targets.push_back(target);
+    }
+    out.numTracks = static_cast<uint32_t>(out.targets.size());
+    return out;
+}
@@ -0,0 +1,132 @@
+#ifndef DETECTIONTRACKER_H
+#define DETECTIONTRACKER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "structures.h"
+
+// Client-side multi-target tracker for raw point detections.
+//
+// Each frame: predict all tracks, gate detections against them, solve a
+// global-nearest-neighbour assignment, update/confirm/delete tracks and
+// start tentative tracks from unassigned detections.
+//
+// - Tracks are constant-velocity filters in Cartesian x/y (independent axes,
+//   isotropic position noise), so the innovation covariance is diagonal and
+//   the gate is a cheap Mahalanobis test.
+// - Detections are bucketed into a uniform grid; each track only tests the
+//   cells its gate can reach.
+// - Gated pairs are split into independent clusters (union-find); the
+//   Hungarian algorithm runs per cluster, with one "miss" column per track
+//   costing the gate threshold, so cost stays near-linear for sparse scenes.
+// - M-of-N confirmation and miss-count deletion manage track lifetime.
+class DetectionTracker
+{
+public:
+    enum class TrackStatus : uint8_t {
+        Tentative,
+        Confirmed
+    };
+
+    struct Track {
+        uint32_t id = 0;
+        TrackStatus status = TrackStatus::Tentative;
+        float x = 0.0f, y = 0.0f;           // m (y along boresight)
+        float vx = 0.0f, vy = 0.0f;         // m/s
+        float pxx = 0.0f, pxv = 0.0f, pvv = 0.0f;   // x-axis covariance
+        float pyy = 0.0f, pyv = 0.0f, pww = 0.0f;   // y-axis covariance (pww = var(vy))
+        float radialSpeed = 0.0f;           // Last associated detection (m/s)
+        float amplitude = 0.0f;
+        uint32_t hits = 0;                  // Total associated detections
+        uint32_t age = 0;                   // Frames since creation
+        uint32_t consecutiveMisses = 0;
+        uint32_t recentHits = 0;            // Bitmask of the last CONFIRM_WINDOW frames
+        qint64 lastUpdateTime = 0;
+
+        float range() const;
+        float azimuth() const;              // deg, 0 = boresight
+    };
+
+    struct Config {
+        float measurementStd = 0.5f;        // m
+        float processNoise = 4.0f;          // (m/s^2)^2/Hz
+        float gateThreshold = 9.21f;        // Chi-square, 2 dof, 99%
+        float maxGateDistance = 5.0f;       // m, also the grid cell size
+        uint32_t confirmHits = 3;           // M of the last
+        uint32_t confirmWindow = 5;         //   N frames
+        uint32_t maxMissesTentative = 2;
+        uint32_t maxMissesConfirmed = 5;
+    };
+
+    DetectionTracker();
+
+    void setConfig(const Config& config) { m_config = config; }
+    const Config& config() const { return m_config; }
+
+    // Run one tracking cycle over the detections of a frame
+    void processFrame(const std::vector<DetectionData>& detections, qint64 timestampMs);
+
+    const std::vector<Track>& tracks() const { return m_tracks; }
+    TargetTrackData confirmedTracks() const;
+    void clear();
+
+private:
+    struct Measurement {
+        float x, y;
+        const DetectionData* source;
+    };
+
+    struct Edge {
+        uint32_t track;
+        uint32_t detection;
+        float cost;
+    };
+
+    void predict(float dt);
+    void buildGrid();
+    void gate();
+    void assign();
+    void solveCluster(int cluster);
+    void updateTrack(Track& track, const Measurement& z, qint64 timestampMs);
+    void manageTracks(qint64 timestampMs);
+
+    uint32_t findRoot(uint32_t node);
+
+    Config m_config;
+    std::vector<Track> m_tracks;
+    uint32_t m_nextTrackId;
+    qint64 m_lastFrameTime;
+
+    // Per-frame scratch (kept to avoid reallocation)
+    std::vector<Measurement> m_measurements;
+    std::vector<Edge> m_edges;
+    std::vector<int> m_trackAssignment;        // Detection index or -1
+    std::vector<uint8_t> m_detectionUsed;
+
+    // Uniform grid: cell -> detection indices (CSR layout)
+    float m_gridMinX, m_gridMinY;
+    float m_gridCell;
+    int m_gridCols, m_gridRows;
+    std::vector<uint32_t> m_cellStart;
+    std::vector<uint32_t> m_cellItems;
+    std::vector<uint32_t> m_cellOf;
+    std::vector<uint32_t> m_cellFill;          // Fill cursor for CSR construction
+
+    // Union-find over tracks [0, T) and detections [T, T + D), then clusters
+    std::vector<uint32_t> m_parent;
+    std::vector<int> m_clusterOf;               // Root -> cluster index
+    std::vector<std::vector<uint32_t>> m_clusterTracks;
+    std::vector<std::vector<uint32_t>> m_clusterDetections;
+    std::vector<uint32_t> m_localIndex;         // Node -> row/column within its cluster
+    std::vector<uint32_t> m_clusterEdgeStart;
+    std::vector<uint32_t> m_clusterEdges;       // Edge indices grouped by cluster
+
+    // Hungarian scratch
+    std::vector<double> m_cost;
+    std::vector<double> m_u, m_v, m_minv;
+    std::vector<int> m_p, m_way;
+    std::vector<uint8_t> m_usedCol;
+};
+
+#endif // DETECTIONTRACKER_H
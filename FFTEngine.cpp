@@ -0,0 +1,152 @@
+#include "FFTEngine.h"
+#include "FFTKernels.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+constexpr double FFT_PI = 3.14159265358979323846;
+
+uint64_t planKey(size_t n, FFTPlan::Kind kind)
+{
+    return (static_cast<uint64_t>(n) << 1) | static_cast<uint64_t>(kind == FFTPlan::Kind::RealInput);
+}
+}
+
+size_t FFTEngine::nextPowerOfTwo(size_t n)
+{
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+const FFTPlan& FFTEngine::plan(size_t n, FFTPlan::Kind kind)
+{
+    const uint64_t key = planKey(n, kind);
+    auto it = m_plans.find(key);
+    if (it != m_plans.end()) {
+        return it->second;
+    }
+
+    FFTPlan& p = m_plans[key];
+    p.kind = kind;
+    p.n = n;
+
+    if (kind == FFTPlan::Kind::RealInput) {
+        // N real samples are transformed as an N/2-point complex FFT
+        buildCorePlan(p, n / 2);
+        p.realTwiddles.resize(n / 2);
+        for (size_t k = 0; k < n / 2; ++k) {
+            double angle = -2.0 * FFT_PI * static_cast<double>(k) / static_cast<double>(n);
+            p.realTwiddles[k] = std::complex<float>(static_cast<float>(std::cos(angle)),
+                                                    static_cast<float>(std::sin(angle)));
+        }
+    } else {
+        buildCorePlan(p, n);
+    }
+    return p;
+}
+
+void FFTEngine::buildCorePlan(FFTPlan& plan, size_t coreLength)
+{
+    plan.coreLength = coreLength;
+
+    // Bit-reversal permutation
+    plan.bitReverse.resize(coreLength);
+    for (size_t i = 0, j = 0; i < coreLength; ++i) {
+        plan.bitReverse[i] = static_cast<uint32_t>(j);
+        size_t bit = coreLength >> 1;
+        for (; bit && (j & bit); bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+    }
+
+    // Twiddles computed in double precision once, instead of the
+    // accumulated w *= wlen recurrence on every frame
+    plan.twiddles.resize(coreLength / 2);
+    for (size_t k = 0; k < coreLength / 2; ++k) {
+        double angle = -2.0 * FFT_PI * static_cast<double>(k) / static_cast<double>(coreLength);
+        plan.twiddles[k] = std::complex<float>(static_cast<float>(std::cos(angle)),
+                                               static_cast<float>(std::sin(angle)));
+    }
+}
+
+void FFTEngine::transformCore(const FFTPlan& plan, std::complex<float>* data) const
+{
+    if (m_useKernels && FFTKernels::dispatch(plan.coreLength, data)) {
+        return;
+    }
+    transformGeneric(plan, data);
+}
+
+void FFTEngine::transformGeneric(const FFTPlan& plan, std::complex<float>* data)
+{
+    const size_t n = plan.coreLength;
+    if (n <= 1) return;
+
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = plan.bitReverse[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        const size_t step = n / len;
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; ++j) {
+                std::complex<float> u = data[i + j];
+                std::complex<float> v = data[i + j + half] * plan.twiddles[j * step];
+                data[i + j] = u + v;
+                data[i + j + half] = u - v;
+            }
+        }
+    }
+}
+
+void FFTEngine::forward(std::vector<std::complex<float>>& data)
+{
+    if (data.size() <= 1) return;
+    const FFTPlan& p = plan(data.size(), FFTPlan::Kind::Complex);
+    transformCore(p, data.data());
+}
+
+void FFTEngine::forwardReal(const float* input, size_t n, std::vector<std::complex<float>>& spectrum)
+{
+    spectrum.resize(n / 2 + 1);
+    if (n < 2) {
+        spectrum[0] = std::complex<float>(n ? input[0] : 0.0f, 0.0f);
+        return;
+    }
+
+    const FFTPlan& p = plan(n, FFTPlan::Kind::RealInput);
+    const size_t m = n / 2;
+
+    // Pack even samples into the real part and odd samples into the imaginary part
+    m_packed.resize(m);
+    for (size_t k = 0; k < m; ++k) {
+        m_packed[k] = std::complex<float>(input[2 * k], input[2 * k + 1]);
+    }
+
+    transformCore(p, m_packed.data());
+
+    // Split step: separate the even/odd sub-spectra and combine with W_n^k
+    //   E[k] = (Z[k] + conj(Z[m-k])) / 2
+    //   O[k] = (Z[k] - conj(Z[m-k])) / 2i
+    //   X[k] = E[k] + W_n^k * O[k]
+    const std::complex<float> z0 = m_packed[0];
+    spectrum[0] = std::complex<float>(z0.real() + z0.imag(), 0.0f);
+    spectrum[m] = std::complex<float>(z0.real() - z0.imag(), 0.0f);
+
+    for (size_t k = 1; k < m; ++k) {
+        const std::complex<float> zk = m_packed[k];
+        const std::complex<float> zc = std::conj(m_packed[m - k]);
+        const std::complex<float> even = 0.5f * (zk + zc);
+        const std::complex<float> diff = 0.5f * (zk - zc);
+        const std::complex<float> odd(diff.imag(), -diff.real());  // diff / i
+        spectrum[k] = even + p.realTwiddles[k] * odd;
+    }
+}
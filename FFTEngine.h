@@ -0,0 +1,68 @@
+#ifndef FFTENGINE_H
+#define FFTENGINE_H
+
+#include <complex>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+
+// Precomputed tables for one transform length and input kind.
+// Plans are built on first use and reused for every frame of the same size.
+struct FFTPlan {
+    enum class Kind : uint8_t {
+        Complex,    // N-point complex-to-complex transform
+        RealInput   // N real samples packed as N/2 complex + split post-processing
+    };
+
+    Kind kind = Kind::Complex;
+    size_t n = 0;                                   // Transform length in input samples
+    size_t coreLength = 0;                          // Length of the complex core FFT (n or n/2)
+    std::vector<uint32_t> bitReverse;               // Bit-reversal permutation for the core FFT
+    std::vector<std::complex<float>> twiddles;      // W_core^k, k < coreLength/2
+    std::vector<std::complex<float>> realTwiddles;  // W_n^k, k < n/2 (RealInput only)
+};
+
+// Radix-2 FFT with a plan cache keyed by (length, kind).
+// All lengths must be powers of two; callers zero-pad as needed.
+// Core lengths with a compile-time kernel (see FFTKernels.h) are dispatched
+// to it; other lengths use the generic table-driven loop.
+class FFTEngine
+{
+public:
+    FFTEngine() = default;
+
+    // Return the cached plan for this length/kind, building it on first use
+    const FFTPlan& plan(size_t n, FFTPlan::Kind kind);
+
+    // In-place complex forward transform (data.size() must be a power of two)
+    void forward(std::vector<std::complex<float>>& data);
+
+    // Real-input forward transform of n samples (n power of two, n >= 2).
+    // Writes the n/2 + 1 non-redundant bins (DC .. Nyquist) to spectrum.
+    void forwardReal(const float* input, size_t n, std::vector<std::complex<float>>& spectrum);
+
+    // Specialised kernels are on by default; disabling them forces the generic path
+    void setUseSpecialisedKernels(bool enabled) { m_useKernels = enabled; }
+    bool useSpecialisedKernels() const { return m_useKernels; }
+
+    size_t cachedPlanCount() const { return m_plans.size(); }
+    void clearPlans() { m_plans.clear(); }
+
+    static bool isPowerOfTwo(size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+    static size_t nextPowerOfTwo(size_t n);
+
+private:
+    static void buildCorePlan(FFTPlan& plan, size_t coreLength);
+    void transformCore(const FFTPlan& plan, std::complex<float>* data) const;
+    static void transformGeneric(const FFTPlan& plan, std::complex<float>* data);
+
+    // std::map keeps plan references stable while new sizes are added
+    std::map<uint64_t, FFTPlan> m_plans;
+    bool m_useKernels = true;
+
+    // Scratch buffer for the packed real-input path (avoids per-frame allocation)
+    std::vector<std::complex<float>> m_packed;
+};
+
+#endif // FFTENGINE_H
@@ -0,0 +1,210 @@
+#ifndef FFTKERNELS_H
+#define FFTKERNELS_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+// Compile-time specialised radix-2 FFT kernels.
+//
+// One kernel is instantiated per supported length. Bit-reversal and twiddle
+// tables are generated by constexpr functions, every loop bound is a
+// template constant, and the first two stages (twiddles 1 and -i) are fused
+// into a single multiplication-free radix-4 pass. Arithmetic is done on the
+// raw float pairs so no complex-multiply library calls are emitted.
+//
+// Supported lengths cover the DSP fft_size options (64..1024) and the N/2
+// cores the real-input path uses for them (32..512).
+namespace FFTKernels {
+
+namespace detail {
+
+constexpr double PI = 3.14159265358979323846;
+
+// constexpr sine/cosine (Taylor series after reduction to [-pi/4, pi/4])
+constexpr double taylorSin(double x)
+{
+    double term = x;
+    double sum = x;
+    for (int k = 1; k < 12; ++k) {
+        term *= -x * x / ((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double taylorCos(double x)
+{
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 12; ++k) {
+        term *= -x * x / ((2 * k - 1) * (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// cos/sin of -2*pi*k/n using octant symmetry for full double accuracy
+constexpr void unitRoot(size_t k, size_t n, double& c, double& s)
+{
+    // Angle in units of pi/4: a = 8k/n, split into octant and remainder
+    const size_t num = 8 * k;
+    const size_t octant = num / n;
+    const double frac = static_cast<double>(num % n) / static_cast<double>(n);
+    double x = frac * (PI / 4.0);
+    if (octant & 1) {
+        x -= PI / 4.0;
+    }
+    const double sx = taylorSin(x);
+    const double cx = taylorCos(x);
+
+    // Rotate (cx, sx) by the base angle, always a multiple of pi/2
+    const size_t baseOctant = (octant + (octant & 1)) % 8;
+    double bc = 1.0, bs = 0.0;
+    switch (baseOctant) {
+    case 2: bc = 0.0; bs = 1.0; break;
+    case 4: bc = -1.0; bs = 0.0; break;
+    case 6: bc = 0.0; bs = -1.0; break;
+    default: break;
+    }
+    const double cosA = bc * cx - bs * sx;
+    const double sinA = bs * cx + bc * sx;
+
+    // Forward transform uses the negative angle
+    c = cosA;
+    s = -sinA;
+}
+
+template<size_t N>
+struct TwiddleTable {
+    float re[N / 2];
+    float im[N / 2];
+
+    constexpr TwiddleTable() : re(), im()
+    {
+        for (size_t k = 0; k < N / 2; ++k) {
+            double c = 0.0, s = 0.0;
+            unitRoot(k, N, c, s);
+            re[k] = static_cast<float>(c);
+            im[k] = static_cast<float>(s);
+        }
+    }
+};
+
+template<size_t N>
+struct BitReverseTable {
+    uint16_t index[N];
+
+    constexpr BitReverseTable() : index()
+    {
+        size_t bits = 0;
+        while ((size_t(1) << bits) < N) {
+            ++bits;
+        }
+        for (size_t i = 0; i < N; ++i) {
+            size_t r = 0;
+            for (size_t b = 0; b < bits; ++b) {
+                r |= ((i >> b) & 1u) << (bits - 1 - b);
+            }
+            index[i] = static_cast<uint16_t>(r);
+        }
+    }
+};
+
+template<size_t N>
+struct Tables {
+    static constexpr TwiddleTable<N> twiddles{};
+    static constexpr BitReverseTable<N> bitReverse{};
+};
+
+// Radix-2 stage of length Len; remaining stages are instantiated recursively
+template<size_t N, size_t Len>
+struct Stage {
+    static inline void run(float* d)
+    {
+        constexpr size_t half = Len / 2;
+        constexpr size_t step = N / Len;
+        const TwiddleTable<N>& w = Tables<N>::twiddles;
+
+        for (size_t i = 0; i < N; i += Len) {
+            for (size_t j = 0; j < half; ++j) {
+                const float wr = w.re[j * step];
+                const float wi = w.im[j * step];
+                float* a = d + 2 * (i + j);
+                float* b = d + 2 * (i + j + half);
+                const float vr = b[0] * wr - b[1] * wi;
+                const float vi = b[0] * wi + b[1] * wr;
+                const float ur = a[0];
+                const float ui = a[1];
+                a[0] = ur + vr;
+                a[1] = ui + vi;
+                b[0] = ur - vr;
+                b[1] = ui - vi;
+            }
+        }
+        Stage<N, Len * 2>::run(d);
+    }
+};
+
+template<size_t N>
+struct Stage<N, N * 2> {
+    static inline void run(float*) {}
+};
+
+} // namespace detail
+
+template<size_t N>
+void transform(std::complex<float>* data)
+{
+    static_assert(N >= 4 && (N & (N - 1)) == 0, "FFT kernel length must be a power of two >= 4");
+
+    const uint16_t* rev = detail::Tables<N>::bitReverse.index;
+    for (size_t i = 0; i < N; ++i) {
+        const size_t j = rev[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    // std::complex<float> is layout-compatible with float[2]
+    float* d = reinterpret_cast<float*>(data);
+
+    // Stages 1 and 2 fused: twiddles are 1 and -i, so no multiplications
+    for (size_t i = 0; i < N; i += 4) {
+        float* x = d + 2 * i;
+        const float ar = x[0] + x[2], ai = x[1] + x[3];
+        const float br = x[0] - x[2], bi = x[1] - x[3];
+        const float cr = x[4] + x[6], ci = x[5] + x[7];
+        const float dr = x[4] - x[6], di = x[5] - x[7];
+        x[0] = ar + cr;  x[1] = ai + ci;
+        x[4] = ar - cr;  x[5] = ai - ci;
+        // (dr + i*di) * -i = di - i*dr
+        x[2] = br + di;  x[3] = bi - dr;
+        x[6] = br - di;  x[7] = bi + dr;
+    }
+
+    detail::Stage<N, 8>::run(d);
+}
+
+// Runtime dispatcher. Returns false when no specialised kernel exists for n.
+inline bool dispatch(size_t n, std::complex<float>* data)
+{
+    switch (n) {
+    case 32:   transform<32>(data);   return true;
+    case 64:   transform<64>(data);   return true;
+    case 128:  transform<128>(data);  return true;
+    case 256:  transform<256>(data);  return true;
+    case 512:  transform<512>(data);  return true;
+    case 1024: transform<1024>(data); return true;
+    default:   return false;
+    }
+}
+
+inline bool hasKernel(size_t n)
+{
+    return n == 32 || n == 64 || n == 128 || n == 256 || n == 512 || n == 1024;
+}
+
+} // namespace FFTKernels
+
+#endif // FFTKERNELS_H
@@ -104,12 +104,38 @@ QColor FFTWidget::getAccentColor() const
 void FFTWidget::updateData(const RawADCFrameTest& adcFrame)
 {
     m_currentFrame = adcFrame;
-    if (!adcFrame.complex_data.empty()) {
-        performFFTFromComplexData(adcFrame.complex_data);
-    }
+    processCurrentFrame(true);
     update();
 }
 
+void FFTWidget::processCurrentFrame(bool newFrame)
+{
+    if (m_currentFrame.complex_data.empty()) return;
+
+    // Running DC/IQ statistics are not comparable between real and complex streams
+    if (m_currentFrame.data_format != m_lastDataFormat) {
+        m_iqCorrector.reset();
+        m_lastDataFormat = m_currentFrame.data_format;
+    }
+
+    // Real-only frames (data_format == 0) take the half-length real-input FFT
+    if (m_currentFrame.data_format == Rx_Data_Format_t::REAL_FLOAT) {
+        performFFTFromRealData(m_currentFrame.complex_data, newFrame);
+    } else {
+        performFFTFromComplexData(m_currentFrame.complex_data, newFrame);
+    }
+}
+
+void FFTWidget::setIQCorrectionEnabled(bool enabled)
+{
+    if (m_iqCorrector.isEnabled() != enabled) {
+        m_iqCorrector.setEnabled(enabled);
+        m_iqCorrector.reset();
+        processCurrentFrame(false);
+        update();
+    }
+}
+
 void FFTWidget::setFrequencyRange(float minFreq, float maxFreq)
 {
     m_minFrequency = minFreq;
@@ -130,8 +156,8 @@ void FFTWidget::setRadarParameters(float sampleRate, float sweepTime, float band
     m_bandwidth = bandwidth;
     m_centerFreq = centerFreq;
 
-    if (!m_magnitudeSpectrum.empty() && !m_currentFrame.complex_data.empty()) {
-        performFFTFromComplexData(m_currentFrame.complex_data);
+    if (!m_magnitudeSpectrum.empty()) {
+        processCurrentFrame(false);
     }
     update();
 }
@@ -179,59 +205,87 @@ float FFTWidget::sampleIndexToRange(int sampleIndex) const
     return m_rangeAxis[sampleIndex];
 }
 
-void FFTWidget::performFFTFromComplexData(const std::vector<ComplexSample>& complexInput)
+void FFTWidget::performFFTFromComplexData(const std::vector<ComplexSample>& complexInput, bool newFrame)
 {
     if (complexInput.empty()) return;
 
     size_t numComplexSamples = complexInput.size();
 
     // Find next power of 2 for FFT
-    size_t n = 1;
-    while (n < numComplexSamples) {
-        n *= 2;
+    size_t n = FFTEngine::nextPowerOfTwo(numComplexSamples);
+
+    // Stage samples as SoA I/Q buffers for the correction pass
+    m_iBuffer.resize(numComplexSamples);
+    m_qBuffer.resize(numComplexSamples);
+    for (size_t i = 0; i < numComplexSamples; ++i) {
+        m_iBuffer[i] = complexInput[i].I;
+        m_qBuffer[i] = complexInput[i].Q;
     }
 
-    std::vector<std::complex<float>> complexData(n);
+    // Remove DC offset, correct IQ imbalance and apply the Hanning window in one pass
+    m_iqCorrector.processComplex(m_iBuffer.data(), m_qBuffer.data(),
+                                 windowTable(numComplexSamples).data(), numComplexSamples, newFrame);
 
-    // Copy complex samples directly
-    for (size_t i = 0; i < numComplexSamples && i < n; ++i) {
-        complexData[i] = std::complex<float>(complexInput[i].I, complexInput[i].Q);
+    m_fftBuffer.resize(n);
+    for (size_t i = 0; i < numComplexSamples; ++i) {
+        m_fftBuffer[i] = std::complex<float>(m_iBuffer[i], m_qBuffer[i]);
     }
 
     // Zero-pad the rest
     for (size_t i = numComplexSamples; i < n; ++i) {
-        complexData[i] = std::complex<float>(0.0f, 0.0f);
+        m_fftBuffer[i] = std::complex<float>(0.0f, 0.0f);
     }
 
-    // Apply Hanning window for better spectral analysis
-    applyWindow(complexData, numComplexSamples);
-
     // Perform FFT
-    fft(complexData);
+    m_fftEngine.forward(m_fftBuffer);
+
+    computeMagnitudeSpectrum(m_fftBuffer.data(), n, numComplexSamples);
+}
+
+void FFTWidget::performFFTFromRealData(const std::vector<ComplexSample>& realInput, bool newFrame)
+{
+    if (realInput.empty()) return;
+
+    size_t numSamples = realInput.size();
+
+    // Real-input FFT needs at least two samples to pack into one complex point
+    size_t n = std::max<size_t>(2, FFTEngine::nextPowerOfTwo(numSamples));
+
+    m_realBuffer.resize(n);
+    for (size_t i = 0; i < numSamples; ++i) {
+        m_realBuffer[i] = realInput[i].I;
+    }
+    std::fill(m_realBuffer.begin() + numSamples, m_realBuffer.end(), 0.0f);
 
+    // Real-only frames have no Q channel: DC removal and windowing only
+    m_iqCorrector.processReal(m_realBuffer.data(), windowTable(numSamples).data(), numSamples, newFrame);
+
+    // N reals are transformed as an N/2-point complex FFT; bins 0..N/2 come back
+    m_fftEngine.forwardReal(m_realBuffer.data(), n, m_fftBuffer);
+
+    computeMagnitudeSpectrum(m_fftBuffer.data(), n, numSamples);
+}
+
+void FFTWidget::computeMagnitudeSpectrum(const std::complex<float>* bins, size_t fftSize, size_t numSamples)
+{
     // Calculate magnitude spectrum with RADAR-APPROPRIATE scaling
-    size_t spectrumSize = n / 2; // Only positive frequencies
+    size_t spectrumSize = fftSize / 2; // Only positive frequencies
     m_magnitudeSpectrum.resize(spectrumSize);
     m_frequencyAxis.resize(spectrumSize);
     m_rangeAxis.resize(spectrumSize);
 
     m_maxMagnitude = -50.0f; // Start with reasonable radar minimum
 
-    // Calculate radar-specific parameters for proper scaling
-    float rangeResolution = (SPEED_OF_LIGHT * m_sweepTime) / (2.0f * m_bandwidth);
-    float maxUnambiguousRange = (SPEED_OF_LIGHT * m_sampleRate * m_sweepTime) / (4.0f * m_bandwidth);
-
     // Scaling factor to match typical radar magnitudes
     float radarScalingFactor = 60.0f; // Adjust this to match Infineon levels
 
     for (size_t i = 0; i < spectrumSize; ++i) {
         // Calculate complex magnitude
-        std::complex<float> sample = complexData[i];
-        float magnitude_linear = std::abs(sample);
+        float magnitude_linear = std::abs(bins[i]);
 
         // RADAR-SPECIFIC MAGNITUDE CALCULATION
         // Apply FFT normalization
-        magnitude_linear = magnitude_linear / float(numComplexSamples);
+        magnitude_linear = magnitude_linear / float(numSamples);
 
         // Add small value to avoid log(0)
         magnitude_linear = std::max(magnitude_linear, 1e-8f);
@@ -240,16 +294,13 @@ void FFTWidget::performFFTFromComplexData(const std::vector<ComplexSample>& comp
         // This matches typical radar return levels
         float magnitude_dB = 20.0f * std::log10(magnitude_linear) + radarScalingFactor;
 
-        // Add additional conditioning for radar signals
-        if (i < spectrumSize / 4) {
-            // Boost near-range sensitivity (typical for radar)
-            magnitude_dB += 5.0f;
-        }
+        // Near-range boost removed: DC leakage is now corrected by IQCorrector
+        // before windowing, so near-range bins no longer need compensation
 
         m_magnitudeSpectrum[i] = magnitude_dB;
 
         // Calculate frequency for this bin
-        float frequency = (static_cast<float>(i) * m_sampleRate) / static_cast<float>(n);
+        float frequency = (static_cast<float>(i) * m_sampleRate) / static_cast<float>(fftSize);
         m_frequencyAxis[i] = frequency;
 
         // Calculate corresponding range using FMCW radar equation
@@ -304,53 +355,18 @@ void FFTWidget::performFFTFromComplexData(const std::vector<ComplexSample>& comp
 //     }
 // }
 
-void FFTWidget::applyWindow(std::vector<std::complex<float>>& data, size_t validSamples)
-{
-    // Apply Hanning window for better frequency resolution
-    for (size_t i = 0; i < validSamples; ++i) {
-        float window = 0.5f * (1.0f - std::cos(2.0f * M_PI * i / (validSamples - 1)));
-        data[i] *= window;
-    }
-}
-
-void FFTWidget::fft(std::vector<std::complex<float>>& data)
+const std::vector<float>& FFTWidget::windowTable(size_t validSamples)
 {
-    size_t n = data.size();
-    if (n <= 1) return;
-
-    bit_reverse(data);
-
-    for (size_t len = 2; len <= n; len <<= 1) {
-        float angle = -2.0f * M_PI / len;
-        std::complex<float> wlen(std::cos(angle), std::sin(angle));
-
-        for (size_t i = 0; i < n; i += len) {
-            std::complex<float> w(1.0f, 0.0f);
-            for (size_t j = 0; j < len / 2; ++j) {
-                std::complex<float> u = data[i + j];
-                std::complex<float> v = data[i + j + len / 2] * w;
-                data[i + j] = u + v;
-                data[i + j + len / 2] = u - v;
-                w *= wlen;
-            }
-        }
-    }
-}
-
-void FFTWidget::bit_reverse(std::vector<std::complex<float>>& data)
-{
-    size_t n = data.size();
-    for (size_t i = 1, j = 0; i < n; ++i) {
-        size_t bit = n >> 1;
-        for (; j & bit; bit >>= 1) {
-            j ^= bit;
-        }
-        j ^= bit;
-
-        if (i < j) {
-            std::swap(data[i], data[j]);
+    // Hanning window for better frequency resolution, rebuilt only when the length changes
+    if (m_window.size() != validSamples) {
+        m_window.resize(validSamples);
+        for (size_t i = 0; i < validSamples; ++i) {
+            m_window[i] = validSamples > 1
+                ? 0.5f * (1.0f - std::cos(2.0f * M_PI * i / (validSamples - 1)))
+                : 1.0f;
         }
     }
+    return m_window;
 }
 
 void FFTWidget::resizeEvent(QResizeEvent *event)
@@ -90,6 +90,8 @@
 #include <vector>
 #include <complex>
 #include "DataStructures.h"
+#include "FFTEngine.h"
+#include "IQCorrector.h"
 
 //// Forward declarations (make sure these match your main structures)
 //struct ComplexSample {
@@ -157,6 +159,7 @@ public:
     void setMinAngle(float minAngle);
     void setMaxAngle(float maxAngle);
     void setDarkTheme(bool isDark);  // NEW: Set dark/light theme
+    void setIQCorrectionEnabled(bool enabled);
     
     // Getters
     float getMaxRange() const { return m_maxRange; }
@@ -164,6 +167,8 @@ public:
     float getMinAngle() const { return m_minAngle; }
     float getMaxAngle() const { return m_maxAngle; }
     bool isDarkTheme() const { return m_isDarkTheme; }  // NEW: Get current theme
+    bool isIQCorrectionEnabled() const { return m_iqCorrector.isEnabled(); }
+    const IQCorrector& iqCorrector() const { return m_iqCorrector; }
 
 protected:
     void paintEvent(QPaintEvent *event) override;
@@ -177,10 +182,12 @@ private:
 
     // Core FFT and data processing
     void performFFT(const std::vector<float>& input);  // Legacy function
-    void performFFTFromComplexData(const std::vector<ComplexSample>& complexInput);
-    void fft(std::vector<std::complex<float>>& data);
-    void bit_reverse(std::vector<std::complex<float>>& data);
-    void applyWindow(std::vector<std::complex<float>>& data, size_t validSamples);
+    void performFFTFromComplexData(const std::vector<ComplexSample>& complexInput, bool newFrame);
+    void performFFTFromRealData(const std::vector<ComplexSample>& realInput, bool newFrame);  // REAL_FLOAT fast path
+    // newFrame = false re-processes the current frame without feeding it to the IQ statistics again
+    void processCurrentFrame(bool newFrame);
+    void computeMagnitudeSpectrum(const std::complex<float>* bins, size_t fftSize, size_t numSamples);
+    const std::vector<float>& windowTable(size_t validSamples);  // Cached Hanning coefficients
 
     // Enhanced processing functions
     float applyWindowWithCorrection(std::vector<std::complex<float>>& data, size_t validSamples);
@@ -214,6 +221,18 @@ private:
     std::vector<float> m_frequencyAxis;
     std::vector<float> m_rangeAxis;
 
+    // FFT plans and working buffers (reused across frames)
+    FFTEngine m_fftEngine;
+    std::vector<std::complex<float>> m_fftBuffer;
+    std::vector<float> m_realBuffer;
+    std::vector<float> m_iBuffer;     // SoA in-phase samples for the correction pass
+    std::vector<float> m_qBuffer;     // SoA quadrature samples for the correction pass
+    std::vector<float> m_window;
+
+    // DC offset / IQ imbalance correction (running statistics across frames)
+    IQCorrector m_iqCorrector;
+    Rx_Data_Format_t m_lastDataFormat = Rx_Data_Format_t::COMPLEX_FLOAT;
+
     // Display parameters
     float m_maxMagnitude;
     float m_minFrequency = 0.0f;
@@ -0,0 +1,257 @@
+#include "IQCorrector.h"
+#include <cmath>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IQCORRECTOR_USE_SSE2 1
+#endif
+
+namespace {
+constexpr double MIN_POWER = 1e-20;
+
+#ifdef IQCORRECTOR_USE_SSE2
+inline float horizontalSum(__m128 v)
+{
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+#endif
+}
+
+IQCorrector::IQCorrector()
+    : m_enabled(true)
+    , m_initialised(false)
+    , m_rate(0.05f)
+    , m_dcI(0.0f)
+    , m_dcQ(0.0f)
+    , m_powerI(0.0)
+    , m_powerQ(0.0)
+    , m_crossIQ(0.0)
+    , m_gainCoeff(1.0f)
+    , m_phaseCoeff(0.0f)
+{
+}
+
+void IQCorrector::setAdaptationRate(float rate)
+{
+    m_rate = std::min(1.0f, std::max(1e-4f, rate));
+}
+
+void IQCorrector::reset()
+{
+    m_initialised = false;
+    m_dcI = 0.0f;
+    m_dcQ = 0.0f;
+    m_powerI = 0.0;
+    m_powerQ = 0.0;
+    m_crossIQ = 0.0;
+    m_gainCoeff = 1.0f;
+    m_phaseCoeff = 0.0f;
+}
+
+float IQCorrector::gainImbalanceDb() const
+{
+    if (m_powerI < MIN_POWER || m_powerQ < MIN_POWER) return 0.0f;
+    return static_cast<float>(10.0 * std::log10(m_powerQ / m_powerI));
+}
+
+float IQCorrector::phaseImbalanceDeg() const
+{
+    double norm = std::sqrt(m_powerI * m_powerQ);
+    if (norm < MIN_POWER) return 0.0f;
+    double s = std::max(-1.0, std::min(1.0, m_crossIQ / norm));
+    return static_cast<float>(std::asin(s) * 180.0 / 3.14159265358979323846);
+}
+
+// Statistics-only pass, used once to seed the estimates on the first frame
+IQCorrector::Moments IQCorrector::accumulate(const float* i, const float* q, size_t n) const
+{
+    Moments m;
+    for (size_t k = 0; k < n; ++k) {
+        double di = i[k] - m_dcI;
+        double dq = q ? q[k] - m_dcQ : 0.0;
+        m.sumI += di;
+        m.sumQ += dq;
+        m.sumII += di * di;
+        m.sumQQ += dq * dq;
+        m.sumIQ += di * dq;
+    }
+    return m;
+}
+
+void IQCorrector::updateEstimates(const Moments& m, size_t n, bool hasQ)
+{
+    if (n == 0) return;
+
+    // Moments were accumulated relative to the current DC estimate, which
+    // keeps the variance terms free of large-offset cancellation
+    const double invN = 1.0 / static_cast<double>(n);
+    const double meanI = m.sumI * invN;
+    const double meanQ = m.sumQ * invN;
+    const double powerI = std::max(0.0, m.sumII * invN - meanI * meanI);
+    const double powerQ = std::max(0.0, m.sumQQ * invN - meanQ * meanQ);
+    const double crossIQ = m.sumIQ * invN - meanI * meanQ;
+
+    const double a = m_initialised ? m_rate : 1.0;
+    m_dcI += static_cast<float>(a * meanI);
+    m_dcQ += static_cast<float>(a * meanQ);
+    m_powerI += a * (powerI - m_powerI);
+    m_powerQ += a * (powerQ - m_powerQ);
+    m_crossIQ += a * (crossIQ - m_crossIQ);
+    m_initialised = true;
+
+    if (!hasQ || m_powerI < MIN_POWER) {
+        m_gainCoeff = 1.0f;
+        m_phaseCoeff = 0.0f;
+        return;
+    }
+
+    // Remove the part of Q correlated with I, then rescale Q to the power of I
+    const double rho = m_crossIQ / m_powerI;
+    const double orthPowerQ = m_powerQ - m_crossIQ * rho;
+    if (orthPowerQ < MIN_POWER) {
+        m_gainCoeff = 1.0f;
+        m_phaseCoeff = 0.0f;
+        return;
+    }
+    const double gain = std::sqrt(m_powerI / orthPowerQ);
+    m_gainCoeff = static_cast<float>(gain);
+    m_phaseCoeff = static_cast<float>(-gain * rho);
+}
+
+void IQCorrector::processComplex(float* i, float* q, const float* window, size_t n, bool updateStatistics)
+{
+    if (n == 0) return;
+
+    if (!m_enabled) {
+        for (size_t k = 0; k < n; ++k) {
+            i[k] *= window[k];
+            q[k] *= window[k];
+        }
+        return;
+    }
+
+    // The first counted frame seeds the estimates from itself and is not
+    // counted again below
+    const bool seed = !m_initialised && updateStatistics;
+    if (seed) {
+        updateEstimates(accumulate(i, q, n), n, true);
+    }
+
+    const float dcI = m_dcI;
+    const float dcQ = m_dcQ;
+    const float gain = m_gainCoeff;
+    const float phase = m_phaseCoeff;
+
+    float sumI = 0.0f, sumQ = 0.0f, sumII = 0.0f, sumQQ = 0.0f, sumIQ = 0.0f;
+    size_t k = 0;
+
+#ifdef IQCORRECTOR_USE_SSE2
+    const __m128 vDcI = _mm_set1_ps(dcI);
+    const __m128 vDcQ = _mm_set1_ps(dcQ);
+    const __m128 vGain = _mm_set1_ps(gain);
+    const __m128 vPhase = _mm_set1_ps(phase);
+    __m128 aI = _mm_setzero_ps(), aQ = _mm_setzero_ps();
+    __m128 aII = _mm_setzero_ps(), aQQ = _mm_setzero_ps(), aIQ = _mm_setzero_ps();
+
+    for (; k + 4 <= n; k += 4) {
+        __m128 di = _mm_sub_ps(_mm_loadu_ps(i + k), vDcI);
+        __m128 dq = _mm_sub_ps(_mm_loadu_ps(q + k), vDcQ);
+        __m128 w = _mm_loadu_ps(window + k);
+
+        // Statistics for the next frame's estimates
+        aI = _mm_add_ps(aI, di);
+        aQ = _mm_add_ps(aQ, dq);
+        aII = _mm_add_ps(aII, _mm_mul_ps(di, di));
+        aQQ = _mm_add_ps(aQQ, _mm_mul_ps(dq, dq));
+        aIQ = _mm_add_ps(aIQ, _mm_mul_ps(di, dq));
+
+        // Correct and window
+        __m128 cq = _mm_add_ps(_mm_mul_ps(dq, vGain), _mm_mul_ps(di, vPhase));
+        _mm_storeu_ps(i + k, _mm_mul_ps(di, w));
+        _mm_storeu_ps(q + k, _mm_mul_ps(cq, w));
+    }
+
+    sumI = horizontalSum(aI);
+    sumQ = horizontalSum(aQ);
+    sumII = horizontalSum(aII);
+    sumQQ = horizontalSum(aQQ);
+    sumIQ = horizontalSum(aIQ);
+#endif
+
+    for (; k < n; ++k) {
+        float di = i[k] - dcI;
+        float dq = q[k] - dcQ;
+        sumI += di;
+        sumQ += dq;
+        sumII += di * di;
+        sumQQ += dq * dq;
+        sumIQ += di * dq;
+        i[k] = di * window[k];
+        q[k] = (dq * gain + di * phase) * window[k];
+    }
+
+    if (!updateStatistics || seed) return;
+
+    Moments m;
+    m.sumI = sumI;
+    m.sumQ = sumQ;
+    m.sumII = sumII;
+    m.sumQQ = sumQQ;
+    m.sumIQ = sumIQ;
+    updateEstimates(m, n, true);
+}
+
+void IQCorrector::processReal(float* x, const float* window, size_t n, bool updateStatistics)
+{
+    if (n == 0) return;
+
+    if (!m_enabled) {
+        for (size_t k = 0; k < n; ++k) {
+            x[k] *= window[k];
+        }
+        return;
+    }
+
+    // The first counted frame seeds the estimates from itself and is not
+    // counted again below
+    const bool seed = !m_initialised && updateStatistics;
+    if (seed) {
+        updateEstimates(accumulate(x, nullptr, n), n, false);
+    }
+
+    const float dc = m_dcI;
+    float sum = 0.0f, sumSq = 0.0f;
+    size_t k = 0;
+
+#ifdef IQCORRECTOR_USE_SSE2
+    const __m128 vDc = _mm_set1_ps(dc);
+    __m128 aSum = _mm_setzero_ps(), aSq = _mm_setzero_ps();
+    for (; k + 4 <= n; k += 4) {
+        __m128 d = _mm_sub_ps(_mm_loadu_ps(x + k), vDc);
+        aSum = _mm_add_ps(aSum, d);
+        aSq = _mm_add_ps(aSq, _mm_mul_ps(d, d));
+        _mm_storeu_ps(x + k, _mm_mul_ps(d, _mm_loadu_ps(window + k)));
+    }
+    sum = horizontalSum(aSum);
+    sumSq = horizontalSum(aSq);
+#endif
+
+    for (; k < n; ++k) {
+        float d = x[k] - dc;
+        sum += d;
+        sumSq += d * d;
+        x[k] = d * window[k];
+    }
+
+    if (!updateStatistics || seed) return;
+
+    Moments m;
+    m.sumI = sum;
+    m.sumII = sumSq;
+    updateEstimates(m, n, false);
+}
@@ -0,0 +1,75 @@
+#ifndef IQCORRECTOR_H
+#define IQCORRECTOR_H
+
+#include <cstddef>
+
+// Streaming DC offset and IQ gain/phase imbalance corrector.
+//
+// Running first and second moments of the raw samples are kept across frames
+// (exponential averaging), so estimates converge over time instead of being
+// recomputed from a single frame. Correction for frame k uses the estimates
+// accumulated up to frame k-1; the statistics of frame k are gathered in the
+// same pass that corrects and windows it.
+//
+// Correction model (Gram-Schmidt orthogonalisation of Q against I):
+//   I' = I - dcI
+//   Q' = gainCoeff * (Q - dcQ) + phaseCoeff * (I - dcI)
+class IQCorrector
+{
+public:
+    IQCorrector();
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    // Weight of the newest frame in the running statistics (0 < rate <= 1)
+    void setAdaptationRate(float rate);
+    float adaptationRate() const { return m_rate; }
+
+    void reset();
+
+    // Fused pass over SoA buffers: remove DC, correct IQ imbalance and apply
+    // the window, in place. window must hold at least n coefficients. Pass
+    // updateStatistics = false when re-processing a frame already seen, so
+    // it is not counted twice in the running estimates; such a frame does
+    // not seed them either.
+    void processComplex(float* i, float* q, const float* window, size_t n, bool updateStatistics = true);
+
+    // Real-only frames: DC removal and windowing only
+    void processReal(float* x, const float* window, size_t n, bool updateStatistics = true);
+
+    // Current estimates (for diagnostics / status display)
+    float dcOffsetI() const { return m_dcI; }
+    float dcOffsetQ() const { return m_dcQ; }
+    float gainImbalanceDb() const;     // 20*log10(rms(Q) / rms(I))
+    float phaseImbalanceDeg() const;   // Deviation from 90 degrees between I and Q
+
+private:
+    struct Moments {
+        double sumI = 0.0;
+        double sumQ = 0.0;
+        double sumII = 0.0;
+        double sumQQ = 0.0;
+        double sumIQ = 0.0;
+    };
+
+    Moments accumulate(const float* i, const float* q, size_t n) const;
+    void updateEstimates(const Moments& m, size_t n, bool hasQ);
+
+    bool m_enabled;
+    bool m_initialised;
+    float m_rate;
+
+    // Running estimates
+    float m_dcI;
+    float m_dcQ;
+    double m_powerI;   // Centred E[I^2]
+    double m_powerQ;   // Centred E[Q^2]
+    double m_crossIQ;  // Centred E[IQ]
+
+    // Derived correction coefficients
+    float m_gainCoeff;
+    float m_phaseCoeff;
+};
+
+#endif // IQCORRECTOR_H
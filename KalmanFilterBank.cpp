@@ -0,0 +1,256 @@
+#include "KalmanFilterBank.h"
+#include <algorithm>
+
+namespace {
+// Initial uncertainty of the unobserved derivatives
+constexpr float INITIAL_RANGE_RATE_VAR = 100.0f;      // (10 m/s)^2
+constexpr float INITIAL_RANGE_ACCEL_VAR = 25.0f;      // (5 m/s^2)^2
+constexpr float INITIAL_AZIMUTH_RATE_VAR = 900.0f;    // (30 deg/s)^2
+constexpr float MAX_DT = 2.0f;                        // Cap prediction gaps (s)
+}
+
+KalmanFilterBank::KalmanFilterBank(MotionModel model)
+    : m_model(model)
+    , m_rangeNoise(model == MotionModel::ConstantAcceleration ? 4.0f : 1.0f)
+    , m_azimuthNoise(25.0f)
+    , m_rangeMeasVar(0.15f * 0.15f)
+    , m_azimuthMeasVar(1.0f)
+    , m_latestTimestamp(0)
+{
+}
+
+void KalmanFilterBank::setMotionModel(MotionModel model)
+{
+    if (model != m_model) {
+        m_model = model;
+        clear();    // State dimensions differ; restart all tracks
+    }
+}
+
+void KalmanFilterBank::setProcessNoise(float rangeNoise, float azimuthNoise)
+{
+    m_rangeNoise = std::max(0.0f, rangeNoise);
+    m_azimuthNoise = std::max(0.0f, azimuthNoise);
+}
+
+void KalmanFilterBank::setMeasurementNoise(float rangeStd, float azimuthStd)
+{
+    m_rangeMeasVar = std::max(1e-6f, rangeStd * rangeStd);
+    m_azimuthMeasVar = std::max(1e-6f, azimuthStd * azimuthStd);
+}
+
+void KalmanFilterBank::clear()
+{
+    m_slotOf.clear();
+    m_freeSlots.clear();
+    m_trackId.clear();
+    m_active.clear();
+    m_lastTimestamp.clear();
+    m_updates.clear();
+    m_latestTimestamp = 0;
+
+    for (auto* v : { &m_mask, &m_dt, &m_zRange, &m_zAzimuth,
+                     &m_r, &m_v, &m_a, &m_p00, &m_p01, &m_p02, &m_p11, &m_p12, &m_p22,
+                     &m_az, &m_azRate, &m_q00, &m_q01, &m_q11 }) {
+        v->clear();
+    }
+}
+
+size_t KalmanFilterBank::allocateSlot(uint32_t trackId)
+{
+    size_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = m_trackId.size();
+        m_trackId.push_back(0);
+        m_active.push_back(0);
+        m_lastTimestamp.push_back(0);
+        m_updates.push_back(0);
+        for (auto* v : { &m_mask, &m_dt, &m_zRange, &m_zAzimuth,
+                         &m_r, &m_v, &m_a, &m_p00, &m_p01, &m_p02, &m_p11, &m_p12, &m_p22,
+                         &m_az, &m_azRate, &m_q00, &m_q01, &m_q11 }) {
+            v->push_back(0.0f);
+        }
+    }
+    m_trackId[slot] = trackId;
+    m_active[slot] = 1;
+    m_slotOf.insert(trackId, static_cast<uint32_t>(slot));
+    return slot;
+}
+
+void KalmanFilterBank::releaseSlot(size_t slot)
+{
+    m_slotOf.erase(m_trackId[slot]);
+    m_active[slot] = 0;
+    m_mask[slot] = 0.0f;
+    m_dt[slot] = 0.0f;
+    m_freeSlots.push_back(slot);
+}
+
+void KalmanFilterBank::initialiseSlot(size_t slot, qint64 timestampMs, float range, float azimuth)
+{
+    const bool ca = (m_model == MotionModel::ConstantAcceleration);
+    m_lastTimestamp[slot] = timestampMs;
+    m_updates[slot] = 1;
+    m_mask[slot] = 0.0f;        // The first measurement is the initial state, not an update
+    m_dt[slot] = 0.0f;
+
+    m_r[slot] = range;
+    m_v[slot] = 0.0f;
+    m_a[slot] = 0.0f;
+    m_p00[slot] = m_rangeMeasVar;
+    m_p01[slot] = 0.0f;
+    m_p02[slot] = 0.0f;
+    m_p11[slot] = INITIAL_RANGE_RATE_VAR;
+    m_p12[slot] = 0.0f;
+    m_p22[slot] = ca ? INITIAL_RANGE_ACCEL_VAR : 0.0f;
+
+    m_az[slot] = azimuth;
+    m_azRate[slot] = 0.0f;
+    m_q00[slot] = m_azimuthMeasVar;
+    m_q01[slot] = 0.0f;
+    m_q11[slot] = INITIAL_AZIMUTH_RATE_VAR;
+}
+
+void KalmanFilterBank::addMeasurement(uint32_t trackId, qint64 timestampMs, float range, float azimuth)
+{
+    m_latestTimestamp = std::max(m_latestTimestamp, timestampMs);
+
+    const uint32_t found = m_slotOf.find(trackId);
+    if (found == TrackIndex::NO_SLOT) {
+        initialiseSlot(allocateSlot(trackId), timestampMs, range, azimuth);
+        return;
+    }
+
+    const size_t slot = found;
+    const float dt = static_cast<float>(timestampMs - m_lastTimestamp[slot]) / 1000.0f;
+    if (dt <= 0.0f) return;     // Same report seen twice (display refresh), nothing new
+
+    m_mask[slot] = 1.0f;
+    m_dt[slot] = std::min(dt, MAX_DT);
+    m_zRange[slot] = range;
+    m_zAzimuth[slot] = azimuth;
+    m_lastTimestamp[slot] = timestampMs;
+    ++m_updates[slot];
+}
+
+void KalmanFilterBank::step()
+{
+    const size_t n = m_trackId.size();
+    const bool ca = (m_model == MotionModel::ConstantAcceleration);
+    const float qr = m_rangeNoise;
+    const float qa = m_azimuthNoise;
+    const float rr = m_rangeMeasVar;
+    const float ra = m_azimuthMeasVar;
+
+    float* r = m_r.data();   float* v = m_v.data();   float* a = m_a.data();
+    float* p00 = m_p00.data(); float* p01 = m_p01.data(); float* p02 = m_p02.data();
+    float* p11 = m_p11.data(); float* p12 = m_p12.data(); float* p22 = m_p22.data();
+    float* az = m_az.data(); float* azr = m_azRate.data();
+    float* q00 = m_q00.data(); float* q01 = m_q01.data(); float* q11 = m_q11.data();
+    const float* mask = m_mask.data();
+    const float* dts = m_dt.data();
+    const float* zr = m_zRange.data();
+    const float* za = m_zAzimuth.data();
+
+    // One pass over all slots; dt = 0 and mask = 0 make predict and update identities
+    for (size_t i = 0; i < n; ++i) {
+        const float m = mask[i];
+        const float dt = dts[i] * m;
+        const float dt2 = dt * dt;
+        const float h = 0.5f * dt2;
+        const float dt3 = dt2 * dt;
+
+        // --- Range predict: x = F x, P = F P F' + Q ---
+        const float rp = r[i] + dt * v[i] + h * a[i];
+        const float vp = v[i] + dt * a[i];
+        const float ap = a[i];
+
+        const float A0 = p00[i] + dt * p01[i] + h * p02[i];
+        const float A1 = p01[i] + dt * p11[i] + h * p12[i];
+        const float A2 = p02[i] + dt * p12[i] + h * p22[i];
+        const float B1 = p11[i] + dt * p12[i];
+        const float B2 = p12[i] + dt * p22[i];
+
+        // CA: white jerk; CV: white acceleration (acceleration terms stay zero)
+        const float Q00 = ca ? qr * dt3 * dt2 / 20.0f : qr * dt3 / 3.0f;
+        const float Q01 = ca ? qr * dt2 * dt2 / 8.0f  : qr * dt2 / 2.0f;
+        const float Q02 = ca ? qr * dt3 / 6.0f        : 0.0f;
+        const float Q11 = ca ? qr * dt3 / 3.0f        : qr * dt;
+        const float Q12 = ca ? qr * dt2 / 2.0f        : 0.0f;
+        const float Q22 = ca ? qr * dt                : 0.0f;
+
+        float P00 = A0 + dt * A1 + h * A2 + Q00;
+        float P01 = A1 + dt * A2 + Q01;
+        float P02 = A2 + Q02;
+        float P11 = B1 + dt * B2 + Q11;
+        float P12 = B2 + Q12;
+        float P22 = p22[i] + Q22;
+
+        // --- Range update with z = r ---
+        const float s = P00 + rr;
+        const float k0 = m * P00 / s;
+        const float k1 = m * P01 / s;
+        const float k2 = m * P02 / s;
+        const float y = zr[i] - rp;
+
+        r[i] = rp + k0 * y;
+        v[i] = vp + k1 * y;
+        a[i] = ap + k2 * y;
+        p22[i] = P22 - k2 * P02;
+        p12[i] = P12 - k1 * P02;
+        p11[i] = P11 - k1 * P01;
+        p02[i] = P02 - k0 * P02;
+        p01[i] = P01 - k0 * P01;
+        p00[i] = P00 - k0 * P00;
+
+        // --- Azimuth CV predict ---
+        const float azp = az[i] + dt * azr[i];
+        const float C0 = q00[i] + dt * q01[i];
+        const float C1 = q01[i] + dt * q11[i];
+        const float Q00a = qa * dt3 / 3.0f + C0 + dt * C1;
+        const float Q01a = qa * dt2 / 2.0f + C1;
+        const float Q11a = qa * dt + q11[i];
+
+        // --- Azimuth update with z = az ---
+        const float sa = Q00a + ra;
+        const float g0 = m * Q00a / sa;
+        const float g1 = m * Q01a / sa;
+        const float ya = za[i] - azp;
+
+        az[i] = azp + g0 * ya;
+        azr[i] = azr[i] + g1 * ya;
+        q11[i] = Q11a - g1 * Q01a;
+        q01[i] = Q01a - g0 * Q01a;
+        q00[i] = Q00a - g0 * Q00a;
+    }
+
+    // Clear staged measurements and drop tracks that stopped reporting
+    std::fill(m_mask.begin(), m_mask.end(), 0.0f);
+    std::fill(m_dt.begin(), m_dt.end(), 0.0f);
+    for (size_t i = 0; i < n; ++i) {
+        if (m_active[i] && m_latestTimestamp - m_lastTimestamp[i] > TRACK_TIMEOUT_MS) {
+            releaseSlot(i);
+        }
+    }
+}
+
+bool KalmanFilterBank::estimate(uint32_t trackId, Estimate& out) const
+{
+    const uint32_t found = m_slotOf.find(trackId);
+    if (found == TrackIndex::NO_SLOT) return false;
+
+    const size_t i = found;
+    out.range = m_r[i];
+    out.rangeRate = m_v[i];
+    out.rangeAccel = m_a[i];
+    out.azimuth = m_az[i];
+    out.azimuthRate = m_azRate[i];
+    out.rangeVariance = m_p00[i];
+    out.rangeRateVariance = m_p11[i];
+    out.azimuthRateVariance = m_q11[i];
+    out.updates = m_updates[i];
+    return true;
+}
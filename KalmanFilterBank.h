@@ -0,0 +1,98 @@
+#ifndef KALMANFILTERBANK_H
+#define KALMANFILTERBANK_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <QtGlobal>
+#include "TrackStateStore.h"
+
+// Bank of per-track Kalman filters for range and azimuth.
+//
+// Range uses a constant-velocity or constant-acceleration model, azimuth a
+// constant-velocity model; both are updated with scalar position
+// measurements, so no matrix inversion is needed. State and the unique
+// covariance terms of every track live in separate flat arrays (SoA), and
+// step() runs predict + update for all tracks in a single branch-free loop:
+// tracks without a measurement this frame are masked out rather than skipped,
+// which lets the compiler vectorise the pass.
+class KalmanFilterBank
+{
+public:
+    enum class MotionModel {
+        ConstantVelocity,
+        ConstantAcceleration
+    };
+
+    struct Estimate {
+        float range = 0.0f;             // m
+        float rangeRate = 0.0f;         // m/s (positive = receding)
+        float rangeAccel = 0.0f;        // m/s^2 (0 for the CV model)
+        float azimuth = 0.0f;           // deg
+        float azimuthRate = 0.0f;       // deg/s
+        float rangeVariance = 0.0f;
+        float rangeRateVariance = 0.0f;
+        float azimuthRateVariance = 0.0f;
+        uint32_t updates = 0;           // Measurements absorbed since the track started
+    };
+
+    explicit KalmanFilterBank(MotionModel model = MotionModel::ConstantVelocity);
+
+    void setMotionModel(MotionModel model);
+    MotionModel motionModel() const { return m_model; }
+
+    // Process noise spectral densities: range in (m/s^2)^2/Hz for CV, (m/s^3)^2/Hz for CA;
+    // azimuth in (deg/s^2)^2/Hz
+    void setProcessNoise(float rangeNoise, float azimuthNoise);
+    // Measurement standard deviations (m, deg)
+    void setMeasurementNoise(float rangeStd, float azimuthStd);
+
+    // Stage a measurement for the next step(); a new track id starts a filter
+    void addMeasurement(uint32_t trackId, qint64 timestampMs, float range, float azimuth);
+
+    // Predict and update every track that has a staged measurement; tracks
+    // without a measurement for longer than the timeout are dropped
+    void step();
+
+    bool estimate(uint32_t trackId, Estimate& out) const;
+    size_t trackCount() const { return m_slotOf.size(); }
+    void clear();
+
+    static constexpr qint64 TRACK_TIMEOUT_MS = 5000;
+
+private:
+    size_t allocateSlot(uint32_t trackId);
+    void initialiseSlot(size_t slot, qint64 timestampMs, float range, float azimuth);
+    void releaseSlot(size_t slot);
+
+    MotionModel m_model;
+    float m_rangeNoise;
+    float m_azimuthNoise;
+    float m_rangeMeasVar;
+    float m_azimuthMeasVar;
+
+    // Slot bookkeeping
+    TrackIndex m_slotOf;                // Track id -> slot (open addressing)
+    std::vector<size_t> m_freeSlots;
+    std::vector<uint32_t> m_trackId;
+    std::vector<uint8_t> m_active;
+    std::vector<qint64> m_lastTimestamp;
+    std::vector<uint32_t> m_updates;
+    qint64 m_latestTimestamp;
+
+    // Staged measurements (mask is 1.0 when slot has a measurement this step)
+    std::vector<float> m_mask;
+    std::vector<float> m_dt;
+    std::vector<float> m_zRange;
+    std::vector<float> m_zAzimuth;
+
+    // Range state [r, v, a] and symmetric covariance
+    std::vector<float> m_r, m_v, m_a;
+    std::vector<float> m_p00, m_p01, m_p02, m_p11, m_p12, m_p22;
+
+    // Azimuth state [az, azRate] and symmetric covariance
+    std::vector<float> m_az, m_azRate;
+    std::vector<float> m_q00, m_q01, m_q11;
+};
+
+#endif // KALMANFILTERBANK_H
@@ -6,12 +6,15 @@
 #include <QFont>
 #include <QFontMetrics>
 #include <QFileDialog>
-#include <QTextStream>
 #include <QMessageBox>
 #include <QDialog>
+#include <QTabWidget>
 #include <QHeaderView>
 #include <QFileInfo>
+#include <QProgressDialog>
+#include <QDebug>
 #include <algorithm>
+#include <climits>
 
 // ==================== LoggingPlotWidget Implementation ====================
 
@@ -841,13 +844,20 @@ LoggingWidget::LoggingWidget(QWidget *parent)
     , m_speedTimePlot(nullptr)
     , m_rvPlot(nullptr)
     , m_dataTable(nullptr)
+    , m_trackLogs(MAX_LOGGED_TRACKS, MAX_DATA_POINTS_PER_TRACK)
     , m_isLogging(false)
     , m_isDarkTheme(false)
     , m_loggingStartTime(0)
     , m_totalDataPoints(0)
+    , m_currentTime(QDateTime::currentMSecsSinceEpoch())
+    , m_staleIntervalSecond(0)
     , m_isDetached(false)
     , m_detachedWindow(nullptr)
     , m_plotRefreshTimer(nullptr)
+    , m_importTimer(nullptr)
+    , m_importProgress(nullptr)
+    , m_exportTimer(nullptr)
+    , m_exportProgress(nullptr)
     , m_algorithmWindow(5)
     , m_smoothingWindow(3)
     , m_lastExportDirectory("")
@@ -858,6 +868,16 @@ LoggingWidget::LoggingWidget(QWidget *parent)
     m_plotRefreshTimer = new QTimer(this);
     m_plotRefreshTimer->setInterval(1000);  // Refresh every 1 second
     connect(m_plotRefreshTimer, &QTimer::timeout, this, &LoggingWidget::onRefreshPlotsTimer);
+    
+    // Polls a running CSV import for progress and completion
+    m_importTimer = new QTimer(this);
+    m_importTimer->setInterval(50);
+    connect(m_importTimer, &QTimer::timeout, this, &LoggingWidget::onImportProgress);
+    
+    // Polls a running export the same way
+    m_exportTimer = new QTimer(this);
+    m_exportTimer->setInterval(50);
+    connect(m_exportTimer, &QTimer::timeout, this, &LoggingWidget::onExportProgress);
 }
 
 LoggingWidget::~LoggingWidget()
@@ -1129,17 +1149,17 @@ void LoggingWidget::setupDataTable()
     m_dataTable->setMaximumHeight(200);
 }
 
-void LoggingWidget::updateFromTargets(const TargetTrackData& targets)
+void LoggingWidget::updateFromTargets(const TargetTrackData& targets, qint64 currentTime)
 {
+    m_currentTime = currentTime;
     if (!m_isLogging) return;
     
-    logTrackData(targets);
+    logTrackData(targets, currentTime);
     
-    // Auto-update plots if enabled
-    if (m_autoUpdatePlotsCheckBox && m_autoUpdatePlotsCheckBox->isChecked()) {
-        if (!m_plotRefreshTimer->isActive()) {
-            m_plotRefreshTimer->start();
-        }
+    // The refresh timer auto-updates plots if enabled and closes the seconds
+    // of tracks that stopped reporting
+    if (!m_plotRefreshTimer->isActive()) {
+        m_plotRefreshTimer->start();
     }
     
     // Update status with second interval information
@@ -1150,11 +1170,13 @@ void LoggingWidget::updateFromTargets(const TargetTrackData& targets)
                            .arg(totalIntervals));
 }
 
-void LoggingWidget::logTrackData(const TargetTrackData& targets)
+void LoggingWidget::logTrackData(const TargetTrackData& targets, qint64 currentTime)
 {
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
     qint64 currentSecond = (currentTime / 1000) * 1000;  // Truncate to second boundary
     
+    closeStaleSecondIntervals(currentSecond);
+    m_evictedTrackIds.clear();
+    
     for (size_t i = 0; i < targets.numTracks && i < targets.targets.size(); ++i) {
         const TargetTrack& target = targets.targets[i];
         
@@ -1166,50 +1188,109 @@ void LoggingWidget::logTrackData(const TargetTrackData& targets)
         dataPoint.azimuth = target.azimuth;
         dataPoint.radial_speed = target.radial_speed;
         dataPoint.azimuth_speed = target.azimuth_speed;
-        dataPoint.computed_range_rate = 0.0f;  // Will be computed from interval data
+        dataPoint.computed_range_rate = 0.0f;  // Filled in by the track's estimator below
         
-        // Add to track log
-        if (!m_trackLogs.contains(target.target_id)) {
-            TrackLogData newTrack;
-            newTrack.track_id = target.target_id;
-            newTrack.firstSeen = currentTime;
-            newTrack.lastSeen = currentTime;
-            newTrack.currentSecond = currentSecond;
-            m_trackLogs[target.target_id] = newTrack;
-            
+        // Find or create the track's slot (recycles the stalest track when full)
+        const bool isNew = !m_trackLogs.contains(target.target_id);
+        const size_t slot = m_trackLogs.acquire(target.target_id, currentTime, &m_evictedTrackIds);
+        if (slot == TrackLogStore::NO_SLOT) continue;
+        TrackLogData& trackLog = m_trackLogs.meta(slot);
+        trackLog.imported = false;
+        if (isNew) {
             if (!m_activeTrackIds.contains(target.target_id)) {
                 m_activeTrackIds.append(target.target_id);
             }
         }
         
-        TrackLogData& trackLog = m_trackLogs[target.target_id];
-        trackLog.lastSeen = currentTime;
-        
-        // Check if we've moved to a new second
-        if (currentSecond != trackLog.currentSecond && trackLog.currentSecond > 0) {
-            // Process the completed second interval
-            processSecondIntervalData(target.target_id, trackLog.currentSecond);
-            trackLog.currentSecond = currentSecond;
+        // The track's first point in a new second closes the previous one
+        if (trackLog.currentInterval.pointCount > 0 &&
+            trackLog.currentInterval.intervalStart != currentSecond) {
+            closeSecondInterval(target.target_id, trackLog);
         }
-        
-        // Initialize current second interval if needed
-        if (!trackLog.secondIntervals.contains(currentSecond)) {
-            SecondIntervalData newInterval;
-            newInterval.intervalStart = currentSecond;
-            trackLog.secondIntervals[currentSecond] = newInterval;
+        if (trackLog.currentInterval.pointCount == 0) {
+            trackLog.currentInterval.intervalStart = currentSecond;
         }
         
-        // Add data point to both raw data and current second interval
-        trackLog.dataPoints.append(dataPoint);
-        trackLog.secondIntervals[currentSecond].points.append(dataPoint);
+        // Live range rate: O(1) update of the track's sliding least-squares fit
+        if (trackLog.rangeRate.window() != m_algorithmWindow ||
+            trackLog.rangeRate.smoothing() != m_smoothingWindow) {
+            trackLog.rangeRate.configure(m_algorithmWindow, m_smoothingWindow);
+        }
+        dataPoint.computed_range_rate = trackLog.rangeRate.update(currentTime, dataPoint.range,
+                                                                  dataPoint.radial_speed);
         
-        // Limit data points per track
-        if (trackLog.dataPoints.size() > MAX_DATA_POINTS_PER_TRACK) {
-            trackLog.dataPoints.removeFirst();
+        // Add data point to the history ring (a full ring's oldest point moves
+        // to the spilled segments) and the current second's aggregate
+        if (m_trackLogs.history(slot).size() == m_trackLogs.historyLength()) {
+            spillOldestPoint(slot);
         }
+        m_trackLogs.push(slot, dataPoint);
+        trackLog.currentInterval.add(dataPoint.range, dataPoint.radial_speed);
         
         m_totalDataPoints++;
     }
+    
+    // Drop tracks that stopped reporting so memory stays bounded under churn.
+    // Imported tracks carry their recording's timestamps, not pipeline
+    // ones, so they are only recycled when the store runs out of slots.
+    m_trackLogs.evictOlderThan(currentTime - TRACK_EVICT_AGE_MS, &m_evictedTrackIds,
+                               [this](size_t slot) { return m_trackLogs.meta(slot).imported; });
+    removeEvictedTracks();
+}
+
+void LoggingWidget::removeEvictedTracks()
+{
+    for (uint32_t trackId : m_evictedTrackIds) {
+        m_activeTrackIds.removeAll(trackId);
+        m_coldLogs.dropTrack(trackId);
+        m_spilledHistoryCache.remove(trackId);
+    }
+    m_evictedTrackIds.clear();
+}
+
+void LoggingWidget::spillOldestPoint(size_t slot)
+{
+    const LoggedTrackDataPoint& point = m_trackLogs.history(slot).front();
+    m_coldLogs.append(point.target_id, point.timestamp, point.range, point.radial_speed,
+                      point.azimuth, point.azimuth_speed, point.level, point.computed_range_rate);
+}
+
+void LoggingWidget::readTrackHistory(uint32_t trackId, TrackLogColumns& out)
+{
+    // Spilled segments (paged in from the spill file) come before the ring
+    out.trackId = trackId;
+    if (!m_coldLogs.read(trackId, out)) {
+        qWarning() << "Could not read spilled history of track" << trackId << ":" << m_coldLogs.errorString();
+    }
+    appendRingHistory(trackId, out);
+}
+
+void LoggingWidget::appendRingHistory(uint32_t trackId, TrackLogColumns& out) const
+{
+    const size_t slot = m_trackLogs.find(trackId);
+    if (slot == TrackLogStore::NO_SLOT) return;
+    for (const LoggedTrackDataPoint& point : m_trackLogs.history(slot)) {
+        out.timestamp.push_back(point.timestamp);
+        out.range.push_back(point.range);
+        out.radialSpeed.push_back(point.radial_speed);
+        out.azimuth.push_back(point.azimuth);
+        out.azimuthSpeed.push_back(point.azimuth_speed);
+        out.level.push_back(point.level);
+        out.rangeRate.push_back(point.computed_range_rate);
+    }
+}
+
+const TrackLogColumns& LoggingWidget::cachedSpilledHistory(uint32_t trackId)
+{
+    // Only segments spilled since the last call are paged in
+    SpilledHistory& spilled = m_spilledHistoryCache[trackId];
+    spilled.columns.trackId = trackId;
+    if (m_coldLogs.readSpilled(trackId, spilled.segments, spilled.columns)) {
+        spilled.segments = m_coldLogs.spilledSegments(trackId);
+    } else {
+        qWarning() << "Could not read spilled history of track" << trackId << ":" << m_coldLogs.errorString();
+    }
+    return spilled.columns;
 }
 
 void LoggingWidget::onStartLogging()
@@ -1231,11 +1312,10 @@ void LoggingWidget::onStopLogging()
 {
     m_isLogging = false;
     
-    // Process any remaining incomplete second intervals
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    for (auto it = m_trackLogs.begin(); it != m_trackLogs.end(); ++it) {
-        if (it->currentSecond > 0) {
-            processSecondIntervalData(it.key(), it->currentSecond);
+    // Close any remaining incomplete second intervals
+    for (size_t slot = 0; slot < m_trackLogs.maxTracks(); ++slot) {
+        if (m_trackLogs.isActive(slot)) {
+            closeSecondInterval(m_trackLogs.trackId(slot), m_trackLogs.meta(slot));
         }
     }
     
@@ -1266,13 +1346,9 @@ void LoggingWidget::onClearLogs()
     
     if (reply == QMessageBox::Yes) {
         // Clear all track logs including second intervals
-        for (auto it = m_trackLogs.begin(); it != m_trackLogs.end(); ++it) {
-            it->secondIntervals.clear();
-            it->dataPoints.clear();
-            it->currentSecond = 0;
-        }
-        
         m_trackLogs.clear();
+        m_coldLogs.clear();
+        m_spilledHistoryCache.clear();
         m_activeTrackIds.clear();
         m_totalDataPoints = 0;
         
@@ -1294,120 +1370,221 @@ void LoggingWidget::onClearLogs()
 void LoggingWidget::onExportLogs()
 {
     QString filename = QFileDialog::getSaveFileName(
-        this, "Export Logs", "", "CSV Files (*.csv);;All Files (*)");
+        this, "Export Logs", "", "CSV Files (*.csv);;Compact Track Log (*.tlg);;All Files (*)");
     
     if (!filename.isEmpty()) {
-        exportToCSV(filename);
-        QMessageBox::information(this, "Export Complete", 
-                                 QString("Logs exported to %1").arg(filename));
+        exportLogs(filename);
     }
 }
 
 void LoggingWidget::onImportLogs()
 {
     QString filename = QFileDialog::getOpenFileName(
-        this, "Import Logs", "", "CSV Files (*.csv);;All Files (*)");
+        this, "Import Logs", "", "Track Logs (*.csv *.tlg);;All Files (*)");
     
     if (!filename.isEmpty()) {
         importFromCSV(filename);
-        QMessageBox::information(this, "Import Complete", 
-                                 QString("Logs imported from %1").arg(filename));
-        onRefreshTrackList();
-        onUpdatePlots();
     }
 }
 
-void LoggingWidget::exportToCSV(const QString& filename)
+void LoggingWidget::exportLogs(const QString& filename)
 {
-    QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QMessageBox::warning(this, "Export Error", "Could not open file for writing.");
+    if (m_exporter.isRunning()) {
+        QMessageBox::warning(this, "Export Error", "An export is already in progress.");
         return;
     }
     
-    QTextStream out(&file);
-    
-    // Write header
-    out << "Timestamp,Track_ID,Range_m,Speed_m_s,Azimuth_deg,Azimuth_Speed_deg_s,Level_dB,Range_Rate_m_s\n";
-    
-    // Write data for all tracks
-    for (auto it = m_trackLogs.begin(); it != m_trackLogs.end(); ++it) {
-        const TrackLogData& trackLog = it.value();
-        for (const LoggedTrackDataPoint& point : trackLog.dataPoints) {
-            out << point.timestamp << ","
-                << point.target_id << ","
-                << point.range << ","
-                << point.radial_speed << ","
-                << point.azimuth << ","
-                << point.azimuth_speed << ","
-                << point.level << ","
-                << point.computed_range_rate << "\n";
+    // Rows are copied out here; formatting and writing run on the exporter's
+    // thread while logging carries on
+    QString error;
+    if (!m_exporter.start(filename, TrackLogExporter::formatFor(filename), snapshotTrackHistory(), &error)) {
+        QMessageBox::warning(this, "Export Error", "Could not open file for writing.\n" + error);
+        return;
+    }
+    m_exportFilename = filename;
+    m_exportButton->setEnabled(false);
+    
+    m_exportProgress = new QProgressDialog(QString("Exporting %1...").arg(QFileInfo(filename).fileName()),
+                                           "Cancel", 0, 1000, this);
+    m_exportProgress->setWindowTitle("Export Logs");
+    m_exportProgress->setMinimumDuration(300);
+    m_exportProgress->setAutoClose(false);
+    m_exportProgress->setAutoReset(false);
+    connect(m_exportProgress, &QProgressDialog::canceled, this, [this]() {
+        m_exporter.cancel();
+    });
+    m_exportTimer->start();
+}
+
+void LoggingWidget::onExportProgress()
+{
+    if (!m_exporter.isFinished()) {
+        if (m_exportProgress) {
+            m_exportProgress->setValue(static_cast<int>(m_exporter.progress() * 1000.0));
         }
+        return;
+    }
+    
+    m_exportTimer->stop();
+    if (m_exportProgress) {
+        m_exportProgress->deleteLater();
+        m_exportProgress = nullptr;
     }
+    m_exportButton->setEnabled(true);
     
-    file.close();
+    TrackLogExporter::Result result = m_exporter.takeResult();
+    if (result.cancelled) {
+        m_statusLabel->setText("Status: Export cancelled");
+        return;
+    }
+    if (!result.error.empty()) {
+        QMessageBox::warning(this, "Export Error", QString::fromStdString(result.error));
+        return;
+    }
     
     // Store the directory where the file was saved
-    QFileInfo fileInfo(filename);
-    m_lastExportDirectory = fileInfo.absolutePath();
+    m_lastExportDirectory = QFileInfo(m_exportFilename).absolutePath();
+    QMessageBox::information(this, "Export Complete",
+                             QString("Logs exported to %1\n%2 data points")
+                                 .arg(m_exportFilename)
+                                 .arg(result.rows));
+}
+
+std::vector<TrackLogColumns> LoggingWidget::snapshotTrackHistory()
+{
+    // All tracks, including their spilled history, grouped by track
+    std::vector<TrackLogColumns> tracks;
+    for (size_t slot = 0; slot < m_trackLogs.maxTracks(); ++slot) {
+        if (!m_trackLogs.isActive(slot)) continue;
+        tracks.emplace_back();
+        readTrackHistory(m_trackLogs.trackId(slot), tracks.back());
+    }
+    return tracks;
 }
 
 void LoggingWidget::importFromCSV(const QString& filename)
 {
-    QFile file(filename);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::warning(this, "Import Error", "Could not open file for reading.");
+    if (m_importer.isRunning()) {
+        QMessageBox::warning(this, "Import Error", "An import is already in progress.");
         return;
     }
     
-    QTextStream in(&file);
+    QString error;
+    if (!m_importer.start(filename, &error)) {
+        QMessageBox::warning(this, "Import Error", "Could not open file for reading.\n" + error);
+        return;
+    }
+    m_importFilename = filename;
+    m_importButton->setEnabled(false);
+    
+    // Parsing runs on the importer's threads; the dialog only shows progress
+    m_importProgress = new QProgressDialog(QString("Importing %1...").arg(QFileInfo(filename).fileName()),
+                                           "Cancel", 0, 1000, this);
+    m_importProgress->setWindowTitle("Import Logs");
+    m_importProgress->setMinimumDuration(300);
+    m_importProgress->setAutoClose(false);
+    m_importProgress->setAutoReset(false);
+    connect(m_importProgress, &QProgressDialog::canceled, this, [this]() {
+        m_importer.cancel();
+    });
+    m_importTimer->start();
+}
+
+void LoggingWidget::onImportProgress()
+{
+    if (!m_importer.isFinished()) {
+        if (m_importProgress) {
+            m_importProgress->setValue(static_cast<int>(m_importer.progress() * 1000.0));
+        }
+        return;
+    }
     
-    // Skip header
-    QString header = in.readLine();
+    m_importTimer->stop();
+    if (m_importProgress) {
+        m_importProgress->deleteLater();
+        m_importProgress = nullptr;
+    }
+    m_importButton->setEnabled(true);
     
+    TrackLogImporter::Result result = m_importer.takeResult();
+    if (result.cancelled) {
+        m_statusLabel->setText("Status: Import cancelled");
+        return;
+    }
+    
+    applyImportedLogs(result);
+    onRefreshTrackList();
+    onUpdatePlots();
+    
+    QString message = QString("Logs imported from %1\n%2 data points in %3 tracks")
+                          .arg(m_importFilename)
+                          .arg(result.rows)
+                          .arg(result.tracks.size());
+    if (result.skippedLines > 0) {
+        message += QString("\n%1 malformed lines skipped").arg(result.skippedLines);
+    }
+    if (!result.error.empty()) {
+        message += "\n" + QString::fromStdString(result.error);
+    }
+    QMessageBox::information(this, "Import Complete", message);
+}
+
+void LoggingWidget::applyImportedLogs(TrackLogImporter::Result& result)
+{
     // Clear existing data
     m_trackLogs.clear();
+    m_coldLogs.clear();
+    m_spilledHistoryCache.clear();
     m_activeTrackIds.clear();
-    m_totalDataPoints = 0;
+    m_evictedTrackIds.clear();
+    m_totalDataPoints = static_cast<int>(result.rows);
+    
+    for (const TrackLogColumns& track : result.tracks) {
+        m_activeTrackIds.append(track.trackId);
+    }
     
-    // Read data
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        QStringList fields = line.split(',');
+    // Fill the store oldest-last-seen first, so if there are more tracks
+    // than slots the most recently seen ones are kept
+    std::vector<const TrackLogColumns*> byLastSeen;
+    byLastSeen.reserve(result.tracks.size());
+    for (const TrackLogColumns& track : result.tracks) {
+        if (track.size() > 0) byLastSeen.push_back(&track);
+    }
+    std::stable_sort(byLastSeen.begin(), byLastSeen.end(),
+                     [](const TrackLogColumns* a, const TrackLogColumns* b) {
+                         return a->timestamp.back() < b->timestamp.back();
+                     });
+    
+    for (const TrackLogColumns* track : byLastSeen) {
+        // acquire() widens first/last seen to cover each timestamp
+        const size_t slot = m_trackLogs.acquire(track->trackId, track->timestamp.front(), &m_evictedTrackIds);
+        if (slot == TrackLogStore::NO_SLOT) break;
+        m_trackLogs.acquire(track->trackId, track->timestamp.back());
+        m_trackLogs.meta(slot).imported = true;
         
-        if (fields.size() >= 8) {
+        // Only the newest points fit in the track's history ring; older
+        // ones go straight to the spilled segments
+        const size_t count = track->size();
+        const size_t capacity = static_cast<size_t>(MAX_DATA_POINTS_PER_TRACK);
+        const size_t first = count > capacity ? count - capacity : 0;
+        for (size_t i = 0; i < first; ++i) {
+            m_coldLogs.append(track->trackId, track->timestamp[i], track->range[i], track->radialSpeed[i],
+                              track->azimuth[i], track->azimuthSpeed[i], track->level[i], track->rangeRate[i]);
+        }
+        for (size_t i = first; i < count; ++i) {
             LoggedTrackDataPoint point;
-            point.timestamp = fields[0].toLongLong();
-            point.target_id = fields[1].toUInt();
-            point.range = fields[2].toFloat();
-            point.radial_speed = fields[3].toFloat();
-            point.azimuth = fields[4].toFloat();
-            point.azimuth_speed = fields[5].toFloat();
-            point.level = fields[6].toFloat();
-            point.computed_range_rate = fields[7].toFloat();
-            
-            if (!m_trackLogs.contains(point.target_id)) {
-                TrackLogData newTrack;
-                newTrack.track_id = point.target_id;
-                newTrack.firstSeen = point.timestamp;
-                newTrack.lastSeen = point.timestamp;
-                m_trackLogs[point.target_id] = newTrack;
-                
-                if (!m_activeTrackIds.contains(point.target_id)) {
-                    m_activeTrackIds.append(point.target_id);
-                }
-            }
-            
-            TrackLogData& trackLog = m_trackLogs[point.target_id];
-            trackLog.lastSeen = qMax(trackLog.lastSeen, point.timestamp);
-            trackLog.firstSeen = qMin(trackLog.firstSeen, point.timestamp);
-            trackLog.dataPoints.append(point);
-            
-            m_totalDataPoints++;
+            point.timestamp = track->timestamp[i];
+            point.target_id = track->trackId;
+            point.range = track->range[i];
+            point.radial_speed = track->radialSpeed[i];
+            point.azimuth = track->azimuth[i];
+            point.azimuth_speed = track->azimuthSpeed[i];
+            point.level = track->level[i];
+            point.computed_range_rate = track->rangeRate[i];
+            m_trackLogs.push(slot, point);
         }
     }
-    
-    file.close();
+    removeEvictedTracks();
 }
 
 void LoggingWidget::onTrackFilterChanged(int index)
@@ -1440,24 +1617,15 @@ void LoggingWidget::onComputeRangeRate()
         m_algorithmOutputText->append("Using 1-second interval aggregation for high-frequency data...");
     }
     
-    // Re-process all second intervals to compute range rates
+    // Second intervals got their range rate when they closed; only the
+    // per-point rates depend on the window settings
     int totalIntervals = 0;
-    for (auto it = m_trackLogs.begin(); it != m_trackLogs.end(); ++it) {
-        uint32_t trackId = it.key();
-        TrackLogData& trackLog = it.value();
-        
-        // Get sorted list of second timestamps
-        QList<qint64> secondTimestamps = trackLog.secondIntervals.keys();
-        std::sort(secondTimestamps.begin(), secondTimestamps.end());
-        
-        // Process each second interval
-        for (qint64 secondTimestamp : secondTimestamps) {
-            processSecondIntervalData(trackId, secondTimestamp);
-            totalIntervals++;
-        }
+    for (size_t slot = 0; slot < m_trackLogs.maxTracks(); ++slot) {
+        if (!m_trackLogs.isActive(slot)) continue;
+        totalIntervals += m_trackLogs.meta(slot).closedIntervals;
         
         // Also compute using traditional method
-        computeRangeRateForTrack(trackId);
+        computeRangeRateForTrack(m_trackLogs.trackId(slot));
     }
     
     if (m_algorithmOutputText) {
@@ -1472,116 +1640,97 @@ void LoggingWidget::onComputeRangeRate()
 
 void LoggingWidget::computeRangeRateForTrack(uint32_t trackId)
 {
-    if (!m_trackLogs.contains(trackId)) return;
+    const size_t slot = m_trackLogs.find(trackId);
+    if (slot == TrackLogStore::NO_SLOT) return;
+    
+    // The whole history is re-estimated: spilled points first, then the ring.
+    // The spilled part's new rates are written back to the spill file.
+    TrackHistoryView<LoggedTrackDataPoint> ring = m_trackLogs.history(slot);
+    TrackLogColumns cold;
+    if (!m_coldLogs.read(trackId, cold)) {
+        qWarning() << "Could not read spilled history of track" << trackId << ":" << m_coldLogs.errorString()
+                   << "- range rate recomputed for in-memory points only";
+        cold = TrackLogColumns();
+    }
+    const size_t coldCount = cold.size();
+    if (coldCount + ring.size() == 0) return;
+    
+    // The same streaming estimator the live path uses, replayed oldest first,
+    // so recomputing with unchanged settings reproduces the live rates
+    RangeRateEstimator estimator(m_algorithmWindow, m_smoothingWindow);
+    for (size_t i = 0; i < coldCount; ++i) {
+        cold.rangeRate[i] = estimator.update(cold.timestamp[i], cold.range[i], cold.radialSpeed[i]);
+    }
+    for (LoggedTrackDataPoint& point : ring) {
+        point.computed_range_rate = estimator.update(point.timestamp, point.range, point.radial_speed);
+    }
     
-    TrackLogData& trackLog = m_trackLogs[trackId];
-    QVector<LoggedTrackDataPoint>& points = trackLog.dataPoints;
+    // New live points continue from the recomputed state
+    m_trackLogs.meta(slot).rangeRate = estimator;
     
-    for (int i = 0; i < points.size(); ++i) {
-        float rangeRate = computeRangeRateAtIndex(points, i, m_algorithmWindow, m_smoothingWindow);
-        points[i].computed_range_rate = rangeRate;
+    if (coldCount > 0) {
+        if (!m_coldLogs.writeRangeRates(trackId, cold.rangeRate.data(), cold.size())) {
+            qWarning() << "Could not update spilled range rates of track" << trackId << ":" << m_coldLogs.errorString();
+        }
+        m_spilledHistoryCache.remove(trackId);
     }
 }
 
-float LoggingWidget::computeRangeRateAtIndex(const QVector<LoggedTrackDataPoint>& points, 
-                                               int index, int window, int smoothing)
+void LoggingWidget::closeSecondInterval(uint32_t trackId, TrackLogData& trackLog)
 {
-    if (points.isEmpty() || index < 0 || index >= points.size()) return 0.0f;
-    
-    // Simple range rate computation using finite difference
-    int startIdx = qMax(0, index - window / 2);
-    int endIdx = qMin(points.size() - 1, index + window / 2);
+    SecondIntervalData& currentInterval = trackLog.currentInterval;
+    if (currentInterval.pointCount == 0) return;
     
-    if (startIdx >= endIdx) return points[index].radial_speed;
-    
-    // Calculate average range rate over window
-    float sumRangeRate = 0.0f;
-    int count = 0;
-    
-    for (int i = startIdx; i <= endIdx; ++i) {
-        if (i > 0 && i < points.size()) {
-            float dt = (points[i].timestamp - points[i-1].timestamp) / 1000.0f;  // Convert to seconds
-            if (dt > 0.001f) {
-                float dr = points[i].range - points[i-1].range;
-                float rate = dr / dt;
-                sumRangeRate += rate;
-                count++;
-            }
-        }
+    // Calculate average values for this interval
+    currentInterval.avgRange = currentInterval.sumRange / currentInterval.pointCount;
+    currentInterval.avgSpeed = currentInterval.sumSpeed / currentInterval.pointCount;
+    
+    // Range rate from the previous second, if the track reported in it
+    const SecondIntervalData& previousInterval = trackLog.previousInterval;
+    if (previousInterval.pointCount > 0 &&
+        previousInterval.intervalStart == currentInterval.intervalStart - 1000) {
+        currentInterval.computedRangeRate = computeRangeRateFromInterval(currentInterval, previousInterval);
+    } else {
+        // No previous interval, use the average speed from current interval
+        currentInterval.computedRangeRate = currentInterval.avgSpeed;
     }
     
-    float avgRangeRate = (count > 0) ? (sumRangeRate / count) : points[index].radial_speed;
-    
-    // Apply smoothing
-    if (smoothing > 1 && index >= smoothing) {
-        float smoothedRate = 0.0f;
-        for (int i = 0; i < smoothing && (index - i) >= 0; ++i) {
-            smoothedRate += avgRangeRate;
-        }
-        avgRangeRate = smoothedRate / smoothing;
+    // The history ring keeps its per-point sliding least-squares rate
+    if (m_algorithmOutputText && currentInterval.pointCount > 1) {
+        m_algorithmOutputText->append(
+            QString("Track %1: Second %2 - Collected %3 points, Avg Range: %4 m (%5 - %6 m, %7 -> %8 m), "
+                    "Computed Range Rate: %9 m/s")
+            .arg(trackId)
+            .arg(QDateTime::fromMSecsSinceEpoch(currentInterval.intervalStart).toString("hh:mm:ss"))
+            .arg(currentInterval.pointCount)
+            .arg(currentInterval.avgRange, 0, 'f', 2)
+            .arg(currentInterval.minRange, 0, 'f', 2)
+            .arg(currentInterval.maxRange, 0, 'f', 2)
+            .arg(currentInterval.firstRange, 0, 'f', 2)
+            .arg(currentInterval.lastRange, 0, 'f', 2)
+            .arg(currentInterval.computedRangeRate, 0, 'f', 2)
+        );
     }
     
-    return avgRangeRate;
+    trackLog.previousInterval = currentInterval;
+    trackLog.currentInterval = SecondIntervalData();
+    trackLog.closedIntervals++;
 }
 
-void LoggingWidget::processSecondIntervalData(uint32_t trackId, qint64 secondTimestamp)
+void LoggingWidget::closeStaleSecondIntervals(qint64 currentSecond)
 {
-    if (!m_trackLogs.contains(trackId)) return;
-    
-    TrackLogData& trackLog = m_trackLogs[trackId];
-    
-    if (!trackLog.secondIntervals.contains(secondTimestamp)) return;
-    
-    SecondIntervalData& currentInterval = trackLog.secondIntervals[secondTimestamp];
+    // Once per second of the clock, close the seconds of tracks that stopped
+    // reporting; otherwise their last second would stay open until they
+    // report again or logging stops
+    if (currentSecond == m_staleIntervalSecond) return;
+    m_staleIntervalSecond = currentSecond;
     
-    // Calculate average values for this interval
-    if (!currentInterval.points.isEmpty()) {
-        float sumRange = 0.0f;
-        float sumSpeed = 0.0f;
-        
-        for (const LoggedTrackDataPoint& point : currentInterval.points) {
-            sumRange += point.range;
-            sumSpeed += point.radial_speed;
-        }
-        
-        currentInterval.avgRange = sumRange / currentInterval.points.size();
-        currentInterval.avgSpeed = sumSpeed / currentInterval.points.size();
-        
-        // Find previous second interval to compute range rate
-        qint64 previousSecond = secondTimestamp - 1000;
-        
-        if (trackLog.secondIntervals.contains(previousSecond)) {
-            const SecondIntervalData& previousInterval = trackLog.secondIntervals[previousSecond];
-            currentInterval.computedRangeRate = computeRangeRateFromInterval(currentInterval, previousInterval);
-        } else {
-            // No previous interval, use the average speed from current interval
-            currentInterval.computedRangeRate = currentInterval.avgSpeed;
-        }
-        
-        // Update all data points in this interval with the computed range rate
-        for (LoggedTrackDataPoint& point : currentInterval.points) {
-            point.computed_range_rate = currentInterval.computedRangeRate;
-        }
-        
-        // Also update the main dataPoints list
-        for (int i = trackLog.dataPoints.size() - 1; i >= 0; --i) {
-            qint64 pointSecond = (trackLog.dataPoints[i].timestamp / 1000) * 1000;
-            if (pointSecond == secondTimestamp) {
-                trackLog.dataPoints[i].computed_range_rate = currentInterval.computedRangeRate;
-            } else if (pointSecond < secondTimestamp) {
-                break;  // No need to check older points
-            }
-        }
-        
-        if (m_algorithmOutputText && currentInterval.points.size() > 1) {
-            m_algorithmOutputText->append(
-                QString("Track %1: Second %2 - Collected %3 points, Avg Range: %4 m, Computed Range Rate: %5 m/s")
-                .arg(trackId)
-                .arg(QDateTime::fromMSecsSinceEpoch(secondTimestamp).toString("hh:mm:ss"))
-                .arg(currentInterval.points.size())
-                .arg(currentInterval.avgRange, 0, 'f', 2)
-                .arg(currentInterval.computedRangeRate, 0, 'f', 2)
-            );
+    for (size_t slot = 0; slot < m_trackLogs.maxTracks(); ++slot) {
+        if (!m_trackLogs.isActive(slot)) continue;
+        TrackLogData& trackLog = m_trackLogs.meta(slot);
+        if (trackLog.currentInterval.pointCount > 0 &&
+            trackLog.currentInterval.intervalStart < currentSecond) {
+            closeSecondInterval(m_trackLogs.trackId(slot), trackLog);
         }
     }
 }
@@ -1647,18 +1796,41 @@ void LoggingWidget::updatePlotsForSelectedTrack()
     QMap<uint32_t, QVector<QPair<qint64, float>>> speedData;
     QMap<uint32_t, QVector<QPair<float, float>>> rvData;
     
+    // Spilled segments come from the cache; only the in-RAM segment and the
+    // ring are copied on every refresh
+    TrackLogColumns recent;
     for (uint32_t trackId : selectedTracks) {
-        if (m_trackLogs.contains(trackId)) {
-            const TrackLogData& trackLog = m_trackLogs[trackId];
-            
-            for (const LoggedTrackDataPoint& point : trackLog.dataPoints) {
-                rangeData[trackId].append(qMakePair(point.timestamp, point.range));
-                speedData[trackId].append(qMakePair(point.timestamp, point.radial_speed));
-                rvData[trackId].append(qMakePair(point.radial_speed, point.range));
+        if (!m_trackLogs.contains(trackId)) continue;
+        const TrackLogColumns& spilled = cachedSpilledHistory(trackId);
+        recent = TrackLogColumns();
+        m_coldLogs.readHot(trackId, recent);
+        appendRingHistory(trackId, recent);
+        
+        QVector<QPair<qint64, float>>& range = rangeData[trackId];
+        QVector<QPair<qint64, float>>& speed = speedData[trackId];
+        QVector<QPair<float, float>>& rv = rvData[trackId];
+        const int total = static_cast<int>(spilled.size() + recent.size());
+        range.reserve(total);
+        speed.reserve(total);
+        rv.reserve(total);
+        for (const TrackLogColumns* part : {&spilled, &recent}) {
+            for (size_t i = 0; i < part->size(); ++i) {
+                range.append(qMakePair(part->timestamp[i], part->range[i]));
+                speed.append(qMakePair(part->timestamp[i], part->radialSpeed[i]));
+                rv.append(qMakePair(part->radialSpeed[i], part->range[i]));
             }
         }
     }
     
+    // Forget tracks that are no longer plotted
+    for (auto it = m_spilledHistoryCache.begin(); it != m_spilledHistoryCache.end();) {
+        if (rangeData.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_spilledHistoryCache.erase(it);
+        }
+    }
+    
     // Update plots
     if (m_rangeTimePlot) {
         m_rangeTimePlot->setMultiTrackData(rangeData);
@@ -1681,11 +1853,14 @@ void LoggingWidget::updateDataTable()
     
     m_dataTable->setRowCount(0);
     
+    // The table lists the in-memory history only; spilled points would make
+    // it unusably long and are still plotted and exported
     for (uint32_t trackId : selectedTracks) {
-        if (m_trackLogs.contains(trackId)) {
-            const TrackLogData& trackLog = m_trackLogs[trackId];
+        const size_t slot = m_trackLogs.find(trackId);
+        if (slot != TrackLogStore::NO_SLOT) {
+            const qint64 firstSeen = m_trackLogs.firstSeen(slot);
             
-            for (const LoggedTrackDataPoint& point : trackLog.dataPoints) {
+            for (const LoggedTrackDataPoint& point : m_trackLogs.history(slot)) {
                 int row = m_dataTable->rowCount();
                 m_dataTable->insertRow(row);
                 
@@ -1698,7 +1873,7 @@ void LoggingWidget::updateDataTable()
                 m_dataTable->setItem(row, 5, new QTableWidgetItem(QString::number(point.level, 'f', 2)));
                 m_dataTable->setItem(row, 6, new QTableWidgetItem(QString::number(point.computed_range_rate, 'f', 2)));
                 
-                qint64 duration = (point.timestamp - trackLog.firstSeen) / 1000;
+                qint64 duration = (point.timestamp - firstSeen) / 1000;
                 m_dataTable->setItem(row, 7, new QTableWidgetItem(QString::number(duration)));
             }
         }
@@ -1729,6 +1904,11 @@ QVector<uint32_t> LoggingWidget::getSelectedTrackIds() const
 
 void LoggingWidget::onRefreshPlotsTimer()
 {
+    // Also closes the last seconds when no frames arrive at all
+    if (m_isLogging) {
+        closeStaleSecondIntervals((m_currentTime / 1000) * 1000);
+    }
+    
     if (m_autoUpdatePlotsCheckBox && m_autoUpdatePlotsCheckBox->isChecked()) {
         updatePlotsForSelectedTrack();
     }
@@ -1812,8 +1992,11 @@ void LoggingWidget::clearLogs()
 int LoggingWidget::getTotalSecondIntervals() const
 {
     int total = 0;
-    for (auto it = m_trackLogs.begin(); it != m_trackLogs.end(); ++it) {
-        total += it.value().secondIntervals.size();
+    for (size_t slot = 0; slot < m_trackLogs.maxTracks(); ++slot) {
+        if (m_trackLogs.isActive(slot)) {
+            const TrackLogData& trackLog = m_trackLogs.meta(slot);
+            total += trackLog.closedIntervals + (trackLog.currentInterval.pointCount > 0 ? 1 : 0);
+        }
     }
     return total;
 }
@@ -4,6 +4,7 @@
 #include <QWidget>
 #include <QVector>
 #include <QMap>
+#include <QHash>
 #include <QDateTime>
 #include <QPainter>
 #include <QTimer>
@@ -23,6 +24,14 @@
 #include <QWheelEvent>
 #include <QToolTip>
 #include "DataStructures.h"
+#include "TrackStateStore.h"
+#include "RangeRateEstimator.h"
+#include "TrackLogExporter.h"
+#include "TrackLogImporter.h"
+#include "TrackLogSegments.h"
+
+class QDialog;
+class QProgressDialog;
 
 // Structure to hold logged track data point
 struct LoggedTrackDataPoint {
@@ -40,32 +49,57 @@ struct LoggedTrackDataPoint {
           azimuth(0), radial_speed(0), azimuth_speed(0), computed_range_rate(0) {}
 };
 
-// Structure to accumulate data within a 1-second interval
+// Running aggregate of a track's points within a 1-second interval. Points
+// are folded in as they arrive; the averages and range rate are filled in
+// when the second closes. The points themselves live in the track's history.
 struct SecondIntervalData {
     qint64 intervalStart;   // Start of the 1-second interval (truncated to second)
-    QVector<LoggedTrackDataPoint> points;  // All points collected in this second
+    int pointCount;         // Points collected in this second
+    float sumRange;
+    float sumSpeed;
+    float minRange;
+    float maxRange;
+    float firstRange;
+    float lastRange;
     float computedRangeRate;  // Range rate computed from this interval
     float avgRange;           // Average range in this interval
     float avgSpeed;           // Average speed in this interval
     
     SecondIntervalData() 
-        : intervalStart(0), computedRangeRate(0), avgRange(0), avgSpeed(0) {}
+        : intervalStart(0), pointCount(0), sumRange(0), sumSpeed(0),
+          minRange(0), maxRange(0), firstRange(0), lastRange(0),
+          computedRangeRate(0), avgRange(0), avgSpeed(0) {}
+    
+    void add(float range, float speed)
+    {
+        if (pointCount == 0) {
+            minRange = maxRange = firstRange = range;
+        } else {
+            minRange = qMin(minRange, range);
+            maxRange = qMax(maxRange, range);
+        }
+        lastRange = range;
+        sumRange += range;
+        sumSpeed += speed;
+        pointCount++;
+    }
 };
 
-// Structure to hold logged data per track
+// Per-track bookkeeping kept next to the track's history ring.
+// Identity, first/last seen and the raw data points live in the TrackStateStore.
 struct TrackLogData {
-    uint32_t track_id;
-    QVector<LoggedTrackDataPoint> dataPoints;
-    qint64 firstSeen;
-    qint64 lastSeen;
-    
-    // Per-second interval tracking for range rate computation
-    QMap<qint64, SecondIntervalData> secondIntervals;  // Maps second timestamp to interval data
-    qint64 currentSecond;  // Current second being accumulated
-    
-    TrackLogData() : track_id(0), firstSeen(0), lastSeen(0), currentSecond(0) {}
+    // Per-second range rate: the second being accumulated and the last one closed
+    SecondIntervalData currentInterval;
+    SecondIntervalData previousInterval;
+    int closedIntervals;           // Seconds closed so far
+    RangeRateEstimator rangeRate;  // Live sliding-window least-squares range rate
+    bool imported;                 // Loaded from a file and not seen live since
+    
+    TrackLogData() : closedIntervals(0), imported(false) {}
 };
 
+using TrackLogStore = TrackStateStore<LoggedTrackDataPoint, TrackLogData>;
+
 // Plot widget base class for logging plots
 class LoggingPlotWidget : public QWidget
 {
@@ -231,8 +265,11 @@ public:
     explicit LoggingWidget(QWidget *parent = nullptr);
     ~LoggingWidget();
     
-    // Update methods
-    void updateFromTargets(const TargetTrackData& targets);
+    // Update methods. `currentTime` is the pipeline time of the report: the
+    // receive time live, the recorded time during a replay
+    void updateFromTargets(const TargetTrackData& targets, qint64 currentTime);
+    // Advance the logging clock without new reports
+    void setCurrentTime(qint64 currentTime) { m_currentTime = currentTime; }
     void setDarkTheme(bool isDark);
     bool isDarkTheme() const { return m_isDarkTheme; }
     
@@ -271,6 +308,8 @@ public slots:
 
 private slots:
     void onRefreshPlotsTimer();
+    void onImportProgress();
+    void onExportProgress();
 
 private:
     void setupUI();
@@ -283,17 +322,23 @@ private:
     void applyTheme();
     
     // Logging functions
-    void logTrackData(const TargetTrackData& targets);
+    void logTrackData(const TargetTrackData& targets, qint64 currentTime);
     
     // Data processing
     void computeRangeRateForTrack(uint32_t trackId);
-    float computeRangeRateAtIndex(const QVector<LoggedTrackDataPoint>& points, 
-                                    int index, int window, int smoothing);
     
     // Per-second range rate computation
-    void processSecondIntervalData(uint32_t trackId, qint64 secondTimestamp);
+    void closeSecondInterval(uint32_t trackId, TrackLogData& trackLog);
+    void closeStaleSecondIntervals(qint64 currentSecond);
     float computeRangeRateFromInterval(const SecondIntervalData& currentInterval, 
                                         const SecondIntervalData& previousInterval);
+    void removeEvictedTracks();
+    
+    // History beyond the rings
+    void spillOldestPoint(size_t slot);
+    void readTrackHistory(uint32_t trackId, TrackLogColumns& out);
+    void appendRingHistory(uint32_t trackId, TrackLogColumns& out) const;
+    const TrackLogColumns& cachedSpilledHistory(uint32_t trackId);
     
     // Visualization helpers
     void updatePlotsForSelectedTrack();
@@ -302,8 +347,10 @@ private:
     int getTotalSecondIntervals() const;
     
     // Export/Import helpers
-    void exportToCSV(const QString& filename);
-    void importFromCSV(const QString& filename);
+    void exportLogs(const QString& filename);       // Starts a background CSV or .tlg export
+    std::vector<TrackLogColumns> snapshotTrackHistory();
+    void importFromCSV(const QString& filename);    // Starts a background import
+    void applyImportedLogs(TrackLogImporter::Result& result);
     
     // UI Components
     QLabel* m_statusLabel;
@@ -341,20 +388,45 @@ private:
     QTableWidget* m_dataTable;
     
     // Data storage
-    QMap<uint32_t, TrackLogData> m_trackLogs;  // Maps track ID to log data
+    TrackLogStore m_trackLogs;                 // Fixed-capacity per-track history rings
+    TrackLogSegments m_coldLogs;               // Points older than the rings, spilled to disk
+    
+    // Spilled history of the plotted tracks, so a plot refresh decodes only
+    // the segments spilled since the last one. Dropped with the track, when
+    // it is no longer plotted or when its spilled range rates are rewritten
+    struct SpilledHistory {
+        size_t segments = 0;                   // Spilled segments decoded into `columns`
+        TrackLogColumns columns;
+    };
+    QHash<uint32_t, SpilledHistory> m_spilledHistoryCache;
     QVector<uint32_t> m_activeTrackIds;        // List of active track IDs
+    std::vector<uint32_t> m_evictedTrackIds;   // Scratch: ids dropped by the store this frame
     
     // State
     bool m_isLogging;
     bool m_isDarkTheme;
     qint64 m_loggingStartTime;
     int m_totalDataPoints;
+    qint64 m_currentTime;           // Pipeline time of the last report or clock tick
+    qint64 m_staleIntervalSecond;   // Second at which stale intervals were last closed
     bool m_isDetached;
     QDialog* m_detachedWindow;
     
     // Timers
     QTimer* m_plotRefreshTimer;
     
+    // Background CSV import, polled by m_importTimer
+    TrackLogImporter m_importer;
+    QTimer* m_importTimer;
+    QProgressDialog* m_importProgress;
+    QString m_importFilename;
+    
+    // Background CSV/.tlg export, polled by m_exportTimer
+    TrackLogExporter m_exporter;
+    QTimer* m_exportTimer;
+    QProgressDialog* m_exportProgress;
+    QString m_exportFilename;
+    
     // Settings
     int m_algorithmWindow;      // Number of detections to associate (window)
     int m_smoothingWindow;      // Number of previous cycles for smoothing
@@ -362,8 +434,12 @@ private:
     // Last export directory
     QString m_lastExportDirectory;
     
-    // Maximum data points per track
+    // Store capacity: up to MAX_LOGGED_TRACKS rings, each growing to
+    // MAX_DATA_POINTS_PER_TRACK points; live tracks unseen for
+    // TRACK_EVICT_AGE_MS are dropped (imported tracks are kept)
+    static constexpr int MAX_LOGGED_TRACKS = 128;
     static constexpr int MAX_DATA_POINTS_PER_TRACK = 50000;
+    static constexpr qint64 TRACK_EVICT_AGE_MS = 60000;
     
 public:
     // Get last export directory
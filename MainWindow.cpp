@@ -1,5 +1,6 @@
 #include "MainWindow.h"
 #include "SpeedMeasurementWidget.h"
+#include "dialogs.h"
 #include <QApplication>
 #include <QGuiApplication>
 #include <QNetworkDatagram>
@@ -31,16 +32,24 @@
 #include <QMenuBar>
 #include <QMenu>
 #include <QAction>
+#include <QActionGroup>
 #include <QFileDialog>
-#include <QTextStream>
 #include <QFileInfo>
 #include <QScreen>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QDesktopServices>
 #include <QUrl>
+#include <QSignalBlocker>
+#include <QElapsedTimer>
+#include <QInputDialog>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QFormLayout>
+#include <QDateTimeEdit>
 #include <cmath>
 #include <cstring>
+#include <limits>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -48,6 +57,9 @@ MainWindow::MainWindow(QWidget *parent)
     , m_fftWidget(nullptr)
     , m_speedMeasurementWidget(nullptr)
     , m_timeSeriesPlotsWidget(nullptr)
+    , m_microDopplerWidget(nullptr)
+    , m_phaseTrackingWidget(nullptr)
+    , m_loggingWidget(nullptr)
     , m_mainTabWidget(nullptr)
     , m_trackTable(nullptr)
     , m_loggingControlGroup(nullptr)
@@ -56,12 +68,19 @@ MainWindow::MainWindow(QWidget *parent)
     , m_stopLoggingButton(nullptr)
     , m_openLoggingDetailsButton(nullptr)
     , m_udpSocket(nullptr)
+    , m_detectionHandler(nullptr)
     , m_updateTimer(nullptr)
     , m_trackRefreshTimer(nullptr)
     , m_dataTimeoutTimer(nullptr)
     , m_saveSettingsButton(nullptr)
     , m_loadFromFileButton(nullptr)
     , m_saveToFileButton(nullptr)
+    , m_frameDeadlineTimer(nullptr)
+    , m_replayTimer(nullptr)
+    , m_dspSettingsDialog(nullptr)
+    , m_selectionDirty(true)
+    , m_lastShortFrameWarning(0)
+    , m_shortFramesSinceWarning(0)
     , m_simulationEnabled(false)  // Simulation disabled by default
     , m_randomEngine(std::random_device{}())
     , m_rangeDist(100.0f, 500.0f)
@@ -71,13 +90,10 @@ MainWindow::MainWindow(QWidget *parent)
     , m_numTargetsDist(3, 8)
     , m_frameCount(0)
     , m_targetCount(0)
-    , m_trackDataFile(nullptr)
     , m_isLogging(false)
     , m_dsp{}  // Zero-initialize the DSP settings struct
     , m_isDarkTheme(false)
     , m_colorTheme("none")
-    , m_expectedNumTargets(0)
-    , m_receivedTargetCount(0)
 {
     // Initialize DSP settings with default values matching UI defaults
     m_dsp.range_mvg_avg_length = 1;
@@ -110,12 +126,9 @@ MainWindow::~MainWindow()
         m_trackRefreshTimer->stop();
     }
     
-    // Close track data file if open
-    if (m_trackDataFile) {
-        m_trackDataFile->close();
-        delete m_trackDataFile;
-        m_trackDataFile = nullptr;
-    }
+    // Write out and close the track recording if one is open
+    m_trackRecorder.stop();
+    m_rawCapture.stop();
 }
 
 void MainWindow::setupUI()
@@ -522,6 +535,7 @@ void MainWindow::setupUI()
     fftLayout->setContentsMargins(4, 12, 4, 4);  // Reduced margins
     m_fftWidget = new FFTWidget();
     m_fftWidget->setRadarParameters(100000.0f, 0.001f, 50000000.0f, 24000000000.0f);
+    m_rangeProcessor.setRadarParameters(100000.0f, 0.001f, 50000000.0f);
     m_fftWidget->setMaxRange(50.0f);
     // Use responsive minimum size based on screen DPI and size
     int fftMinWidth = static_cast<int>(250 * dpiScale);
@@ -817,7 +831,7 @@ void MainWindow::setupUI()
     // Connect logging control signals
     connect(m_startLoggingButton, &QPushButton::clicked, this, &MainWindow::onStartLoggingClicked);
     connect(m_stopLoggingButton, &QPushButton::clicked, this, &MainWindow::onStopLoggingClicked);
-    connect(m_openLoggingDetailsButton, &QPushButton::clicked, this, &MainWindow::onOpenLoggingWindow);
+    connect(m_openLoggingDetailsButton, &QPushButton::clicked, this, &MainWindow::onOpenLogFolder);
 
     // Connect DSP settings signals
     connect(m_rangeAvgEdit,        &QLineEdit::editingFinished, this, &MainWindow::onRangeAvgEdited);
@@ -897,10 +911,31 @@ void MainWindow::setupUI()
     connect(m_timeSeriesPlotsWidget, &TimeSeriesPlotsWidget::trackFiltersChanged,
             this, &MainWindow::refreshTrackTable);
     
+    // Create Micro-Doppler tab (tracks are selected by clicking them on the PPI)
+    QWidget* microDopplerTab = new QWidget();
+    QVBoxLayout* microDopplerLayout = new QVBoxLayout(microDopplerTab);
+    microDopplerLayout->setContentsMargins(0, 0, 0, 0);
+    m_microDopplerWidget = new MicroDopplerWidget(microDopplerTab);
+    m_microDopplerWidget->setRadarParameters(0.001f, 24000000000.0f);
+    microDopplerLayout->addWidget(m_microDopplerWidget);
+    m_mainTabWidget->addTab(microDopplerTab, "Micro-Doppler");
+
+    connect(m_ppiWidget, &PPIWidget::trackClicked,
+            m_microDopplerWidget, &MicroDopplerWidget::toggleTrack);
+
+    // Create Phase Tracking tab (vibration / vital signs at a fixed range)
+    m_phaseTrackingWidget = new PhaseTrackingWidget(this);
+    m_phaseTrackingWidget->setCenterFrequency(24000000000.0f);
+    m_mainTabWidget->addTab(m_phaseTrackingWidget, "Phase Tracking");
+
     // Create Speed Measurement tab
     m_speedMeasurementWidget = new SpeedMeasurementWidget(this);
     m_mainTabWidget->addTab(m_speedMeasurementWidget, "Speed Measurement");
     
+    // Create Logging tab (per-track history, range-rate analysis, CSV/.tlg export)
+    m_loggingWidget = new LoggingWidget(this);
+    m_mainTabWidget->addTab(m_loggingWidget, "Logging");
+    
     // Add the tab widget to the main layout with stretch
     mainLayout->addWidget(m_mainTabWidget, 1);
 
@@ -929,6 +964,23 @@ void MainWindow::setupNetworking()
         connect(m_udpSocket, &QUdpSocket::readyRead, this, &MainWindow::readPendingDatagrams);
         m_statusLabel->setText("Status: UDP Listening (Binary & Text)");
     }
+
+    // Raw detection stream: bound on demand from the Connection menu
+    m_detectionHandler = new UdpHandler(this);
+    connect(m_detectionHandler, &UdpHandler::tracksUpdated, this, &MainWindow::onDetectionTracksUpdated);
+    connect(m_detectionHandler, &UdpHandler::errorOccurred, this, [](const QString& error) {
+        qWarning() << "Raw detection stream:" << error;
+    });
+}
+
+void MainWindow::onDetectionTracksUpdated()
+{
+    // Clusters are only current while clustering is on
+    std::vector<DetectionClusterer::Cluster> clusters;
+    if (m_detectionHandler->isClusteringEnabled()) {
+        clusters = m_detectionHandler->getLastClusters();
+    }
+    m_ppiWidget->updateDetectionOverlay(m_detectionHandler->getConfirmedTracks(), clusters);
 }
 
 void MainWindow::setupTimer()
@@ -947,6 +999,18 @@ void MainWindow::setupTimer()
     m_dataTimeoutTimer->setSingleShot(true);  // One-shot timer
     connect(m_dataTimeoutTimer, &QTimer::timeout,
             this, &MainWindow::onDataTimeout);
+    
+    // Frame deadline timer - publishes a partial target frame when packets are lost
+    m_frameDeadlineTimer = new QTimer(this);
+    m_frameDeadlineTimer->setSingleShot(true);
+    connect(m_frameDeadlineTimer, &QTimer::timeout,
+            this, &MainWindow::onFrameDeadline);
+    
+    // Replay timer - paces recorded sessions through the pipeline
+    m_replayTimer = new QTimer(this);
+    m_replayTimer->setSingleShot(true);
+    connect(m_replayTimer, &QTimer::timeout,
+            this, &MainWindow::onReplayTimer);
 }
 
 void MainWindow::updateDisplay()
@@ -960,14 +1024,31 @@ void MainWindow::updateDisplay()
             m_speedMeasurementWidget->updateFromTargets(m_currentTargets);
         }
         if (m_timeSeriesPlotsWidget) {
-            m_timeSeriesPlotsWidget->updateFromTargets(m_currentTargets);
+            m_timeSeriesPlotsWidget->updateFromTargets(m_currentTargets, pipelineTime());
+        }
+        if (m_loggingWidget) {
+            m_loggingWidget->updateFromTargets(m_currentTargets, pipelineTime());
+        }
+    }
+
+    // Predict coasting tracks forward and drop expired ones between frames
+    if (!m_simulationEnabled) {
+        m_trackLifecycle.advance(pipelineTime());
+        publishTrackLifecycle();
+
+        // Keep the plots' time axes and the logging clock running between reports
+        if (m_timeSeriesPlotsWidget) {
+            m_timeSeriesPlotsWidget->setCurrentTime(pipelineTime());
+        }
+        if (m_loggingWidget) {
+            m_loggingWidget->setCurrentTime(pipelineTime());
         }
     }
 
     // CRITICAL FIX: Display update only refreshes UI, not data processing
     // Range rate and filter processing now happens immediately in UDP reception
     // Apply track filters so only matching tracks appear on PPI and Track Table
-    TargetTrackData filteredTargets = getFilteredTargets();
+    const TargetTrackData& filteredTargets = updateTargetSelection();
     m_ppiWidget->updateTargets(filteredTargets);
     m_fftWidget->updateData(m_currentADCFrame);
     m_fftWidget->updateTargets(filteredTargets);
@@ -990,46 +1071,56 @@ void MainWindow::readPendingDatagrams()
         datagram.resize(m_udpSocket->pendingDatagramSize());
         m_udpSocket->readDatagram(datagram.data(), datagram.size());
 
-        //qDebug() << "========================================";
-        //qDebug() << "Received datagram of size:" << datagram.size() << "bytes";
-
-        // Check if it's a binary packet (minimum 4 bytes for message_type)
-        if (datagram.size() >= 4) {
-            // Peek at first 4 bytes to check message type
-            const uint32_t* msg_type_ptr = reinterpret_cast<const uint32_t*>(datagram.constData());
-            uint32_t msg_type = *msg_type_ptr;
-
-            if (msg_type == 0x01) {
-                // Binary raw ADC data packet
-                //qDebug() << "Detected binary RAW DATA packet (0x01)";
-                parseBinaryRawData(datagram);
-                continue;
-            } else if (msg_type == 0x02) {
-                // Binary target data packet
-                qDebug() << "Detected binary TARGET DATA packet (0x02)";
-                parseBinaryTargetData(datagram);
-                continue;
-            }
+        // A replay owns the pipeline; drain live data without processing it
+        if (m_replay.isOpen()) {
+            continue;
         }
 
-        // Try text-based parsing
-        QString msg = QString::fromUtf8(datagram);
-        if (msg.contains("NumTargets:")) {
-            parseTrackMessage(msg);
-        }
-        if (msg.contains("ADC:")) {
-            parseADCMessage(msg);
+        processDatagram(datagram, QDateTime::currentMSecsSinceEpoch());
+    }
+}
+
+void MainWindow::processDatagram(const QByteArray& datagram, qint64 receiveTime)
+{
+    //qDebug() << "========================================";
+    //qDebug() << "Received datagram of size:" << datagram.size() << "bytes";
+
+    // Check if it's a binary packet (minimum 4 bytes for message_type)
+    if (datagram.size() >= 4) {
+        // Peek at first 4 bytes to check message type
+        const uint32_t* msg_type_ptr = reinterpret_cast<const uint32_t*>(datagram.constData());
+        uint32_t msg_type = *msg_type_ptr;
+
+        if (msg_type == 0x01) {
+            // Binary raw ADC data packet
+            //qDebug() << "Detected binary RAW DATA packet (0x01)";
+            parseBinaryRawData(datagram, receiveTime);
+            return;
+        } else if (msg_type == 0x02) {
+            // Binary target data packet
+            qDebug() << "Detected binary TARGET DATA packet (0x02)";
+            parseBinaryTargetData(datagram, receiveTime);
+            return;
         }
     }
+
+    // Try text-based parsing
+    QString msg = QString::fromUtf8(datagram);
+    if (msg.contains("NumTargets:")) {
+        parseTrackMessage(msg, receiveTime);
+    }
+    if (msg.contains("ADC:")) {
+        parseADCMessage(msg);
+    }
 }
 
 //==============================================================================
 // BINARY UDP PARSING - NEW CODE
 //==============================================================================
-void MainWindow::parseBinaryRawData(const QByteArray& datagram)
+void MainWindow::parseBinaryRawData(const QByteArray& datagram, qint64 receiveTime)
 {
-    // Reset data timeout timer - we received data
-    if (m_dataTimeoutTimer) {
+    // Reset data timeout timer - we received data (a replay has no timeout)
+    if (m_dataTimeoutTimer && !m_replay.isOpen()) {
         m_dataTimeoutTimer->start(DATA_TIMEOUT_MS);
     }
     
@@ -1071,11 +1162,16 @@ void MainWindow::parseBinaryRawData(const QByteArray& datagram)
         return;
     }
 
+    // Hand the whole datagram to the capture thread before processing
+    if (!m_replay.isOpen()) {
+        m_rawCapture.capture(datagram, receiveTime);
+    }
+
     const float* sample_data = reinterpret_cast<const float*>(
         datagram.constData() + sizeof(RawDataHeader_t)
     );
 
-    processRawDataFrame(header, sample_data, total_samples);
+    processRawDataFrame(header, sample_data, total_samples, receiveTime);
 
     if (m_simulationEnabled) {
         m_simulationEnabled = false;
@@ -1088,7 +1184,8 @@ void MainWindow::parseBinaryRawData(const QByteArray& datagram)
 
 void MainWindow::processRawDataFrame(const RawDataHeader_t* header,
                                      const float* sample_data,
-                                     uint32_t total_samples)
+                                     uint32_t total_samples,
+                                     qint64 receiveTime)
 {
     m_currentADCFrame.complex_data.clear();
 
@@ -1100,6 +1197,7 @@ void MainWindow::processRawDataFrame(const RawDataHeader_t* header,
         uint32_t num_complex_samples = samples_per_chirp / 2;
         m_currentADCFrame.complex_data.reserve(num_complex_samples);
         m_currentADCFrame.num_samples_per_chirp = num_complex_samples;
+        m_currentADCFrame.data_format = Rx_Data_Format_t::COMPLEX_FLOAT;
 
         for (uint32_t i = 0; i < num_complex_samples && (i * 2 + 1) < total_samples; ++i) {
             ComplexSample sample;
@@ -1108,9 +1206,10 @@ void MainWindow::processRawDataFrame(const RawDataHeader_t* header,
             m_currentADCFrame.complex_data.push_back(sample);
         }
     } else {
-        // Real-only data
+        // Real-only data (FFTWidget switches to the real-input FFT for these frames)
         m_currentADCFrame.complex_data.reserve(samples_per_chirp);
         m_currentADCFrame.num_samples_per_chirp = samples_per_chirp;
+        m_currentADCFrame.data_format = Rx_Data_Format_t::REAL_FLOAT;
 
         for (uint32_t i = 0; i < samples_per_chirp && i < total_samples; ++i) {
             ComplexSample sample;
@@ -1122,6 +1221,27 @@ void MainWindow::processRawDataFrame(const RawDataHeader_t* header,
 
     m_currentADCFrame.computeMagnitudes();
 
+    // Batched range FFT over all chirps and RX antennas (display path above only uses chirp 0)
+    if (!m_rangeProcessor.process(*header, sample_data, total_samples,
+                                  receiveTime, m_rangeCube)) {
+        // A misconfigured sender produces this for every frame; don't flood the log
+        ++m_shortFramesSinceWarning;
+        if (receiveTime < m_lastShortFrameWarning || receiveTime - m_lastShortFrameWarning >= 1000) {
+            qWarning() << "Raw frame" << header->frame_number << "too short for"
+                       << header->num_chirps << "chirps x" << header->num_rx_antennas << "RX"
+                       << "(" << m_shortFramesSinceWarning << "short frames in the last second)";
+            m_lastShortFrameWarning = receiveTime;
+            m_shortFramesSinceWarning = 0;
+        }
+    } else {
+        if (m_microDopplerWidget) {
+            m_microDopplerWidget->processFrame(m_rangeCube, m_currentTargets);
+        }
+        if (m_phaseTrackingWidget) {
+            m_phaseTrackingWidget->processFrame(m_rangeCube);
+        }
+    }
+
     //qDebug() << "Processed" << m_currentADCFrame.complex_data.size() << "complex samples";
     if (!m_currentADCFrame.complex_data.empty()) {
 //        qDebug() << "First sample: I=" << m_currentADCFrame.complex_data[0].I
@@ -1130,10 +1250,10 @@ void MainWindow::processRawDataFrame(const RawDataHeader_t* header,
     }
 }
 
-void MainWindow::parseBinaryTargetData(const QByteArray& datagram)
+void MainWindow::parseBinaryTargetData(const QByteArray& datagram, qint64 receiveTime)
 {
-    // Reset data timeout timer - we received data
-    if (m_dataTimeoutTimer) {
+    // Reset data timeout timer - we received data (a replay has no timeout)
+    if (m_dataTimeoutTimer && !m_replay.isOpen()) {
         m_dataTimeoutTimer->start(DATA_TIMEOUT_MS);
     }
     
@@ -1164,28 +1284,6 @@ void MainWindow::parseBinaryTargetData(const QByteArray& datagram)
 
     qDebug() << "Radial Speed:   " << packet->radial_speed << "m/s";
 
-    // EPHEMERAL SYNCHRONIZATION: Frame-based track collection
-    // Tracks are only shown when present in the current frame
-    
-    // Check if this is the start of a new frame (num_targets changed or we've received all expected)
-    if (packet->num_targets != m_expectedNumTargets || m_receivedTargetCount >= m_expectedNumTargets) {
-        // New frame starting - clear the frame buffer
-        m_frameTargets.clear();
-        m_expectedNumTargets = packet->num_targets;
-        m_receivedTargetCount = 0;
-        qDebug() << "Starting new frame - expecting" << m_expectedNumTargets << "targets";
-    }
-
-    // Handle special case: num_targets is 0 (no targets in this frame)
-    if (packet->num_targets == 0) {
-        // Clear all targets - no tracks in this frame
-        m_currentTargets.targets.clear();
-        m_currentTargets.numTracks = 0;
-        qDebug() << "No targets in frame - clearing all tracks";
-        m_statusLabel->setText("Binary Target Data - 0 targets (frame empty)");
-        return;
-    }
-
     // Create target from packet data
     TargetTrack new_target;
     new_target.target_id = packet->target_id;
@@ -1196,65 +1294,53 @@ void MainWindow::parseBinaryTargetData(const QByteArray& datagram)
     new_target.radial_speed = packet->radial_speed;
     new_target.azimuth_speed = packet->azimuth_speed;
     new_target.elevation_speed = packet->elevation_speed;
-    new_target.lastUpdateTime = QDateTime::currentMSecsSinceEpoch();
+    new_target.lastUpdateTime = receiveTime;
     
-    // Log track data to file
-    logTrackDataToFile(new_target);
-
-    // Add to frame buffer (check for duplicates in current frame)
-    bool found = false;
-    for (auto& target : m_frameTargets) {
-        if (target.target_id == packet->target_id) {
-            // Update existing target in frame buffer
-            target = new_target;
-            found = true;
-            qDebug() << "Updated target ID:" << packet->target_id << "in frame buffer";
-            break;
-        }
+    // Log track data to file (a num_targets == 0 packet only announces an empty frame)
+    if (packet->num_targets > 0) {
+        logTrackDataToFile(new_target);
     }
-
-    if (!found) {
-        m_frameTargets.push_back(new_target);
-        m_receivedTargetCount++;
-        qDebug() << "Added target ID:" << packet->target_id << "to frame buffer (" 
-                 << m_receivedTargetCount << "/" << m_expectedNumTargets << ")";
-    }
-
-    // Check if we've received all targets for this frame
-    if (m_receivedTargetCount >= m_expectedNumTargets) {
-        // Apply the frame - replace current targets entirely (ephemeral sync)
-        applyFrameTargets();
-        
-        // CRITICAL FIX: Process data immediately upon UDP reception
-        // Compute range rate and apply filters as soon as frame is complete
-        if (m_timeSeriesPlotsWidget) {
-            m_timeSeriesPlotsWidget->updateFromTargets(m_currentTargets);
-        }
-        if (m_speedMeasurementWidget) {
-            m_speedMeasurementWidget->updateFromTargets(m_currentTargets);
-        }
+    
+    // Group packets into frames by the optional frame id trailer, or by
+    // inferred boundaries when the sender does not append one
+    uint32_t trailerFrameId = 0;
+    const uint32_t* frameId = nullptr;
+    if (datagram.size() >= static_cast<int>(sizeof(TargetDataPacket_t) + sizeof(TargetFrameTrailer_t))) {
+        TargetFrameTrailer_t trailer;
+        memcpy(&trailer, datagram.constData() + sizeof(TargetDataPacket_t), sizeof(trailer));
+        trailerFrameId = trailer.frame_id;
+        frameId = &trailerFrameId;
     }
+    m_frameAssembler.addPacket(new_target, packet->num_targets, frameId, new_target.lastUpdateTime);
+    
+    // Apply any frame this packet completed (or closed) to the track lifecycle
+    applyAssembledFrames();
+    armFrameDeadline();
 
     // Disable simulation when receiving real data
     if (m_simulationEnabled) {
         m_simulationEnabled = false;
     }
 
-    m_statusLabel->setText(QString("Binary Target Data - %1/%2 targets, ID: %3")
-                          .arg(m_receivedTargetCount)
-                          .arg(m_expectedNumTargets)
-                          .arg(packet->target_id));
+    if (packet->num_targets == 0) {
+        m_statusLabel->setText("Binary Target Data - 0 targets (frame empty)");
+    } else {
+        m_statusLabel->setText(QString("Binary Target Data - %1/%2 targets, ID: %3")
+                              .arg(m_frameAssembler.openTargets())
+                              .arg(m_frameAssembler.openExpected())
+                              .arg(packet->target_id));
+    }
 }
 
 //==============================================================================
 // TEXT-BASED PARSING - EXISTING CODE (kept for backward compatibility)
 //==============================================================================
-void MainWindow::parseTrackMessage(const QString& message)
+void MainWindow::parseTrackMessage(const QString& message, qint64 receiveTime)
 {
     qDebug() << "Parsing text track message";
     QStringList tokens = message.split(QRegularExpression("\\s+"), QString::SkipEmptyParts);
-    m_currentTargets.targets.clear();
-    m_currentTargets.numTracks = 0;
+    m_reportedTargets.targets.clear();
+    m_reportedTargets.numTracks = 0;
 
     TargetTrack target;
     int parsedTargets = 0;
@@ -1268,8 +1354,8 @@ void MainWindow::parseTrackMessage(const QString& message)
         } else if (token == "TgtId:" && i + 1 < tokens.size()) {
             if (parsedTargets > 0 && currentTargetValid) {
                 // Set timestamp for the completed target before adding
-                target.lastUpdateTime = QDateTime::currentMSecsSinceEpoch();
-                m_currentTargets.targets.push_back(target);
+                target.lastUpdateTime = receiveTime;
+                m_reportedTargets.targets.push_back(target);
                 // Log the completed target
                 logTrackDataToFile(target);
             }
@@ -1303,21 +1389,26 @@ void MainWindow::parseTrackMessage(const QString& message)
     // Append final target if one exists and is valid (target_id <= 50)
     if (parsedTargets > 0 && currentTargetValid) {
         // Set timestamp for the final target before adding
-        target.lastUpdateTime = QDateTime::currentMSecsSinceEpoch();
-        m_currentTargets.targets.push_back(target);
+        target.lastUpdateTime = receiveTime;
+        m_reportedTargets.targets.push_back(target);
         // Log the final target
         logTrackDataToFile(target);
     }
 
-    m_currentTargets.numTracks = m_currentTargets.targets.size();
+    m_reportedTargets.numTracks = m_reportedTargets.targets.size();
+    m_trackLifecycle.update(m_reportedTargets, receiveTime);
+    publishTrackLifecycle();
     
     // CRITICAL FIX: Process data immediately upon UDP reception
     // Compute range rate and apply filters as soon as text data is parsed
     if (m_timeSeriesPlotsWidget) {
-        m_timeSeriesPlotsWidget->updateFromTargets(m_currentTargets);
+        m_timeSeriesPlotsWidget->updateFromTargets(m_reportedTargets, pipelineTime());
     }
     if (m_speedMeasurementWidget) {
-        m_speedMeasurementWidget->updateFromTargets(m_currentTargets);
+        m_speedMeasurementWidget->updateFromTargets(m_reportedTargets);
+    }
+    if (m_loggingWidget) {
+        m_loggingWidget->updateFromTargets(m_reportedTargets, pipelineTime());
     }
 }
 
@@ -1366,23 +1457,38 @@ void MainWindow::parseADCMessage(const QString& message)
     }
 }
 
-void MainWindow::applyFrameTargets()
+void MainWindow::applyAssembledFrames()
 {
-    // EPHEMERAL SYNCHRONIZATION: Replace current targets with frame targets
-    // This ensures only tracks present in the current frame are displayed
-    // Tracks not in this frame are immediately removed from display
-    
-    m_currentTargets.targets = m_frameTargets;
-    m_currentTargets.numTracks = static_cast<uint32_t>(m_frameTargets.size());
-    
-    qDebug() << "Applied frame targets - now showing" << m_currentTargets.numTracks << "tracks";
+    // Tracks missing from a frame coast on their last report instead of
+    // disappearing; they are dropped once the coast time runs out
+    bool applied = false;
+    while (m_frameAssembler.takeFrame(m_assembledFrame)) {
+        m_reportedTargets.targets.swap(m_assembledFrame.targets);
+        m_reportedTargets.numTracks = static_cast<uint32_t>(m_reportedTargets.targets.size());
+        m_trackLifecycle.update(m_reportedTargets, pipelineTime());
+        publishTrackLifecycle();
+        applied = true;
+        
+        // CRITICAL FIX: Process data immediately upon UDP reception
+        // Compute range rate and apply filters as soon as the frame is published.
+        // Measurement consumers only see real reports, never coasting predictions
+        if (m_timeSeriesPlotsWidget) {
+            m_timeSeriesPlotsWidget->updateFromTargets(m_reportedTargets, pipelineTime());
+        }
+        if (m_speedMeasurementWidget) {
+            m_speedMeasurementWidget->updateFromTargets(m_reportedTargets);
+        }
+        if (m_loggingWidget) {
+            m_loggingWidget->updateFromTargets(m_reportedTargets, pipelineTime());
+        }
+    }
+    if (!applied) return;
     
-    // Clear the frame buffer for the next frame
-    m_frameTargets.clear();
-    m_receivedTargetCount = 0;
+    qDebug() << "Applied frame targets -" << m_reportedTargets.numTracks << "reported,"
+             << m_currentTargets.numTracks << "tracks shown";
     
     // Apply track filters so only matching tracks appear on PPI and Track Table
-    TargetTrackData filteredTargets = getFilteredTargets();
+    const TargetTrackData& filteredTargets = updateTargetSelection();
     
     // Update displays with filtered targets
     m_ppiWidget->updateTargets(filteredTargets);
@@ -1390,44 +1496,255 @@ void MainWindow::applyFrameTargets()
     updateTrackTable();
 }
 
-void MainWindow::refreshTrackTable()
+void MainWindow::armFrameDeadline()
 {
-    // EPHEMERAL SYNCHRONIZATION: Periodic refresh for UI consistency
-    // Tracks are already managed frame-by-frame in parseBinaryTargetData
-    // This function just ensures the UI stays in sync with current data
+    // A replay polls frame deadlines at its own recorded times
+    if (!m_frameDeadlineTimer || m_replay.isOpen()) return;
     
-    // Apply track filters so only matching tracks appear on PPI and Track Table
-    TargetTrackData filteredTargets = getFilteredTargets();
-    
-    // Keep minimum rows in track table, extend if more tracks are available
-    int rowCount = std::max(static_cast<int>(filteredTargets.numTracks), TRACK_TABLE_MINIMUM_ROWS);
-    m_trackTable->setRowCount(rowCount);
-    
-    // Populate rows with filtered track data
-    for (uint32_t i = 0; i < filteredTargets.numTracks; ++i) {
-        const TargetTrack& target = filteredTargets.targets[i];
-        m_trackTable->setItem(i, 0, new QTableWidgetItem(QString::number(target.target_id)));
-        m_trackTable->setItem(i, 1, new QTableWidgetItem(QString::number(target.radius, 'f', 2)));
-        m_trackTable->setItem(i, 2, new QTableWidgetItem(QString::number(target.azimuth, 'f', 1)));
-        m_trackTable->setItem(i, 3, new QTableWidgetItem(QString::number(target.radial_speed, 'f', 1)));
+    const qint64 deadline = m_frameAssembler.deadline();
+    if (deadline < 0) {
+        m_frameDeadlineTimer->stop();
+        return;
+    }
+    const qint64 remaining = deadline - QDateTime::currentMSecsSinceEpoch();
+    m_frameDeadlineTimer->start(static_cast<int>(std::max<qint64>(0, remaining)));
+}
+
+void MainWindow::onFrameDeadline()
+{
+    m_frameAssembler.poll(QDateTime::currentMSecsSinceEpoch());
+    applyAssembledFrames();
+    armFrameDeadline();
+}
+
+qint64 MainWindow::pipelineTime() const
+{
+    return m_replay.isOpen() ? m_replay.sessionTime() : QDateTime::currentMSecsSinceEpoch();
+}
+
+bool MainWindow::openReplay(const QString& path, QString* error)
+{
+    closeReplay();
+    m_replay.setCapturePorts({UDP_PORT});
+    if (!m_replay.open(path, error)) {
+        return false;
     }
     
-    // Clear empty rows (when fewer tracks than minimum)
-    for (uint32_t i = filteredTargets.numTracks; i < static_cast<uint32_t>(rowCount); ++i) {
-        m_trackTable->setItem(i, 0, new QTableWidgetItem(""));
-        m_trackTable->setItem(i, 1, new QTableWidgetItem(""));
-        m_trackTable->setItem(i, 2, new QTableWidgetItem(""));
-        m_trackTable->setItem(i, 3, new QTableWidgetItem(""));
+    // Every replay starts from the same empty pipeline state
+    if (m_dataTimeoutTimer) {
+        m_dataTimeoutTimer->stop();
+    }
+    onDataTimeout();
+    if (m_timeSeriesPlotsWidget) {
+        m_timeSeriesPlotsWidget->clearAllData();
+    }
+    m_simulationEnabled = false;
+    
+    qDebug() << "Replay opened:" << path << "-" << m_replay.eventCount() << "datagrams,"
+             << (m_replay.endTime() - m_replay.startTime()) << "ms";
+    if (m_replay.format() == SessionReplay::Format::PacketCapture) {
+        const PcapReader::Stats& stats = m_replay.captureStats();
+        qDebug() << "Packet capture:" << stats.packets << "packets," << stats.reassembled
+                 << "datagrams reassembled," << stats.truncated << "truncated,"
+                 << stats.fragmentsDropped << "fragments dropped";
+    }
+    m_statusLabel->setText(QString("Status: Replay %1 - %2 datagrams (paused)")
+                          .arg(QFileInfo(path).fileName())
+                          .arg(m_replay.eventCount()));
+    return true;
+}
+
+void MainWindow::closeReplay()
+{
+    if (!m_replay.isOpen()) return;
+    
+    m_replayTimer->stop();
+    m_replay.close();
+    
+    // Back to live data: clear what the replay left behind
+    onDataTimeout();
+    m_statusLabel->setText("Status: Replay closed");
+}
+
+void MainWindow::setReplayMode(SessionReplay::Mode mode, double speed)
+{
+    m_replay.setMode(mode, speed);
+    scheduleReplay();
+}
+
+void MainWindow::playReplay()
+{
+    if (!m_replay.isOpen()) return;
+    
+    m_replay.play(QDateTime::currentMSecsSinceEpoch());
+    scheduleReplay();
+}
+
+void MainWindow::pauseReplay()
+{
+    m_replay.pause();
+    m_replayTimer->stop();
+}
+
+void MainWindow::stepReplay()
+{
+    const SessionReplay::Event* event = m_replay.step();
+    if (!event) return;
+    
+    dispatchReplayEvent(*event);
+    if (m_replay.atEnd()) {
+        finishReplay();
+    }
+}
+
+bool MainWindow::askTrackRecordQuery(const TrackRecordingIndex& index, TrackRecordQuery& query)
+{
+    QDialog dialog(this);
+    dialog.setWindowTitle(tr("Export Track Recording"));
+    QFormLayout* form = new QFormLayout(&dialog);
+    
+    QLineEdit* tracksEdit = new QLineEdit(&dialog);
+    tracksEdit->setPlaceholderText(tr("All %1 tracks").arg(index.trackIds().size()));
+    form->addRow(tr("Track IDs:"), tracksEdit);
+    
+    const QDateTime start = QDateTime::fromMSecsSinceEpoch(index.startTime());
+    const QDateTime end = QDateTime::fromMSecsSinceEpoch(index.endTime());
+    QDateTimeEdit* fromEdit = new QDateTimeEdit(start, &dialog);
+    QDateTimeEdit* toEdit = new QDateTimeEdit(end, &dialog);
+    for (QDateTimeEdit* edit : {fromEdit, toEdit}) {
+        edit->setDisplayFormat("yyyy-MM-dd hh:mm:ss");
+        edit->setDateTimeRange(start, end);
+    }
+    form->addRow(tr("From:"), fromEdit);
+    form->addRow(tr("To:"), toEdit);
+    
+    QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    form->addRow(buttons);
+    if (dialog.exec() != QDialog::Accepted) return false;
+    
+    for (const QString& token : tracksEdit->text().split(QRegularExpression("[,;\\s]+"), QString::SkipEmptyParts)) {
+        bool ok = false;
+        const uint trackId = token.toUInt(&ok);
+        if (ok) {
+            query.trackIds.push_back(trackId);
+        }
+    }
+    
+    // The editors show whole seconds; an untouched edge means no limit
+    const qint64 from = fromEdit->dateTime().toMSecsSinceEpoch();
+    const qint64 to = toEdit->dateTime().toMSecsSinceEpoch();
+    if (from / 1000 > index.startTime() / 1000) {
+        query.from = from / 1000 * 1000;
+    }
+    if (to / 1000 < index.endTime() / 1000) {
+        query.to = to / 1000 * 1000 + 999;
+    }
+    return true;
+}
+
+void MainWindow::seekReplay(qint64 time)
+{
+    if (!m_replay.isOpen()) return;
+    
+    m_replay.seek(time);
+    // Tracks and frames from before the jump no longer apply
+    onDataTimeout();
+    if (m_timeSeriesPlotsWidget) {
+        m_timeSeriesPlotsWidget->clearAllData();
+    }
+    scheduleReplay();
+}
+
+void MainWindow::onReplayTimer()
+{
+    // Hand out due events in slices so the GUI stays responsive even when
+    // replaying as fast as possible
+    QElapsedTimer slice;
+    slice.start();
+    while (const SessionReplay::Event* event = m_replay.next(QDateTime::currentMSecsSinceEpoch())) {
+        dispatchReplayEvent(*event);
+        if (slice.elapsed() >= REPLAY_SLICE_MS) break;
+    }
+    
+    if (m_replay.atEnd()) {
+        finishReplay();
+        return;
+    }
+    scheduleReplay();
+}
+
+void MainWindow::dispatchReplayEvent(const SessionReplay::Event& event)
+{
+    // Frames whose deadline passed before this datagram was received are
+    // published first, exactly as the live deadline timer would have
+    m_frameAssembler.poll(event.time);
+    applyAssembledFrames();
+    
+    processDatagram(QByteArray::fromRawData(event.data, static_cast<int>(event.size)), event.time);
+}
+
+void MainWindow::scheduleReplay()
+{
+    const qint64 wait = m_replay.msUntilNext(QDateTime::currentMSecsSinceEpoch());
+    if (wait < 0) {
+        m_replayTimer->stop();
+    } else {
+        m_replayTimer->start(static_cast<int>(std::min<qint64>(wait, std::numeric_limits<int>::max())));
+    }
+}
+
+void MainWindow::finishReplay()
+{
+    m_replay.pause();
+    m_replayTimer->stop();
+    
+    // Publish the last frame; its remaining packets will never come
+    m_frameAssembler.poll(m_replay.endTime() + m_frameAssembler.config().frameTimeoutMs);
+    applyAssembledFrames();
+    
+    qDebug() << "Replay finished:" << m_replay.eventCount() << "datagrams";
+    m_statusLabel->setText(QString("Status: Replay finished - %1 datagrams")
+                          .arg(m_replay.eventCount()));
+}
+
+void MainWindow::publishTrackLifecycle()
+{
+    // Nothing changed: keep the current selection and table rows
+    const std::vector<TrackLifecycle::Event>& events = m_trackLifecycle.events();
+    if (events.empty()) return;
+    
+    for (const TrackLifecycle::Event& event : events) {
+        m_changedTrackIds.insert(event.trackId, 0);
     }
-    m_trackTable->resizeColumnsToContents();
+    
+    m_currentTargets.targets.assign(m_trackLifecycle.tracks().targets.begin(),
+                                    m_trackLifecycle.tracks().targets.end());
+    m_currentTargets.numTracks = m_trackLifecycle.tracks().numTracks;
+    m_selectionDirty = true;
+}
+
+void MainWindow::setTrackCoastTime(int ms)
+{
+    TrackLifecycle::Config config = m_trackLifecycle.config();
+    config.coastTimeMs = std::max(0, ms);
+    m_trackLifecycle.setConfig(config);
+}
 
+void MainWindow::refreshTrackTable()
+{
+    // Periodic refresh for UI consistency; tracks are already managed
+    // frame-by-frame by the track lifecycle
+    updateTrackTable();
+    
     // Sync PPI and FFT widgets with filtered data
+    const TargetTrackData& filteredTargets = updateTargetSelection();
     m_ppiWidget->updateTargets(filteredTargets);
     m_fftWidget->updateTargets(filteredTargets);
 
     qDebug() << "Track table refreshed. Total tracks:" << m_currentTargets.numTracks
-             << ", Filtered tracks:" << filteredTargets.numTracks
-             << ", Display rows:" << rowCount << "(ephemeral sync mode)";
+             << ", Filtered tracks:" << filteredTargets.numTracks;
 }
 
 void MainWindow::onDataTimeout()
@@ -1436,11 +1753,17 @@ void MainWindow::onDataTimeout()
     qDebug() << "Data timeout - clearing PPI, Track Table, and FFT displays";
     
     // Clear target data
+    m_trackLifecycle.clear();
+    publishTrackLifecycle();
     m_currentTargets.targets.clear();
     m_currentTargets.numTracks = 0;
-    m_frameTargets.clear();
-    m_expectedNumTargets = 0;
-    m_receivedTargetCount = 0;
+    m_reportedTargets.targets.clear();
+    m_reportedTargets.numTracks = 0;
+    m_selectionDirty = true;
+    m_frameAssembler.reset();
+    if (m_frameDeadlineTimer) {
+        m_frameDeadlineTimer->stop();
+    }
     
     // Clear PPI display
     if (m_ppiWidget) {
@@ -1461,6 +1784,7 @@ void MainWindow::onDataTimeout()
             m_trackTable->setItem(i, 3, new QTableWidgetItem(""));
         }
         m_trackTable->resizeColumnsToContents();
+        m_trackTableRowIds.assign(m_trackTableRowIds.size(), EMPTY_TRACK_ROW);
     }
     
     // Update status
@@ -1483,6 +1807,7 @@ void MainWindow::generateSimulatedTargetData()
 {
     uint32_t numTargets = m_numTargetsDist(m_randomEngine);
     m_currentTargets.resize(numTargets);
+    m_selectionDirty = true;
 
     for (uint32_t i = 0; i < numTargets; ++i) {
         TargetTrack& target = m_currentTargets.targets[i];
@@ -1494,6 +1819,7 @@ void MainWindow::generateSimulatedTargetData()
         target.radial_speed = m_speedDist(m_randomEngine);
         target.azimuth_speed = std::uniform_real_distribution<float>(-5.0f, 5.0f)(m_randomEngine);
         target.elevation_speed = std::uniform_real_distribution<float>(-2.0f, 2.0f)(m_randomEngine);
+        m_changedTrackIds.insert(target.target_id, 0);
     }
     m_targetCount += numTargets;
 }
@@ -1507,6 +1833,7 @@ void MainWindow::generateSimulatedADCData()
     uint32_t numComplexSamples = 32;
     m_currentADCFrame.complex_data.resize(numComplexSamples);
     m_currentADCFrame.num_samples_per_chirp = numComplexSamples;
+    m_currentADCFrame.data_format = Rx_Data_Format_t::COMPLEX_FLOAT;
 
     // Generate only noise - no synthetic signals
     std::uniform_real_distribution<float> noiseDist(-0.05f, 0.05f);
@@ -1578,59 +1905,118 @@ void MainWindow::onApplySettings()
     }
 }
 
-TargetTrackData MainWindow::getFilteredTargets() const
+const TargetTrackData& MainWindow::updateTargetSelection()
 {
-    // Apply track filters from TimeSeriesPlotsWidget to produce filtered target set
-    // for PPI display and Track Table
-    if (!m_timeSeriesPlotsWidget) {
-        return m_currentTargets;  // No filter widget, return all targets
+    // Track filters from TimeSeriesPlotsWidget plus the DSP target selection,
+    // evaluated once per frame (or when a filter setting changes)
+    TargetSelector::Config config = m_selectionSettings;
+    if (m_timeSeriesPlotsWidget) {
+        config.minRange = m_timeSeriesPlotsWidget->getFilterMinRange();
+        config.minSpeedKmh = m_timeSeriesPlotsWidget->getFilterMinVelocity();
+        config.showReceding = m_timeSeriesPlotsWidget->getFilterReceding();
+        config.showApproaching = m_timeSeriesPlotsWidget->getFilterApproaching();
     }
     
-    float filterMinRange = m_timeSeriesPlotsWidget->getFilterMinRange();
-    float filterMinVelocity = m_timeSeriesPlotsWidget->getFilterMinVelocity();
-    bool filterReceding = m_timeSeriesPlotsWidget->getFilterReceding();
-    bool filterApproaching = m_timeSeriesPlotsWidget->getFilterApproaching();
+    if (m_selectionDirty || config != m_targetSelector.config()) {
+        m_targetSelector.setConfig(config);
+        m_targetSelector.select(m_currentTargets);
+        m_targetSelector.materialise(m_currentTargets, m_selectedTargets);
+        m_selectionDirty = false;
+    }
+    return m_selectedTargets;
+}
+
+void MainWindow::applyTargetSelectionSettings(const DSP_Settings_Extended_t& settings)
+{
+    TargetSelector::applySelectionSettings(settings, m_selectionSettings);
     
-    TargetTrackData filtered;
-    for (size_t i = 0; i < m_currentTargets.targets.size(); ++i) {
-        const TargetTrack& track = m_currentTargets.targets[i];
-        if (TimeSeriesPlotsWidget::trackPassesFilters(track, filterMinRange,
-                                                       filterMinVelocity,
-                                                       filterReceding,
-                                                       filterApproaching)) {
-            filtered.targets.push_back(track);
-        }
+    const TargetTrackData& filteredTargets = updateTargetSelection();
+    m_ppiWidget->updateTargets(filteredTargets);
+    m_fftWidget->updateTargets(filteredTargets);
+    updateTrackTable();
+}
+
+void MainWindow::onOpenDSPSettingsDialog()
+{
+    if (!m_dspSettingsDialog) {
+        m_dspSettingsDialog = new DSPSettingsDialog(this);
+        // Only the target selection fields act locally; both buttons apply them
+        connect(m_dspSettingsDialog, &DSPSettingsDialog::settingsChanged,
+                this, &MainWindow::onDSPDialogSettingsChanged);
+        connect(m_dspSettingsDialog, &DSPSettingsDialog::sendSettingsRequested,
+                this, &MainWindow::onDSPDialogSettingsChanged);
     }
-    filtered.numTracks = static_cast<uint32_t>(filtered.targets.size());
-    return filtered;
+    m_dspSettingsDialog->setSettings(m_extendedDsp);
+    m_dspSettingsDialog->setDarkTheme(m_isDarkTheme);
+    m_dspSettingsDialog->exec();
+}
+
+void MainWindow::onDSPDialogSettingsChanged(const DSP_Settings_Extended_t& settings)
+{
+    m_extendedDsp = settings;
+    applyTargetSelectionSettings(settings);
+
+    // Persisted so the selection is restored by loadSettings()
+    QSettings store(getSettingsFilePath(), QSettings::IniFormat);
+    store.beginGroup("TargetSelection");
+    store.setValue("mode", settings.target_selection_mode);
+    store.setValue("maxTargets", settings.max_targets);
+    store.setValue("direction", settings.direction_filter);
+    store.endGroup();
+
+    m_statusLabel->setText("Status: Target selection settings applied");
 }
 
 void MainWindow::updateTrackTable()
 {
-    // EPHEMERAL SYNCHRONIZATION: Update track table with filtered frame data
     // Apply track filters so only matching tracks appear on PPI and Track Table
-    TargetTrackData filteredTargets = getFilteredTargets();
-    
-    int rowCount = std::max(static_cast<int>(filteredTargets.numTracks), TRACK_TABLE_MINIMUM_ROWS);
-    m_trackTable->setRowCount(rowCount);
-    
-    // Populate rows with filtered track data
-    for (uint32_t i = 0; i < filteredTargets.numTracks; ++i) {
-        const TargetTrack& target = filteredTargets.targets[i];
-        m_trackTable->setItem(i, 0, new QTableWidgetItem(QString::number(target.target_id)));
-        m_trackTable->setItem(i, 1, new QTableWidgetItem(QString::number(target.radius, 'f', 2)));
-        m_trackTable->setItem(i, 2, new QTableWidgetItem(QString::number(target.azimuth, 'f', 1)));
-        m_trackTable->setItem(i, 3, new QTableWidgetItem(QString::number(target.radial_speed, 'f', 1)));
+    const TargetTrackData& filteredTargets = updateTargetSelection();
+    
+    const int numTracks = static_cast<int>(filteredTargets.numTracks);
+    const int rowCount = std::max(numTracks, TRACK_TABLE_MINIMUM_ROWS);
+    if (m_trackTable->rowCount() != rowCount) {
+        m_trackTable->setRowCount(rowCount);
     }
+    m_trackTableRowIds.resize(rowCount, EMPTY_TRACK_ROW);
+    
+    // Only rewrite rows that now show a different track or whose track
+    // changed since the last update (per the lifecycle's change events)
+    bool rowsChanged = false;
+    for (int row = 0; row < rowCount; ++row) {
+        const TargetTrack* target = (row < numTracks) ? &filteredTargets.targets[row] : nullptr;
+        const uint32_t trackId = target ? target->target_id : EMPTY_TRACK_ROW;
+        if (trackId == m_trackTableRowIds[row] &&
+            (!target || !m_changedTrackIds.contains(trackId))) {
+            continue;
+        }
+        setTrackTableRow(row, target);
+        m_trackTableRowIds[row] = trackId;
+        rowsChanged = true;
+    }
+    m_changedTrackIds.clear();
     
-    // Clear empty rows (when fewer tracks than minimum)
-    for (uint32_t i = filteredTargets.numTracks; i < static_cast<uint32_t>(rowCount); ++i) {
-        m_trackTable->setItem(i, 0, new QTableWidgetItem(""));
-        m_trackTable->setItem(i, 1, new QTableWidgetItem(""));
-        m_trackTable->setItem(i, 2, new QTableWidgetItem(""));
-        m_trackTable->setItem(i, 3, new QTableWidgetItem(""));
+    if (rowsChanged) {
+        m_trackTable->resizeColumnsToContents();
+    }
+}
+
+void MainWindow::setTrackTableRow(int row, const TargetTrack* target)
+{
+    const QString cells[4] = {
+        target ? QString::number(target->target_id) : QString(),
+        target ? QString::number(target->radius, 'f', 2) : QString(),
+        target ? QString::number(target->azimuth, 'f', 1) : QString(),
+        target ? QString::number(target->radial_speed, 'f', 1) : QString()
+    };
+    
+    // Reuse the row's items rather than allocating new ones every refresh
+    for (int col = 0; col < 4; ++col) {
+        if (QTableWidgetItem* item = m_trackTable->item(row, col)) {
+            item->setText(cells[col]);
+        } else {
+            m_trackTable->setItem(row, col, new QTableWidgetItem(cells[col]));
+        }
     }
-    m_trackTable->resizeColumnsToContents();
 }
 
 //==============================================================================
@@ -1917,28 +2303,124 @@ void MainWindow::createMenuBar()
     
     fileMenu->addSeparator();
     
+    QAction* exportRecordingAction = fileMenu->addAction(tr("Export &Track Recording to CSV..."));
+    connect(exportRecordingAction, &QAction::triggered, this, [this]() {
+        QString recordingName = QFileDialog::getOpenFileName(this,
+            tr("Open Track Recording"), "D:/", tr("Track Recordings (*.trk);;All Files (*)"));
+        if (recordingName.isEmpty()) return;
+        
+        QFileInfo recordingInfo(recordingName);
+        QString csvName = QFileDialog::getSaveFileName(this,
+            tr("Export Track Recording"),
+            recordingInfo.path() + "/" + recordingInfo.completeBaseName() + ".csv",
+            tr("CSV Files (*.csv);;All Files (*)"));
+        if (csvName.isEmpty()) return;
+        
+        // The recording's index (rebuilt once if missing) lists its tracks
+        // and time span, and keeps a filtered export to the blocks it needs
+        const std::string recordingPath = QFile::encodeName(recordingName).toStdString();
+        TrackRecordingIndex index;
+        std::string error;
+        if (!index.open(recordingPath, &error)) {
+            QMessageBox::warning(this, tr("Export Error"), QString::fromStdString(error));
+            return;
+        }
+        TrackRecordQuery query;
+        if (!askTrackRecordQuery(index, query)) return;
+        
+        if (TrackRecorder::exportCsv(recordingPath, QFile::encodeName(csvName).toStdString(), &error, query)) {
+            m_statusLabel->setText(QString("Status: Recording exported to %1").arg(QFileInfo(csvName).fileName()));
+        } else {
+            QMessageBox::warning(this, tr("Export Error"), QString::fromStdString(error));
+        }
+    });
+    
+    QAction* rawCaptureAction = fileMenu->addAction(tr("&Capture Raw IQ Frames..."));
+    rawCaptureAction->setCheckable(true);
+    connect(rawCaptureAction, &QAction::toggled, this, [this, rawCaptureAction](bool checked) {
+        if (!checked) {
+            if (m_rawCapture.isCapturing()) {
+                m_rawCapture.stop();
+                qDebug() << "Raw IQ capture stopped:" << m_rawCapture.path()
+                         << "(" << m_rawCapture.framesCaptured() << "frames,"
+                         << m_rawCapture.framesOverwritten() << "overwritten,"
+                         << m_rawCapture.framesDropped() << "dropped)";
+                m_statusLabel->setText(QString("Status: Raw IQ capture saved to %1")
+                                      .arg(QFileInfo(m_rawCapture.path()).fileName()));
+            }
+            return;
+        }
+        
+        QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
+        QString captureName = QFileDialog::getSaveFileName(this,
+            tr("Capture Raw IQ Frames"), QString("D:/raw_iq_%1.iqr").arg(timestamp),
+            tr("Raw IQ Captures (*.iqr);;All Files (*)"));
+        if (captureName.isEmpty() || !m_rawCapture.start(captureName)) {
+            if (!captureName.isEmpty()) {
+                QMessageBox::warning(this, tr("Capture Error"),
+                    QString("Could not create %1:\n%2").arg(captureName, m_rawCapture.errorString()));
+            }
+            QSignalBlocker blocker(rawCaptureAction);
+            rawCaptureAction->setChecked(false);
+            return;
+        }
+        m_statusLabel->setText(QString("Status: Capturing raw IQ to %1")
+                              .arg(QFileInfo(captureName).fileName()));
+    });
+    
     QAction* exportAction = fileMenu->addAction(tr("&Export Data..."));
     exportAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_E));
     connect(exportAction, &QAction::triggered, this, [this]() {
+        if (m_dataExporter.isRunning()) {
+            QMessageBox::warning(this, tr("Export Error"), tr("An export is already in progress."));
+            return;
+        }
         QString fileName = QFileDialog::getSaveFileName(this,
-            tr("Export Data"), "", tr("CSV Files (*.csv);;All Files (*)"));
-        if (!fileName.isEmpty()) {
-            // Export track data to CSV
-            QFile file(fileName);
-            if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-                QTextStream out(&file);
-                out << "ID,Range (m),Azimuth (deg),Radial Speed (m/s)\n";
-                for (uint32_t i = 0; i < m_currentTargets.numTracks; ++i) {
-                    const TargetTrack& target = m_currentTargets.targets[i];
-                    out << target.target_id << "," 
-                        << target.radius << "," 
-                        << target.azimuth << "," 
-                        << target.radial_speed << "\n";
-                }
-                file.close();
+            tr("Export Data"), "", tr("CSV Files (*.csv);;Compact Track Log (*.tlg);;All Files (*)"));
+        if (fileName.isEmpty()) return;
+        
+        // Current tracks, one row each. CSV keeps the established
+        // ID,Range,Azimuth,Radial Speed columns; .tlg carries every field
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        std::vector<TrackLogColumns> tracks;
+        tracks.reserve(m_currentTargets.numTracks);
+        for (uint32_t i = 0; i < m_currentTargets.numTracks && i < m_currentTargets.targets.size(); ++i) {
+            const TargetTrack& target = m_currentTargets.targets[i];
+            TrackLogColumns track;
+            track.trackId = target.target_id;
+            track.timestamp.push_back(target.lastUpdateTime > 0 ? target.lastUpdateTime : now);
+            track.range.push_back(target.radius);
+            track.radialSpeed.push_back(target.radial_speed);
+            track.azimuth.push_back(target.azimuth);
+            track.azimuthSpeed.push_back(target.azimuth_speed);
+            track.level.push_back(target.level);
+            track.rangeRate.push_back(target.radial_speed);   // Measured; no history to fit here
+            tracks.push_back(std::move(track));
+        }
+        
+        QString error;
+        const TrackLogExporter::Format format = TrackLogExporter::formatFor(fileName) == TrackLogExporter::Format::TrackLog
+            ? TrackLogExporter::Format::TrackLog : TrackLogExporter::Format::TargetCsv;
+        if (!m_dataExporter.start(fileName, format, std::move(tracks), &error)) {
+            QMessageBox::warning(this, tr("Export Error"), error);
+            return;
+        }
+        
+        // Written on the exporter's thread; poll for completion
+        QTimer* poll = new QTimer(this);
+        poll->setInterval(50);
+        connect(poll, &QTimer::timeout, this, [this, poll, fileName]() {
+            if (!m_dataExporter.isFinished()) return;
+            poll->stop();
+            poll->deleteLater();
+            TrackLogExporter::Result result = m_dataExporter.takeResult();
+            if (!result.error.empty()) {
+                QMessageBox::warning(this, tr("Export Error"), QString::fromStdString(result.error));
+            } else {
                 m_statusLabel->setText(QString("Status: Data exported to %1").arg(QFileInfo(fileName).fileName()));
             }
-        }
+        });
+        poll->start();
     });
     
     fileMenu->addSeparator();
@@ -1954,6 +2436,9 @@ void MainWindow::createMenuBar()
     loggingAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_L));
     connect(loggingAction, &QAction::triggered, this, &MainWindow::onOpenLoggingWindow);
     
+    QAction* dspSettingsAction = viewMenu->addAction(tr("DSP &Settings..."));
+    connect(dspSettingsAction, &QAction::triggered, this, &MainWindow::onOpenDSPSettingsDialog);
+    
     viewMenu->addSeparator();
     
     QAction* fullScreenAction = viewMenu->addAction(tr("&Full Screen"));
@@ -1969,6 +2454,23 @@ void MainWindow::createMenuBar()
     
     viewMenu->addSeparator();
     
+    QAction* iqCorrectionAction = viewMenu->addAction(tr("FFT &IQ Correction"));
+    iqCorrectionAction->setCheckable(true);
+    iqCorrectionAction->setChecked(true);  // FFTWidget corrects by default; the widget is created after the menus
+    connect(iqCorrectionAction, &QAction::toggled, this, [this](bool checked) {
+        m_fftWidget->setIQCorrectionEnabled(checked);
+        if (checked) {
+            const IQCorrector& iq = m_fftWidget->iqCorrector();
+            m_statusLabel->setText(QString("Status: IQ correction on (DC %1/%2, gain %3 dB, phase %4 deg)")
+                                   .arg(iq.dcOffsetI(), 0, 'g', 3).arg(iq.dcOffsetQ(), 0, 'g', 3)
+                                   .arg(iq.gainImbalanceDb(), 0, 'f', 2).arg(iq.phaseImbalanceDeg(), 0, 'f', 2));
+        } else {
+            m_statusLabel->setText("Status: IQ correction off");
+        }
+    });
+    
+    viewMenu->addSeparator();
+    
     QAction* refreshAction = viewMenu->addAction(tr("&Refresh"));
     refreshAction->setShortcut(QKeySequence::Refresh);
     connect(refreshAction, &QAction::triggered, this, [this]() {
@@ -1977,6 +2479,80 @@ void MainWindow::createMenuBar()
         m_statusLabel->setText("Status: Display refreshed");
     });
     
+    // Replay Menu
+    QMenu* replayMenu = menuBar->addMenu(tr("Re&play"));
+    
+    QAction* openReplayAction = replayMenu->addAction(tr("&Open Session..."));
+    connect(openReplayAction, &QAction::triggered, this, [this]() {
+        QString sessionName = QFileDialog::getOpenFileName(this,
+            tr("Open Recorded Session"), "D:/",
+            tr("Recorded Sessions (*.iqr *.trk *.pcap *.pcapng *.cap);;Raw IQ Captures (*.iqr);;"
+               "Track Recordings (*.trk);;Packet Captures (*.pcap *.pcapng *.cap);;All Files (*)"));
+        if (sessionName.isEmpty()) return;
+        
+        QString error;
+        if (!openReplay(sessionName, &error)) {
+            QMessageBox::warning(this, tr("Replay Error"), error);
+        }
+    });
+    
+    QAction* closeReplayAction = replayMenu->addAction(tr("&Close Session"));
+    connect(closeReplayAction, &QAction::triggered, this, &MainWindow::closeReplay);
+    
+    replayMenu->addSeparator();
+    
+    QAction* playReplayAction = replayMenu->addAction(tr("&Play"));
+    playReplayAction->setShortcut(QKeySequence(Qt::Key_F5));
+    connect(playReplayAction, &QAction::triggered, this, &MainWindow::playReplay);
+    
+    QAction* pauseReplayAction = replayMenu->addAction(tr("P&ause"));
+    pauseReplayAction->setShortcut(QKeySequence(Qt::Key_F6));
+    connect(pauseReplayAction, &QAction::triggered, this, &MainWindow::pauseReplay);
+    
+    QAction* stepReplayAction = replayMenu->addAction(tr("&Step"));
+    stepReplayAction->setShortcut(QKeySequence(Qt::Key_F7));
+    connect(stepReplayAction, &QAction::triggered, this, [this]() {
+        pauseReplay();
+        stepReplay();
+    });
+    
+    QAction* seekReplayAction = replayMenu->addAction(tr("&Go to Time..."));
+    seekReplayAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_G));
+    connect(seekReplayAction, &QAction::triggered, this, [this]() {
+        if (!m_replay.isOpen()) return;
+        const double duration = (m_replay.endTime() - m_replay.startTime()) / 1000.0;
+        bool ok = false;
+        const double seconds = QInputDialog::getDouble(this, tr("Go to Time"),
+            tr("Seconds from the start of the session (0 - %1):").arg(duration, 0, 'f', 1),
+            (m_replay.sessionTime() - m_replay.startTime()) / 1000.0, 0.0, duration, 1, &ok);
+        if (ok) {
+            seekReplay(m_replay.startTime() + static_cast<qint64>(seconds * 1000.0));
+        }
+    });
+    
+    replayMenu->addSeparator();
+    
+    // Playback speed; single-stepping is the Step action above
+    QActionGroup* replaySpeedGroup = new QActionGroup(this);
+    const struct { const char* label; SessionReplay::Mode mode; double speed; } replaySpeeds[] = {
+        { QT_TR_NOOP("Real Time (&1x)"), SessionReplay::Mode::RealTime, 1.0 },
+        { QT_TR_NOOP("&2x"), SessionReplay::Mode::RealTime, 2.0 },
+        { QT_TR_NOOP("&5x"), SessionReplay::Mode::RealTime, 5.0 },
+        { QT_TR_NOOP("1&0x"), SessionReplay::Mode::RealTime, 10.0 },
+        { QT_TR_NOOP("As &Fast as Possible"), SessionReplay::Mode::AsFastAsPossible, 1.0 }
+    };
+    for (const auto& replaySpeed : replaySpeeds) {
+        QAction* speedAction = replayMenu->addAction(tr(replaySpeed.label));
+        speedAction->setCheckable(true);
+        speedAction->setChecked(replaySpeed.mode == m_replay.mode() && replaySpeed.speed == m_replay.speed());
+        replaySpeedGroup->addAction(speedAction);
+        const SessionReplay::Mode mode = replaySpeed.mode;
+        const double speed = replaySpeed.speed;
+        connect(speedAction, &QAction::triggered, this, [this, mode, speed]() {
+            setReplayMode(mode, speed);
+        });
+    }
+    
     // Connection Menu
     QMenu* connectionMenu = menuBar->addMenu(tr("&Connection"));
     
@@ -1995,6 +2571,39 @@ void MainWindow::createMenuBar()
     
     connectionMenu->addSeparator();
     
+    QAction* detectionStreamAction = connectionMenu->addAction(tr("Raw &Detection Stream..."));
+    detectionStreamAction->setCheckable(true);
+    connect(detectionStreamAction, &QAction::triggered, this, [this, detectionStreamAction](bool checked) {
+        if (!checked) {
+            m_detectionHandler->disconnectFromHost();
+            m_ppiWidget->clearDetectionOverlay();
+            m_statusLabel->setText("Status: Raw detection stream closed");
+            return;
+        }
+        bool ok = false;
+        const int port = QInputDialog::getInt(this, "Raw Detection Stream", "UDP port for raw detections:",
+                                              DETECTION_UDP_PORT, 1, 65535, 1, &ok);
+        if (!ok) {
+            detectionStreamAction->setChecked(false);
+            return;
+        }
+        if (port == UDP_PORT || !m_detectionHandler->connectToHost("0.0.0.0", port)) {
+            detectionStreamAction->setChecked(false);
+            m_statusLabel->setText(QString("Status: Cannot listen for raw detections on port %1").arg(port));
+            return;
+        }
+        m_statusLabel->setText(QString("Status: Tracking raw detections on UDP port %1").arg(port));
+    });
+    
+    QAction* clusterDetectionsAction = connectionMenu->addAction(tr("&Cluster Raw Detections"));
+    clusterDetectionsAction->setCheckable(true);
+    clusterDetectionsAction->setChecked(true);  // UdpHandler clusters by default
+    connect(clusterDetectionsAction, &QAction::toggled, this, [this](bool checked) {
+        m_detectionHandler->setClusteringEnabled(checked);
+    });
+    
+    connectionMenu->addSeparator();
+    
     QAction* networkInfoAction = connectionMenu->addAction(tr("&Network Info..."));
     connect(networkInfoAction, &QAction::triggered, this, [this]() {
         QString info = QString("UDP Port: %1\nStatus: %2")
@@ -2814,6 +3423,15 @@ void MainWindow::applyTheme(bool isDark)
     if (m_timeSeriesPlotsWidget) {
         m_timeSeriesPlotsWidget->setDarkTheme(isDark);
     }
+    if (m_microDopplerWidget) {
+        m_microDopplerWidget->setDarkTheme(isDark);
+    }
+    if (m_phaseTrackingWidget) {
+        m_phaseTrackingWidget->setDarkTheme(isDark);
+    }
+    if (m_loggingWidget) {
+        m_loggingWidget->setDarkTheme(isDark);
+    }
     
     // Apply theme to DSP Settings panel
     applyDspSettingsTheme(isDark);
@@ -3818,6 +4436,17 @@ void MainWindow::loadSettings()
     qDebug() << "Applied to displays - Range:" << minRangeMeters << "-" << maxRangeMeters << "m";
     qDebug() << "Angle:" << m_dsp.min_angle_degree << "-" << m_dsp.max_angle_degree << "deg";
 
+    // Target selection saved from the DSP settings dialog
+    settings.beginGroup("TargetSelection");
+    m_extendedDsp.target_selection_mode = static_cast<uint8_t>(
+        settings.value("mode", m_extendedDsp.target_selection_mode).toUInt());
+    m_extendedDsp.max_targets = static_cast<uint8_t>(
+        settings.value("maxTargets", m_extendedDsp.max_targets).toUInt());
+    m_extendedDsp.direction_filter = static_cast<uint8_t>(
+        settings.value("direction", m_extendedDsp.direction_filter).toUInt());
+    settings.endGroup();
+    applyTargetSelectionSettings(m_extendedDsp);
+
     // Load theme preference
     QString theme = settings.value("UI/theme", "light").toString();
     m_isDarkTheme = (theme == "dark");
@@ -3984,6 +4613,13 @@ void MainWindow::onSaveToFile()
 }
 
 void MainWindow::onOpenLoggingWindow()
+{
+    if (m_loggingWidget) {
+        m_mainTabWidget->setCurrentWidget(m_loggingWidget);
+    }
+}
+
+void MainWindow::onOpenLogFolder()
 {
     // Open D:/ drive where log files are saved
     QString logDirectory = "D:/";
@@ -4007,11 +4643,7 @@ void MainWindow::onOpenLoggingWindow()
 void MainWindow::onStartLoggingClicked()
 {
     // Close existing log file if open
-    if (m_trackDataFile) {
-        m_trackDataFile->close();
-        delete m_trackDataFile;
-        m_trackDataFile = nullptr;
-    }
+    m_trackRecorder.stop();
     
     // Create new log file (will be created on first track data write)
     m_currentLogFilename = "";
@@ -4031,12 +4663,12 @@ void MainWindow::onStartLoggingClicked()
 void MainWindow::onStopLoggingClicked()
 {
     // Close and finalize the current log file
-    if (m_trackDataFile) {
-        m_trackDataFile->close();
-        delete m_trackDataFile;
-        m_trackDataFile = nullptr;
+    if (m_trackRecorder.isRecording()) {
+        m_trackRecorder.stop();
         
-        qDebug() << "Logging stopped. Log file saved:" << m_currentLogFilename;
+        qDebug() << "Logging stopped. Log file saved:" << m_currentLogFilename
+                 << "(" << m_trackRecorder.recordsWritten() << "records,"
+                 << m_trackRecorder.recordsDropped() << "dropped)";
     }
     
     // Stop filter logging in TimeSeriesPlotsWidget
@@ -4127,7 +4759,7 @@ QString MainWindow::createTimestampedFilename()
     // Get current system time and format it
     QDateTime currentTime = QDateTime::currentDateTime();
     QString timestamp = currentTime.toString("yyyyMMdd_HHmmss_zzz");
-    QString filename = QString("D:/track_data_%1.csv").arg(timestamp);
+    QString filename = QString("D:/track_data_%1.trk").arg(timestamp);
     return filename;
 }
 
@@ -4138,8 +4770,8 @@ void MainWindow::logTrackDataToFile(const TargetTrack& track)
         return;
     }
     
-    // Create new file if not exists or if file pointer is null
-    if (!m_trackDataFile) {
+    // Create new recording on the first track after logging starts
+    if (!m_trackRecorder.isRecording()) {
         // Ensure D:/ directory exists and is accessible
         QDir dDrive("D:/");
         if (!dDrive.exists()) {
@@ -4151,45 +4783,15 @@ void MainWindow::logTrackDataToFile(const TargetTrack& track)
         }
         
         m_currentLogFilename = createTimestampedFilename();
-        m_trackDataFile = new QFile(m_currentLogFilename);
-        
-        if (!m_trackDataFile->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-            qDebug() << "Failed to open track data file:" << m_currentLogFilename 
-                     << "Error:" << m_trackDataFile->errorString();
-            delete m_trackDataFile;
-            m_trackDataFile = nullptr;
+        if (!m_trackRecorder.start(QFile::encodeName(m_currentLogFilename).toStdString(),
+                                   TrackRecordKind::Raw, QDateTime::currentMSecsSinceEpoch())) {
+            qDebug() << "Failed to open track data file:" << m_currentLogFilename;
             return;
         }
         
-        // Write CSV header
-        QTextStream out(m_trackDataFile);
-        out << "Timestamp,Target_ID,Range_m,Radial_Speed_m_s,Azimuth_deg,Elevation_deg,Level_dB,Azimuth_Speed_deg_s,Elevation_Speed_deg_s,System_Time\n";
-        out.flush();
-        
-        qDebug() << "Created track data log file in D:/ drive:" << m_currentLogFilename;
+        qDebug() << "Created track data recording in D:/ drive:" << m_currentLogFilename;
     }
     
-    // Write track data to file
-    QTextStream out(m_trackDataFile);
-    QDateTime systemTime = QDateTime::fromMSecsSinceEpoch(track.lastUpdateTime);
-    out << track.lastUpdateTime << ","
-        << track.target_id << ","
-        << track.radius << ","
-        << track.radial_speed << ","
-        << track.azimuth << ","
-        << track.elevation << ","
-        << track.level << ","
-        << track.azimuth_speed << ","
-        << track.elevation_speed << ","
-        << systemTime.toString("yyyy-MM-dd HH:mm:ss.zzz") << "\n";
-    out.flush();
-    
-    // Log to console for debugging
-    qDebug() << "Track data logged - ID:" << track.target_id 
-             << "Range:" << track.radius << "m"
-             << "Speed:" << track.radial_speed << "m/s"
-             << "Azimuth:" << track.azimuth << "deg"
-             << "Elevation:" << track.elevation << "deg"
-             << "Level:" << track.level << "dB"
-             << "Timestamp:" << track.lastUpdateTime;
+    // Hand the record to the recorder thread; no formatting or I/O here
+    m_trackRecorder.record(TrackRecord::fromTarget(track, track.lastUpdateTime));
 }
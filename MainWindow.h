@@ -22,9 +22,24 @@
 #include "FFTWidget.h"
 #include "SpeedMeasurementWidget.h"
 #include "TimeSeriesPlotsWidget.h"
+#include "MicroDopplerWidget.h"
+#include "PhaseTrackingWidget.h"
+#include "LoggingWidget.h"
 #include "DataStructures.h"
+#include "RangeProcessor.h"
+#include "TargetSelector.h"
+#include "TrackLifecycle.h"
+#include "TargetFrameAssembler.h"
+#include "TrackRecorder.h"
+#include "TrackRecordingIndex.h"
+#include "TrackLogExporter.h"
+#include "RawIQCapture.h"
+#include "SessionReplay.h"
+#include "udphandler.h"
 #include <QTabWidget>
 
+class DSPSettingsDialog;
+
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -33,11 +48,32 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    // Apply the target selection mode, max target count and direction filter
+    // of the extended DSP settings to the PPI, FFT and track table
+    void applyTargetSelectionSettings(const DSP_Settings_Extended_t& settings);
+
+    // How long a confirmed track missing from the reports is predicted
+    // forward before it is dropped
+    void setTrackCoastTime(int ms);
+
+    // Session replay: recorded raw IQ captures, track recordings and pcap
+    // captures of the radar port go through the same parsing and processing
+    // as live UDP data, timed by their recorded receive times. Live
+    // datagrams are ignored meanwhile.
+    bool openReplay(const QString& path, QString* error = nullptr);
+    void closeReplay();
+    void setReplayMode(SessionReplay::Mode mode, double speed = 1.0);
+    void playReplay();
+    void pauseReplay();
+    void stepReplay();
+    void seekReplay(qint64 time);
+
 private slots:
     void updateDisplay();
     void readPendingDatagrams();
     void onSimulateDataToggled();
     void onOpenLoggingWindow();
+    void onOpenLogFolder();
     void onStartLoggingClicked();
     void onStopLoggingClicked();
     void updateLoggingStatus();
@@ -57,6 +93,11 @@ private slots:
     void onSaveToFile();
     void refreshTrackTable();  // Auto-refresh track table (sync with current frame data)
     void onDataTimeout();      // Handle data timeout - clear displays when no data received
+    void onFrameDeadline();    // Publish a target frame whose packets did not all arrive
+    void onReplayTimer();      // Hand due replay events to the pipeline
+    void onDetectionTracksUpdated();  // Show raw-detection tracks and clusters on the PPI
+    void onOpenDSPSettingsDialog();
+    void onDSPDialogSettingsChanged(const DSP_Settings_Extended_t& settings);
 
     // DSP parameter slots
     void onRangeAvgEdited();
@@ -78,23 +119,33 @@ private:
     void setupNetworking();
     void setupTimer();
     void updateTrackTable();
-    void applyFrameTargets();  // Apply collected frame targets as current targets (ephemeral sync)
-    TargetTrackData getFilteredTargets() const;  // Apply track filters from TimeSeriesPlotsWidget
+    void setTrackTableRow(int row, const TargetTrack* target);
+    void applyAssembledFrames();  // Feed published target frames to the track lifecycle
+    void armFrameDeadline();
+    void publishTrackLifecycle();  // Take the lifecycle's tracks and change events
+    const TargetTrackData& updateTargetSelection();  // Filtered/selected view of the current frame
     void generateSimulatedTargetData();
     void generateSimulatedADCData();
     void loadSettings();
     QString getSettingsFilePath() const;
 
     // Binary UDP data parsing - NEW
-    void parseBinaryRawData(const QByteArray& datagram);
+    void processDatagram(const QByteArray& datagram, qint64 receiveTime);  // Live or replayed
+    void parseBinaryRawData(const QByteArray& datagram, qint64 receiveTime);
     void processRawDataFrame(const RawDataHeader_t* header,
                             const float* sample_data,
-                            uint32_t total_samples);
-    void parseBinaryTargetData(const QByteArray& datagram);  // NEW for target data
+                            uint32_t total_samples,
+                            qint64 receiveTime);
+    void parseBinaryTargetData(const QByteArray& datagram, qint64 receiveTime);  // NEW for target data
+    qint64 pipelineTime() const;  // Replay time while replaying, else the wall clock
+    void dispatchReplayEvent(const SessionReplay::Event& event);
+    void scheduleReplay();
+    void finishReplay();
+    bool askTrackRecordQuery(const TrackRecordingIndex& index, TrackRecordQuery& query);
 
     // Text-based parsing (legacy/for track data)
     void parseADCMessage(const QString& message);
-    void parseTrackMessage(const QString& message);
+    void parseTrackMessage(const QString& message, qint64 receiveTime);
     
     // Track data logging
     QString createTimestampedFilename();
@@ -105,6 +156,9 @@ private:
     FFTWidget* m_fftWidget;
     SpeedMeasurementWidget* m_speedMeasurementWidget;
     TimeSeriesPlotsWidget* m_timeSeriesPlotsWidget;
+    MicroDopplerWidget* m_microDopplerWidget;
+    PhaseTrackingWidget* m_phaseTrackingWidget;
+    LoggingWidget* m_loggingWidget;
     QTabWidget* m_mainTabWidget;
     QTableWidget* m_trackTable;
     QSplitter* m_mainSplitter;
@@ -157,6 +211,10 @@ private:
     QUdpSocket* m_udpSocket;
     static constexpr quint16 UDP_PORT = 5000;
 
+    // Optional raw detection stream, tracked and clustered by UdpHandler
+    UdpHandler* m_detectionHandler;
+    static constexpr quint16 DETECTION_UDP_PORT = 5002;
+
     // Timer
     QTimer* m_updateTimer;
     static constexpr int UPDATE_INTERVAL_MS = 50;
@@ -170,16 +228,43 @@ private:
     QTimer* m_dataTimeoutTimer;
     static constexpr int DATA_TIMEOUT_MS = 3000;  // 3 seconds timeout
     
-    // Frame-based track collection for ephemeral synchronization
-    // Tracks are only shown when present in the current frame
-    std::vector<TargetTrack> m_frameTargets;  // Tracks being collected for current frame
-    uint8_t m_expectedNumTargets;              // Number of targets expected in current frame
-    uint8_t m_receivedTargetCount;             // Number of targets received so far in current frame
+    // Frame assembly of per-target packets; each published frame (complete,
+    // or partial at its deadline) updates the track lifecycle
+    TargetFrameAssembler m_frameAssembler;
+    TargetFrameAssembler::Frame m_assembledFrame;
+    QTimer* m_frameDeadlineTimer;
+
+    // Session replay source and its pacing timer
+    SessionReplay m_replay;
+    QTimer* m_replayTimer;
+    static constexpr int REPLAY_SLICE_MS = 20;  // Longest run of replay events per timer tick
 
     // Data
-    TargetTrackData m_currentTargets;
+    TargetTrackData m_currentTargets;          // Confirmed and coasting tracks
+    TargetTrackData m_reportedTargets;         // Tracks reported in the last frame
     RawADCFrameTest m_currentADCFrame;
 
+    // Track lifecycle: tentative/confirmed/coasting/deleted, with change events
+    TrackLifecycle m_trackLifecycle;
+    TrackIndex m_changedTrackIds;              // Tracks changed since the table was last updated
+    std::vector<uint32_t> m_trackTableRowIds;  // Track shown in each table row
+    static constexpr uint32_t EMPTY_TRACK_ROW = 0xFFFFFFFFu;
+
+    // Filter + selection view of m_currentTargets shared by PPI, FFT and track
+    // table; recomputed only when the frame or the filter settings change
+    TargetSelector m_targetSelector;
+    TargetSelector::Config m_selectionSettings;   // Selection fields from the DSP settings
+    DSP_Settings_Extended_t m_extendedDsp;        // Last settings from DSPSettingsDialog (or loaded at startup)
+    DSPSettingsDialog* m_dspSettingsDialog;
+    TargetTrackData m_selectedTargets;
+    bool m_selectionDirty;
+
+    // Range FFT over every chirp/RX channel of the latest raw frame
+    RangeProcessor m_rangeProcessor;
+    RangeProfileCube m_rangeCube;
+    qint64 m_lastShortFrameWarning;   // Short-frame warnings are logged at most once a second
+    int m_shortFramesSinceWarning;
+
     // DSP Settings State
     DSP_Settings_t m_dsp;
 
@@ -196,11 +281,17 @@ private:
     uint64_t m_frameCount;
     uint64_t m_targetCount;
     
-    // Track data logging
-    QFile* m_trackDataFile;
+    // Track data logging (binary, written on the recorder thread)
+    TrackRecorder m_trackRecorder;
     QString m_currentLogFilename;
     bool m_isLogging;
 
+    // Raw ADC frame capture (memory-mapped ring, written on its own thread)
+    RawIQCapture m_rawCapture;
+
+    // File > Export Data, written on the exporter's thread
+    TrackLogExporter m_dataExporter;
+
     bool m_isDarkTheme;
     QString m_colorTheme;  // Current color theme: "none", "blue", "green", "red", "purple"
     void applyTheme(bool isDark);
@@ -0,0 +1,142 @@
+#include "MicroDopplerProcessor.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+constexpr float SPEED_OF_LIGHT = 299792458.0f; // m/s
+}
+
+MicroDopplerProcessor::MicroDopplerProcessor(size_t windowLength, size_t hop, size_t historyColumns)
+    : m_windowLength(std::max<size_t>(8, FFTEngine::nextPowerOfTwo(windowLength)))
+    , m_hop(std::max<size_t>(1, hop))
+    , m_historyColumns(std::max<size_t>(1, historyColumns))
+    , m_sweepTime(0.001f)
+    , m_centerFreq(24000000000.0f)
+{
+    m_window.resize(m_windowLength);
+    for (size_t i = 0; i < m_windowLength; ++i) {
+        m_window[i] = 0.5f * (1.0f - std::cos(2.0f * M_PI * i / (m_windowLength - 1)));
+    }
+    m_fftBuffer.resize(m_windowLength);
+}
+
+void MicroDopplerProcessor::setRadarParameters(float sweepTime, float centerFreq)
+{
+    m_sweepTime = sweepTime;
+    m_centerFreq = centerFreq;
+}
+
+bool MicroDopplerProcessor::watchTrack(uint32_t trackId)
+{
+    if (isWatching(trackId)) return true;
+    if (m_tracks.size() >= MAX_TRACKS) return false;
+
+    TrackSpectrogram track;
+    track.trackId = trackId;
+    track.bins = m_windowLength;
+    track.capacity = m_historyColumns;
+    track.columns.assign(m_historyColumns * m_windowLength, 0.0f);
+    track.samples.assign(2 * m_windowLength, std::complex<float>(0.0f, 0.0f));
+    m_tracks.push_back(std::move(track));
+    return true;
+}
+
+void MicroDopplerProcessor::unwatchTrack(uint32_t trackId)
+{
+    m_tracks.erase(std::remove_if(m_tracks.begin(), m_tracks.end(),
+                                  [trackId](const TrackSpectrogram& t) { return t.trackId == trackId; }),
+                   m_tracks.end());
+}
+
+bool MicroDopplerProcessor::isWatching(uint32_t trackId) const
+{
+    for (const auto& t : m_tracks) {
+        if (t.trackId == trackId) return true;
+    }
+    return false;
+}
+
+float MicroDopplerProcessor::maxVelocity() const
+{
+    // Slow-time sampling at one sample per chirp: v_max = lambda / (4 * T_chirp)
+    if (m_sweepTime <= 0.0f || m_centerFreq <= 0.0f) return 0.0f;
+    const float lambda = SPEED_OF_LIGHT / m_centerFreq;
+    return lambda / (4.0f * m_sweepTime);
+}
+
+size_t MicroDopplerProcessor::process(const RangeProfileCube& cube, const TargetTrackData& targets)
+{
+    if (m_tracks.empty() || cube.empty() || cube.num_bins == 0) return 0;
+
+    // Widen the hop when a frame carries more chirps than the per-frame column budget allows
+    const size_t hop = std::max(m_hop, (cube.num_chirps + MAX_COLUMNS_PER_FRAME - 1) / MAX_COLUMNS_PER_FRAME);
+
+    size_t produced = 0;
+    for (auto& track : m_tracks) {
+        // Follow the track's current radius; keep the last bin while it is not reported
+        for (const auto& target : targets.targets) {
+            if (target.target_id == track.trackId) {
+                track.range = target.radius;
+                track.rangeBin = cube.rangeToBin(target.radius);
+                break;
+            }
+        }
+
+        for (uint32_t c = 0; c < cube.num_chirps; ++c) {
+            // Coherent RX sum: the inter-antenna phase is fixed over a window, so it only scales the column
+            std::complex<float> sample(0.0f, 0.0f);
+            for (uint32_t r = 0; r < cube.num_rx_antennas; ++r) {
+                sample += cube.channel(c, r)[track.rangeBin];
+            }
+            pushSample(track, sample);
+
+            if (track.sampleCount >= m_windowLength && track.sinceColumn >= hop) {
+                computeColumn(track);
+                track.sinceColumn = 0;
+                ++produced;
+            }
+        }
+    }
+    return produced;
+}
+
+void MicroDopplerProcessor::pushSample(TrackSpectrogram& track, std::complex<float> sample)
+{
+    // Mirrored write: after writePos advances, the last windowLength samples
+    // are always samples[writePos, writePos + N), oldest first
+    track.samples[track.writePos] = sample;
+    track.samples[track.writePos + m_windowLength] = sample;
+    track.writePos = (track.writePos + 1) % m_windowLength;
+    track.sampleCount = std::min(track.sampleCount + 1, m_windowLength);
+    ++track.sinceColumn;
+}
+
+// Full FFT of the latest window; see the class comment for why this is not a sliding DFT
+void MicroDopplerProcessor::computeColumn(TrackSpectrogram& track)
+{
+    const size_t n = m_windowLength;
+    const std::complex<float>* window = track.samples.data() + track.writePos;
+
+    // Remove the window mean (static clutter) before tapering
+    std::complex<float> mean(0.0f, 0.0f);
+    for (size_t i = 0; i < n; ++i) {
+        mean += window[i];
+    }
+    mean /= static_cast<float>(n);
+    for (size_t i = 0; i < n; ++i) {
+        m_fftBuffer[i] = (window[i] - mean) * m_window[i];
+    }
+
+    m_fftEngine.forward(m_fftBuffer);
+
+    // fftshift so zero Doppler lands in the middle of the column
+    float* out = track.columns.data() + track.head * n;
+    const size_t half = n / 2;
+    for (size_t k = 0; k < n; ++k) {
+        const float magnitude = std::abs(m_fftBuffer[(k + half) % n]) / static_cast<float>(n);
+        out[k] = 20.0f * std::log10(std::max(magnitude, 1e-8f));
+    }
+
+    track.head = (track.head + 1) % track.capacity;
+    track.filled = std::min(track.filled + 1, track.capacity);
+}
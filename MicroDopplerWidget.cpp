@@ -0,0 +1,223 @@
+#include "MicroDopplerWidget.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QCloseEvent>
+#include <QLayout>
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+// SpectrogramCanvas
+//==============================================================================
+SpectrogramCanvas::SpectrogramCanvas(const MicroDopplerProcessor& processor, QWidget *parent)
+    : QWidget(parent)
+    , m_processor(processor)
+    , m_isDarkTheme(false)
+{
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    setMinimumHeight(120);
+}
+
+QRgb SpectrogramCanvas::colorMap(float normalized)
+{
+    // Dark blue -> cyan -> yellow -> red
+    const float t = std::max(0.0f, std::min(1.0f, normalized));
+    float r, g, b;
+    if (t < 0.33f) {
+        const float u = t / 0.33f;
+        r = 0.0f; g = u; b = 0.3f + 0.7f * u;
+    } else if (t < 0.66f) {
+        const float u = (t - 0.33f) / 0.33f;
+        r = u; g = 1.0f; b = 1.0f - u;
+    } else {
+        const float u = (t - 0.66f) / 0.34f;
+        r = 1.0f; g = 1.0f - u; b = 0.0f;
+    }
+    return qRgb(static_cast<int>(r * 255), static_cast<int>(g * 255), static_cast<int>(b * 255));
+}
+
+void SpectrogramCanvas::renderStrip(const MicroDopplerProcessor::TrackSpectrogram& track, QImage& image) const
+{
+    // One pixel per column/bin; time runs left to right, positive Doppler at the top
+    const int width = static_cast<int>(track.capacity);
+    const int height = static_cast<int>(track.bins);
+    if (image.width() != width || image.height() != height) {
+        image = QImage(width, height, QImage::Format_RGB32);
+    }
+    image.fill(colorMap(0.0f));
+    if (track.filled == 0) return;
+
+    // Normalise against the strongest cell currently in history
+    float peak = -1000.0f;
+    for (size_t age = 0; age < track.filled; ++age) {
+        const float* col = track.column(age);
+        peak = std::max(peak, *std::max_element(col, col + track.bins));
+    }
+    const float floor = peak - DYNAMIC_RANGE_DB;
+
+    for (size_t age = 0; age < track.filled; ++age) {
+        const float* col = track.column(age);
+        const int x = width - 1 - static_cast<int>(age);
+        for (int k = 0; k < height; ++k) {
+            QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(height - 1 - k));
+            line[x] = colorMap((col[k] - floor) / DYNAMIC_RANGE_DB);
+        }
+    }
+}
+
+void SpectrogramCanvas::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.fillRect(rect(), m_isDarkTheme ? QColor(15, 23, 42) : QColor(255, 255, 255));
+
+    const QColor textColor = m_isDarkTheme ? QColor(226, 232, 240) : QColor(30, 41, 59);
+    const auto& tracks = m_processor.tracks();
+    if (tracks.empty()) {
+        painter.setPen(textColor);
+        painter.drawText(rect(), Qt::AlignCenter, "Click a target on the PPI to show its micro-Doppler signature");
+        return;
+    }
+
+    const int labelWidth = 70;
+    const int stripHeight = height() / static_cast<int>(tracks.size());
+    const float vmax = m_processor.maxVelocity();
+    m_images.resize(static_cast<int>(tracks.size()));
+
+    painter.setFont(QFont("Segoe UI", 9));
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        const auto& track = tracks[i];
+        QRect strip(labelWidth, static_cast<int>(i) * stripHeight, width() - labelWidth, stripHeight - 4);
+
+        renderStrip(track, m_images[static_cast<int>(i)]);
+        painter.drawImage(strip, m_images[static_cast<int>(i)]);
+
+        // Zero-Doppler reference line
+        painter.setPen(QPen(QColor(255, 255, 255, 90), 1, Qt::DashLine));
+        painter.drawLine(strip.left(), strip.center().y(), strip.right(), strip.center().y());
+
+        painter.setPen(textColor);
+        painter.drawText(QRect(0, strip.top(), labelWidth - 4, strip.height()),
+                         Qt::AlignRight | Qt::AlignVCenter,
+                         QString("ID %1\n%2 m").arg(track.trackId).arg(track.range, 0, 'f', 1));
+        painter.drawText(QRect(0, strip.top(), labelWidth - 4, 14), Qt::AlignRight | Qt::AlignTop,
+                         QString("+%1").arg(vmax, 0, 'f', 1));
+        painter.drawText(QRect(0, strip.bottom() - 14, labelWidth - 4, 14), Qt::AlignRight | Qt::AlignBottom,
+                         QString("-%1").arg(vmax, 0, 'f', 1));
+    }
+}
+
+//==============================================================================
+// MicroDopplerWidget
+//==============================================================================
+MicroDopplerWidget::MicroDopplerWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_homeParent(nullptr)
+{
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(4, 4, 4, 4);
+
+    QHBoxLayout* controls = new QHBoxLayout();
+    m_statusLabel = new QLabel();
+    m_clearButton = new QPushButton("Clear");
+    m_detachButton = new QPushButton("Detach");
+    controls->addWidget(m_statusLabel, 1);
+    controls->addWidget(m_clearButton);
+    controls->addWidget(m_detachButton);
+    layout->addLayout(controls);
+
+    m_canvas = new SpectrogramCanvas(m_processor);
+    layout->addWidget(m_canvas, 1);
+
+    connect(m_clearButton, &QPushButton::clicked, this, &MicroDopplerWidget::clearTracks);
+    connect(m_detachButton, &QPushButton::clicked, this, &MicroDopplerWidget::onDetachClicked);
+
+    updateStatusLabel();
+}
+
+void MicroDopplerWidget::processFrame(const RangeProfileCube& cube, const TargetTrackData& targets)
+{
+    if (m_processor.process(cube, targets) > 0) {
+        m_canvas->update();
+    }
+}
+
+void MicroDopplerWidget::setRadarParameters(float sweepTime, float centerFreq)
+{
+    m_processor.setRadarParameters(sweepTime, centerFreq);
+    m_canvas->update();
+}
+
+void MicroDopplerWidget::setDarkTheme(bool isDark)
+{
+    m_canvas->setDarkTheme(isDark);
+}
+
+void MicroDopplerWidget::toggleTrack(uint32_t trackId)
+{
+    if (m_processor.isWatching(trackId)) {
+        m_processor.unwatchTrack(trackId);
+    } else if (!m_processor.watchTrack(trackId)) {
+        m_statusLabel->setText(QString("At most %1 tracks can be watched").arg(MicroDopplerProcessor::MAX_TRACKS));
+        return;
+    }
+    updateStatusLabel();
+    m_canvas->update();
+}
+
+void MicroDopplerWidget::clearTracks()
+{
+    m_processor.clearTracks();
+    updateStatusLabel();
+    m_canvas->update();
+}
+
+void MicroDopplerWidget::updateStatusLabel()
+{
+    QStringList ids;
+    for (const auto& track : m_processor.tracks()) {
+        ids << QString::number(track.trackId);
+    }
+    m_statusLabel->setText(ids.isEmpty() ? QString("No tracks selected")
+                                         : QString("Tracks: %1").arg(ids.join(", ")));
+}
+
+void MicroDopplerWidget::onDetachClicked()
+{
+    if (isDetached()) {
+        attach();
+        return;
+    }
+
+    // Float as a top-level window; remember the parent to return to
+    m_homeParent = parentWidget();
+    setParent(nullptr, Qt::Window);
+    setWindowTitle("Micro-Doppler");
+    m_detachButton->setText("Attach");
+    resize(800, 400);
+    show();
+}
+
+void MicroDopplerWidget::attach()
+{
+    QWidget* home = m_homeParent;
+    m_homeParent = nullptr;
+    setParent(home, Qt::Widget);
+    if (home && home->layout()) {
+        home->layout()->addWidget(this);
+    }
+    m_detachButton->setText("Detach");
+    show();
+}
+
+void MicroDopplerWidget::closeEvent(QCloseEvent *event)
+{
+    // Closing the floating window docks it back instead of destroying it
+    if (isDetached()) {
+        event->ignore();
+        attach();
+        return;
+    }
+    QWidget::closeEvent(event);
+}
@@ -0,0 +1,78 @@
+#ifndef MICRODOPPLERWIDGET_H
+#define MICRODOPPLERWIDGET_H
+
+#include <QWidget>
+#include <QPainter>
+#include <QPushButton>
+#include <QLabel>
+#include <QImage>
+#include <QVector>
+#include "DataStructures.h"
+#include "MicroDopplerProcessor.h"
+
+// Canvas that paints one spectrogram strip per watched track
+class SpectrogramCanvas : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SpectrogramCanvas(const MicroDopplerProcessor& processor, QWidget *parent = nullptr);
+
+    void setDarkTheme(bool isDark) { m_isDarkTheme = isDark; update(); }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    void renderStrip(const MicroDopplerProcessor::TrackSpectrogram& track, QImage& image) const;
+    static QRgb colorMap(float normalized);
+
+    const MicroDopplerProcessor& m_processor;
+    QVector<QImage> m_images;      // Reused per-strip images
+    bool m_isDarkTheme;
+
+    static constexpr float DYNAMIC_RANGE_DB = 40.0f;
+};
+
+// Micro-Doppler view for tracks selected on the PPI.
+// Can be detached into its own top-level window and re-attached.
+class MicroDopplerWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MicroDopplerWidget(QWidget *parent = nullptr);
+
+    // Feed every raw frame (slow-time continuity needs all chirps)
+    void processFrame(const RangeProfileCube& cube, const TargetTrackData& targets);
+
+    void setRadarParameters(float sweepTime, float centerFreq);
+    void setDarkTheme(bool isDark);
+
+    // Adds the track, or removes it if already watched
+    void toggleTrack(uint32_t trackId);
+    void clearTracks();
+
+    bool isDetached() const { return m_homeParent != nullptr; }
+
+protected:
+    void closeEvent(QCloseEvent *event) override;
+
+private slots:
+    void onDetachClicked();
+
+private:
+    void updateStatusLabel();
+    void attach();
+
+    MicroDopplerProcessor m_processor;
+    SpectrogramCanvas* m_canvas;
+    QPushButton* m_detachButton;
+    QPushButton* m_clearButton;
+    QLabel* m_statusLabel;
+
+    // Where to return when re-attached (null while attached)
+    QWidget* m_homeParent;
+};
+
+#endif // MICRODOPPLERWIDGET_H
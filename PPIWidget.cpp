@@ -226,6 +226,7 @@
 #include <QResizeEvent>
 #include <QFont>
 #include <QFontMetrics>
+#include <QPainterPath>
 #include <cmath>
 #include <QtMath>
 
@@ -238,6 +239,8 @@ PPIWidget::PPIWidget(QWidget *parent)
     , m_minAngle(0.0f) // Default min angle
     , m_maxAngle(0.0f)  // Default max angle
     , m_hoveredTrackIndex(-1)
+    , m_hitIndex(HIT_RADIUS)
+    , m_hitIndexDirty(true)
     , m_isDarkTheme(false) // Default to light theme
 {
     // Minimum size is now set by parent widget based on screen DPI
@@ -330,6 +333,22 @@ QColor PPIWidget::getTooltipTextColor() const
 void PPIWidget::updateTargets(const TargetTrackData& trackData)
 {
     m_currentTargets = trackData;
+    m_hitIndexDirty = true;
+    update();
+}
+
+void PPIWidget::updateDetectionOverlay(const TargetTrackData& tracks,
+                                       const std::vector<DetectionClusterer::Cluster>& clusters)
+{
+    m_detectionTracks = tracks;
+    m_detectionClusters = clusters;
+    update();
+}
+
+void PPIWidget::clearDetectionOverlay()
+{
+    m_detectionTracks = TargetTrackData();
+    m_detectionClusters.clear();
     update();
 }
 
@@ -337,6 +356,7 @@ void PPIWidget::setMaxRange(float range)
 {
     if (range > 0) {
         m_maxRange = range;
+        m_hitIndexDirty = true;
         update();
     }
 }
@@ -345,6 +365,7 @@ void PPIWidget::setMinRange(float range)
 {
     if (range >= 0) {
         m_minRange = range;
+        m_hitIndexDirty = true;
         update();
     }
 }
@@ -401,6 +422,7 @@ void PPIWidget::resizeEvent(QResizeEvent *event)
     );
 
     m_center = QPointF(width() / 2.0f, height() - marginBottom);
+    m_hitIndexDirty = true;
 }
 
 void PPIWidget::paintEvent(QPaintEvent *event)
@@ -416,6 +438,7 @@ void PPIWidget::paintEvent(QPaintEvent *event)
     drawAzimuthLines(painter);
     drawFoVBoundaries(painter); // Draw FoV boundaries on top
     drawTargets(painter);
+    drawDetectionOverlay(painter);
     drawLabels(painter);
     drawHoverTooltip(painter);  // Draw tooltip on top of everything
 }
@@ -442,6 +465,22 @@ void PPIWidget::mouseMoveEvent(QMouseEvent *event)
     QWidget::mouseMoveEvent(event);
 }
 
+void PPIWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        QPointF mousePos = event->position();
+#else
+        QPointF mousePos = event->localPos();
+#endif
+        int trackIndex = findTrackAtPosition(mousePos);
+        if (trackIndex >= 0) {
+            emit trackClicked(m_currentTargets.targets[trackIndex].target_id);
+        }
+    }
+    QWidget::mousePressEvent(event);
+}
+
 void PPIWidget::leaveEvent(QEvent *event)
 {
     if (m_hoveredTrackIndex >= 0) {
@@ -453,8 +492,16 @@ void PPIWidget::leaveEvent(QEvent *event)
 
 int PPIWidget::findTrackAtPosition(const QPointF& pos) const
 {
-    const float hitRadius = 12.0f;  // Pixel radius for hit detection
-    
+    if (m_hitIndexDirty) {
+        rebuildHitIndex();
+    }
+    return m_hitIndex.nearest(static_cast<float>(pos.x()), static_cast<float>(pos.y()), HIT_RADIUS);
+}
+
+void PPIWidget::rebuildHitIndex() const
+{
+    m_hitIndex.clear();
+    m_hitIndex.reserve(m_currentTargets.targets.size());
     for (size_t i = 0; i < m_currentTargets.targets.size(); ++i) {
         const auto& target = m_currentTargets.targets[i];
         
@@ -467,18 +514,11 @@ int PPIWidget::findTrackAtPosition(const QPointF& pos) const
         }
         
         QPointF targetPos = polarToCartesian(target.radius, target.azimuth);
-        
-        // Check if mouse is within hit radius of target
-        float dx = pos.x() - targetPos.x();
-        float dy = pos.y() - targetPos.y();
-        float distance = std::sqrt(dx * dx + dy * dy);
-        
-        if (distance <= hitRadius) {
-            return static_cast<int>(i);
-        }
+        m_hitIndex.addPoint(static_cast<float>(targetPos.x()), static_cast<float>(targetPos.y()),
+                            static_cast<uint32_t>(i));
     }
-    
-    return -1;  // No track found
+    m_hitIndex.build();
+    m_hitIndexDirty = false;
 }
 
 void PPIWidget::drawHoverTooltip(QPainter& painter)
@@ -790,6 +830,50 @@ void PPIWidget::drawTargets(QPainter& painter)
     }
 }
 
+void PPIWidget::drawDetectionOverlay(QPainter& painter)
+{
+    // Cluster extents: the range/azimuth sector spanned by the cluster's detections
+    QColor clusterColor = getPrimaryBlueColor();
+    QColor clusterFill = clusterColor;
+    clusterFill.setAlpha(40);
+    painter.setPen(QPen(clusterColor, 1, Qt::DashLine));
+    painter.setBrush(clusterFill);
+    for (const auto& cluster : m_detectionClusters) {
+        if (cluster.minRange > m_maxRange || cluster.maxRange < m_minRange) continue;
+        if (cluster.minAzimuth > MAX_AZIMUTH || cluster.maxAzimuth < MIN_AZIMUTH) continue;
+
+        const float nearRange = std::max(cluster.minRange, m_minRange);
+        const float farRange = std::min(cluster.maxRange, m_maxRange);
+        const float minAz = std::max(cluster.minAzimuth, MIN_AZIMUTH);
+        const float maxAz = std::min(cluster.maxAzimuth, MAX_AZIMUTH);
+        const int steps = 8;
+        QPainterPath sector(polarToCartesian(farRange, minAz));
+        for (int i = 1; i <= steps; ++i) {
+            sector.lineTo(polarToCartesian(farRange, minAz + (maxAz - minAz) * i / steps));
+        }
+        for (int i = steps; i >= 0; --i) {
+            sector.lineTo(polarToCartesian(nearRange, minAz + (maxAz - minAz) * i / steps));
+        }
+        sector.closeSubpath();
+        painter.drawPath(sector);
+    }
+
+    // Confirmed tracks as hollow squares, labelled D<id> to tell them from reported targets
+    QColor trackColor = getSuccessGreenColor();
+    painter.setBrush(Qt::NoBrush);
+    painter.setFont(QFont("Arial", 9));
+    const float half = 7.0f;
+    for (const auto& track : m_detectionTracks.targets) {
+        if (track.azimuth < MIN_AZIMUTH || track.azimuth > MAX_AZIMUTH) continue;
+        if (track.radius > m_maxRange || track.radius < m_minRange) continue;
+
+        const QPointF pos = polarToCartesian(track.radius, track.azimuth);
+        painter.setPen(QPen(trackColor, 2));
+        painter.drawRect(QRectF(pos.x() - half, pos.y() - half, 2 * half, 2 * half));
+        painter.drawText(pos + QPointF(half + 3, -half), QString("D%1").arg(track.target_id));
+    }
+}
+
 void PPIWidget::drawLabels(QPainter& painter)
 {
     // Premium range labels with enhanced styling
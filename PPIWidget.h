@@ -6,6 +6,8 @@
 #include <QMouseEvent>
 #include <vector>
 #include "DataStructures.h"
+#include "SpatialGrid.h"
+#include "DetectionClusterer.h"
 
 class PPIWidget : public QWidget
 {
@@ -22,6 +24,12 @@ public:
     void setMaxAngle(float angle);  // NEW: Set maximum display angle
     void setDarkTheme(bool isDark); // NEW: Set dark/light theme
 
+    // Overlay of tracks and clusters built from a raw detection stream,
+    // drawn on top of the radar-reported targets
+    void updateDetectionOverlay(const TargetTrackData& tracks,
+                                const std::vector<DetectionClusterer::Cluster>& clusters);
+    void clearDetectionOverlay();
+
     float getMaxRange() const { return m_maxRange; }
     float getMinRange() const { return m_minRange; }
     float getFoVAngle() const { return m_fovAngle; }  // NEW: Get FoV angle
@@ -29,10 +37,14 @@ public:
     float getMaxAngle() const { return m_maxAngle; }  // NEW: Get max angle
     bool isDarkTheme() const { return m_isDarkTheme; } // NEW: Get current theme
 
+signals:
+    void trackClicked(uint32_t trackId);  // Left click on a target
+
 protected:
     void paintEvent(QPaintEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
     void leaveEvent(QEvent *event) override;
 
 private:
@@ -43,6 +55,7 @@ private:
     void drawRangeRings(QPainter& painter);
     void drawAzimuthLines(QPainter& painter);
     void drawTargets(QPainter& painter);
+    void drawDetectionOverlay(QPainter& painter);
     void drawLabels(QPainter& painter);
     void drawHoverTooltip(QPainter& painter);   // Draw transparent hover tooltip
 
@@ -50,9 +63,12 @@ private:
     QColor getTargetColor(float radialSpeed) const;
     QPointF polarToCartesian(float range, float azimuth) const;
     int findTrackAtPosition(const QPointF& pos) const;  // Find track under mouse position
+    void rebuildHitIndex() const;
 
     // Data members
     TargetTrackData m_currentTargets;
+    TargetTrackData m_detectionTracks;                          // Confirmed raw-detection tracks
+    std::vector<DetectionClusterer::Cluster> m_detectionClusters;
 
     // Display parameters
     float m_maxRange;           // Maximum range to display (meters)
@@ -68,6 +84,11 @@ private:
     int m_hoveredTrackIndex;    // Index of currently hovered track (-1 if none)
     QPointF m_hoverPosition;    // Current mouse position for tooltip placement
 
+    // Screen-space index of displayed targets, rebuilt lazily after the
+    // targets or the plot geometry change
+    mutable SpatialGrid m_hitIndex;
+    mutable bool m_hitIndexDirty;
+
     // Theme support
     bool m_isDarkTheme;         // Current theme state
     
@@ -90,6 +111,7 @@ private:
     // Constants for radar display
     static const int NUM_RANGE_RINGS = 5;      // Number of concentric range rings
     static const int NUM_AZIMUTH_LINES = 19;   // Number of radial azimuth lines
+    static constexpr float HIT_RADIUS = 12.0f;  // Pixel radius for hover/click hit detection
 
     // Coordinate system constants (full display range)
     static constexpr float MIN_AZIMUTH = -90.0f;    // Minimum azimuth angle for display
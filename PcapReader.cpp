@@ -0,0 +1,492 @@
+#include "PcapReader.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr uint32_t PCAP_MAGIC_US = 0xA1B2C3D4u;
+constexpr uint32_t PCAP_MAGIC_NS = 0xA1B23C4Du;
+constexpr uint32_t PCAPNG_SECTION = 0x0A0D0D0Au;
+constexpr uint32_t PCAPNG_BYTE_ORDER = 0x1A2B3C4Du;
+constexpr size_t MAX_PENDING_DATAGRAMS = 64;
+constexpr qint64 FRAGMENT_TIMEOUT_MS = 2000;
+constexpr uint32_t MAX_DATAGRAM_BYTES = 65535;
+
+// Link-layer header types (tcpdump.org/linktypes.html)
+constexpr uint32_t LINKTYPE_NULL = 0;
+constexpr uint32_t LINKTYPE_ETHERNET = 1;
+constexpr uint32_t LINKTYPE_RAW_BSD = 12;
+constexpr uint32_t LINKTYPE_RAW_OPENBSD = 14;
+constexpr uint32_t LINKTYPE_RAW = 101;
+constexpr uint32_t LINKTYPE_LOOP = 108;
+constexpr uint32_t LINKTYPE_LINUX_SLL = 113;
+constexpr uint32_t LINKTYPE_IPV4 = 228;
+constexpr uint32_t LINKTYPE_IPV6 = 229;
+constexpr uint32_t LINKTYPE_LINUX_SLL2 = 276;
+
+constexpr uint16_t ETHERTYPE_IPV4 = 0x0800;
+constexpr uint16_t ETHERTYPE_IPV6 = 0x86DD;
+constexpr uint8_t IPPROTO_UDP_ = 17;
+
+inline uint16_t be16(const uint8_t* p)
+{
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+// File fields are in the writer's byte order; `swap` when it is not ours
+inline uint16_t rd16(const uint8_t* p, bool swap)
+{
+    uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return swap ? static_cast<uint16_t>((v >> 8) | (v << 8)) : v;
+}
+
+inline uint32_t bswap32(uint32_t v)
+{
+    return (v >> 24) | ((v >> 8) & 0xFF00u) | ((v << 8) & 0xFF0000u) | (v << 24);
+}
+
+inline uint32_t rd32(const uint8_t* p, bool swap)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return swap ? bswap32(v) : v;
+}
+
+// Ethertype of a bare IP packet, from its version nibble
+uint16_t ipEthertype(const uint8_t* ip, uint32_t captured)
+{
+    if (captured == 0) return 0;
+    switch (ip[0] >> 4) {
+    case 4: return ETHERTYPE_IPV4;
+    case 6: return ETHERTYPE_IPV6;
+    default: return 0;
+    }
+}
+
+void setError(std::string* error, const std::string& message)
+{
+    if (error) *error = message;
+}
+}
+
+struct PcapReader::Fragments {
+    uint8_t key[36];            // Source, destination, id (and protocol for IPv4)
+    size_t keyBytes = 0;
+    qint64 firstTime = 0;
+    uint32_t total = 0;         // Known once the last fragment arrives
+    std::vector<char> data;     // Fragmentable part: UDP header + payload
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;     // (offset, length)
+};
+
+PcapReader::PcapReader(std::vector<uint16_t> ports)
+    : m_ports(std::move(ports))
+{
+}
+
+PcapReader::~PcapReader() = default;
+
+bool PcapReader::isCapture(const char* data, uint64_t size)
+{
+    if (!data || size < 4) return false;
+    uint32_t magic;
+    std::memcpy(&magic, data, sizeof(magic));
+    return magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS ||
+           bswap32(magic) == PCAP_MAGIC_US || bswap32(magic) == PCAP_MAGIC_NS ||
+           magic == PCAPNG_SECTION;
+}
+
+void PcapReader::clear()
+{
+    m_stats = Stats();
+    m_pending.clear();
+    m_reassembled.clear();
+}
+
+bool PcapReader::read(const char* data, uint64_t size, const Visitor& visit, std::string* error)
+{
+    if (!isCapture(data, size)) {
+        setError(error, "Not a pcap or pcapng capture");
+        return false;
+    }
+
+    uint32_t magic;
+    std::memcpy(&magic, data, sizeof(magic));
+    const bool ok = magic == PCAPNG_SECTION ? readPcapng(data, size, visit, error)
+                                            : readPcap(data, size, visit, error);
+
+    // Datagrams still missing fragments will never complete
+    for (const std::unique_ptr<Fragments>& pending : m_pending) {
+        m_stats.fragmentsDropped += pending->ranges.size();
+    }
+    m_pending.clear();
+    return ok;
+}
+
+bool PcapReader::readPcap(const char* data, uint64_t size, const Visitor& visit, std::string* error)
+{
+    const uint8_t* d = reinterpret_cast<const uint8_t*>(data);
+    if (size < 24) {
+        setError(error, "Capture header is truncated");
+        return false;
+    }
+
+    uint32_t magic;
+    std::memcpy(&magic, d, sizeof(magic));
+    const bool swap = magic != PCAP_MAGIC_US && magic != PCAP_MAGIC_NS;
+    const bool nanoseconds = rd32(d, swap) == PCAP_MAGIC_NS;
+    const uint32_t linkType = rd32(d + 20, swap) & 0x0FFFFFFFu;  // Upper bits carry FCS info
+
+    uint64_t offset = 24;
+    while (size - offset >= 16) {
+        const uint8_t* record = d + offset;
+        const uint32_t seconds = rd32(record, swap);
+        const uint32_t fraction = rd32(record + 4, swap);
+        const uint32_t captured = rd32(record + 8, swap);
+        if (captured > size - offset - 16) {
+            break;              // Capture cut off mid-record (tcpdump killed)
+        }
+
+        const qint64 time = qint64(seconds) * 1000 + (nanoseconds ? fraction / 1000000 : fraction / 1000);
+        packet(linkType, time, record + 16, captured, visit);
+        offset += 16 + uint64_t(captured);
+    }
+    return true;
+}
+
+bool PcapReader::readPcapng(const char* data, uint64_t size, const Visitor& visit, std::string* error)
+{
+    struct Interface {
+        uint32_t linkType;
+        uint64_t unitsPerSecond;
+    };
+    std::vector<Interface> interfaces;
+
+    const uint8_t* d = reinterpret_cast<const uint8_t*>(data);
+    bool swap = false;
+    qint64 lastTime = 0;
+    uint64_t offset = 0;
+    while (size - offset >= 12) {
+        const uint8_t* block = d + offset;
+        uint32_t type = rd32(block, swap);
+        if (type == PCAPNG_SECTION) {
+            // Each section sets its own byte order and interface list
+            const uint32_t byteOrder = rd32(block + 8, false);
+            if (byteOrder == PCAPNG_BYTE_ORDER) {
+                swap = false;
+            } else if (bswap32(byteOrder) == PCAPNG_BYTE_ORDER) {
+                swap = true;
+            } else {
+                setError(error, "Bad pcapng section header");
+                return false;
+            }
+            interfaces.clear();
+        }
+
+        const uint32_t length = rd32(block + 4, swap);
+        if (length > size - offset) {
+            break;              // Capture cut off mid-block
+        }
+        if (length < 12 || length % 4 != 0) {
+            setError(error, "Damaged pcapng block at offset " + std::to_string(offset));
+            return false;
+        }
+        const uint8_t* body = block + 8;
+        const uint32_t bodyBytes = length - 12;
+
+        if (type == 1 && bodyBytes >= 8) {
+            // Interface description: link type, then options
+            Interface iface = {rd16(body, swap), 1000000};
+            uint32_t opt = 8;
+            while (bodyBytes - opt >= 4) {
+                const uint16_t code = rd16(body + opt, swap);
+                const uint16_t optBytes = rd16(body + opt + 2, swap);
+                if (code == 0 || optBytes > bodyBytes - opt - 4) break;
+                if (code == 9 && optBytes >= 1) {
+                    // if_tsresol: negative power of 10, or of 2 with the top bit set
+                    const uint8_t resolution = body[opt + 4];
+                    const uint32_t exponent = resolution & 0x7F;
+                    uint64_t units = 1;
+                    if (resolution & 0x80) {
+                        units = exponent < 64 ? (uint64_t(1) << exponent) : 0;
+                    } else {
+                        for (uint32_t i = 0; i < exponent && units <= UINT64_MAX / 10; ++i) units *= 10;
+                    }
+                    if (units > 0) iface.unitsPerSecond = units;
+                }
+                opt += 4 + ((optBytes + 3u) & ~3u);
+            }
+            interfaces.push_back(iface);
+        } else if ((type == 6 && bodyBytes >= 20) || (type == 2 && bodyBytes >= 20)) {
+            // Enhanced packet block, or the obsolete packet block
+            const uint32_t ifaceId = type == 6 ? rd32(body, swap) : rd16(body, swap);
+            const uint64_t stamp = (uint64_t(rd32(body + 4, swap)) << 32) | rd32(body + 8, swap);
+            const uint32_t captured = rd32(body + 12, swap);
+            if (ifaceId < interfaces.size() && captured <= bodyBytes - 20) {
+                const uint64_t units = interfaces[ifaceId].unitsPerSecond;
+                lastTime = static_cast<qint64>((stamp / units) * 1000 + (stamp % units) * 1000 / units);
+                packet(interfaces[ifaceId].linkType, lastTime, body + 20, captured, visit);
+            } else {
+                ++m_stats.packets;
+                ++m_stats.skipped;
+            }
+        } else if (type == 3 && bodyBytes >= 4) {
+            // Simple packet block: interface 0, no timestamp of its own
+            const uint32_t original = rd32(body, swap);
+            const uint32_t captured = std::min(original, bodyBytes - 4);
+            if (!interfaces.empty()) {
+                packet(interfaces[0].linkType, lastTime, body + 4, captured, visit);
+            } else {
+                ++m_stats.packets;
+                ++m_stats.skipped;
+            }
+        }
+        offset += length;
+    }
+    return true;
+}
+
+void PcapReader::packet(uint32_t linkType, qint64 time, const uint8_t* frame, uint32_t captured,
+                        const Visitor& visit)
+{
+    ++m_stats.packets;
+
+    uint16_t ethertype = 0;
+    switch (linkType) {
+    case LINKTYPE_ETHERNET:
+        if (captured < 14) break;
+        ethertype = be16(frame + 12);
+        frame += 14;
+        captured -= 14;
+        // 802.1Q / 802.1ad tags
+        while ((ethertype == 0x8100 || ethertype == 0x88A8 || ethertype == 0x9100) && captured >= 4) {
+            ethertype = be16(frame + 2);
+            frame += 4;
+            captured -= 4;
+        }
+        break;
+    case LINKTYPE_NULL:
+    case LINKTYPE_LOOP:
+        // Address family in the capturing host's byte order; go by the IP version
+        if (captured < 4) break;
+        frame += 4;
+        captured -= 4;
+        ethertype = ipEthertype(frame, captured);
+        break;
+    case LINKTYPE_RAW:
+    case LINKTYPE_RAW_BSD:
+    case LINKTYPE_RAW_OPENBSD:
+    case LINKTYPE_IPV4:
+    case LINKTYPE_IPV6:
+        ethertype = ipEthertype(frame, captured);
+        break;
+    case LINKTYPE_LINUX_SLL:
+        if (captured < 16) break;
+        ethertype = be16(frame + 14);
+        frame += 16;
+        captured -= 16;
+        break;
+    case LINKTYPE_LINUX_SLL2:
+        if (captured < 20) break;
+        ethertype = be16(frame);
+        frame += 20;
+        captured -= 20;
+        break;
+    default:
+        break;
+    }
+
+    if (ethertype == ETHERTYPE_IPV4) {
+        ipv4(time, frame, captured, visit);
+    } else if (ethertype == ETHERTYPE_IPV6) {
+        ipv6(time, frame, captured, visit);
+    } else {
+        ++m_stats.skipped;
+    }
+}
+
+void PcapReader::ipv4(qint64 time, const uint8_t* ip, uint32_t captured, const Visitor& visit)
+{
+    if (captured < 20 || (ip[0] >> 4) != 4 || ip[9] != IPPROTO_UDP_) {
+        ++m_stats.skipped;
+        return;
+    }
+    const uint32_t headerBytes = (ip[0] & 0x0F) * 4u;
+    const uint32_t totalBytes = be16(ip + 2);
+    if (headerBytes < 20 || totalBytes < headerBytes || captured < headerBytes) {
+        ++m_stats.skipped;
+        return;
+    }
+    // Ethernet padding can follow a short packet; the snap length can cut it
+    const bool whole = totalBytes <= captured;
+    const uint32_t available = std::min(totalBytes, captured) - headerBytes;
+
+    const uint16_t flags = be16(ip + 6);
+    const bool moreFragments = (flags & 0x2000) != 0;
+    const uint32_t fragmentOffset = (flags & 0x1FFFu) * 8u;
+    if (moreFragments || fragmentOffset != 0) {
+        if (!whole) {
+            ++m_stats.fragmentsDropped;
+            return;
+        }
+        uint8_t key[11];
+        std::memcpy(key, ip + 12, 8);           // Source and destination
+        std::memcpy(key + 8, ip + 4, 2);        // Identification
+        key[10] = ip[9];
+        fragment(time, key, sizeof(key), fragmentOffset, ip + headerBytes, available, !moreFragments, visit);
+        return;
+    }
+
+    udp(time, ip + headerBytes, available, visit);
+}
+
+void PcapReader::ipv6(qint64 time, const uint8_t* ip, uint32_t captured, const Visitor& visit)
+{
+    if (captured < 40 || (ip[0] >> 4) != 6) {
+        ++m_stats.skipped;
+        return;
+    }
+    const uint32_t payloadBytes = be16(ip + 4);
+    const bool whole = payloadBytes <= captured - 40;
+    uint32_t available = std::min(payloadBytes, captured - 40);
+    uint8_t next = ip[6];
+    const uint8_t* p = ip + 40;
+
+    // Hop-by-hop, routing and destination options headers
+    while (next == 0 || next == 43 || next == 60 || next == 44) {
+        if (available < 8) {
+            ++m_stats.skipped;
+            return;
+        }
+        if (next == 44) {
+            const uint16_t field = be16(p + 2);
+            if (p[0] != IPPROTO_UDP_) {
+                ++m_stats.skipped;
+                return;
+            }
+            if (!whole) {
+                ++m_stats.fragmentsDropped;
+                return;
+            }
+            uint8_t key[36];
+            std::memcpy(key, ip + 8, 32);       // Source and destination
+            std::memcpy(key + 32, p + 4, 4);    // Identification
+            fragment(time, key, sizeof(key), field & 0xFFF8u, p + 8, available - 8, (field & 1) == 0, visit);
+            return;
+        }
+        const uint32_t headerBytes = (p[1] + 1u) * 8u;
+        if (headerBytes > available) {
+            ++m_stats.skipped;
+            return;
+        }
+        next = p[0];
+        p += headerBytes;
+        available -= headerBytes;
+    }
+
+    if (next != IPPROTO_UDP_) {
+        ++m_stats.skipped;
+        return;
+    }
+    udp(time, p, available, visit);
+}
+
+void PcapReader::udp(qint64 time, const uint8_t* udp, uint32_t captured, const Visitor& visit)
+{
+    if (captured < 8 || !wantedPort(be16(udp + 2))) {
+        ++m_stats.skipped;
+        return;
+    }
+    const uint32_t length = be16(udp + 4);
+    if (length < 8) {
+        ++m_stats.skipped;
+        return;
+    }
+    if (length > captured) {
+        // Cut short by the snap length (or a bad length field)
+        ++m_stats.truncated;
+        return;
+    }
+
+    ++m_stats.datagrams;
+    visit(time, reinterpret_cast<const char*>(udp + 8), length - 8);
+}
+
+void PcapReader::fragment(qint64 time, const uint8_t* key, size_t keyBytes, uint32_t offset,
+                          const uint8_t* data, uint32_t length, bool last, const Visitor& visit)
+{
+    if (offset + uint64_t(length) > MAX_DATAGRAM_BYTES) {
+        ++m_stats.fragmentsDropped;
+        return;
+    }
+
+    Fragments* entry = nullptr;
+    for (size_t i = 0; i < m_pending.size(); ) {
+        Fragments& pending = *m_pending[i];
+        if (pending.keyBytes == keyBytes && std::memcmp(pending.key, key, keyBytes) == 0) {
+            entry = &pending;
+            break;
+        }
+        // Give up on datagrams whose other fragments were lost
+        if (time - pending.firstTime > FRAGMENT_TIMEOUT_MS) {
+            m_stats.fragmentsDropped += pending.ranges.size();
+            m_pending.erase(m_pending.begin() + static_cast<std::ptrdiff_t>(i));
+            continue;
+        }
+        ++i;
+    }
+    if (!entry) {
+        if (m_pending.size() >= MAX_PENDING_DATAGRAMS) {
+            m_stats.fragmentsDropped += m_pending.front()->ranges.size();
+            m_pending.erase(m_pending.begin());
+        }
+        m_pending.emplace_back(new Fragments);
+        entry = m_pending.back().get();
+        std::memcpy(entry->key, key, keyBytes);
+        entry->keyBytes = keyBytes;
+        entry->firstTime = time;
+    }
+
+    if (entry->data.size() < offset + length) {
+        entry->data.resize(offset + length);
+    }
+    std::memcpy(entry->data.data() + offset, data, length);
+    entry->ranges.emplace_back(offset, length);
+    if (last) {
+        entry->total = offset + length;
+    }
+    if (entry->total == 0) return;
+
+    // Complete once the fragments cover [0, total) without a gap
+    std::sort(entry->ranges.begin(), entry->ranges.end());
+    uint32_t covered = 0;
+    for (const std::pair<uint32_t, uint32_t>& range : entry->ranges) {
+        if (range.first > covered) return;
+        covered = std::max(covered, range.first + range.second);
+    }
+    if (covered < entry->total) return;
+
+    std::vector<char> datagram = std::move(entry->data);
+    datagram.resize(entry->total);
+    for (size_t i = 0; i < m_pending.size(); ++i) {
+        if (m_pending[i].get() == entry) {
+            m_pending.erase(m_pending.begin() + static_cast<std::ptrdiff_t>(i));
+            break;
+        }
+    }
+
+    // Keep the buffer only if the datagram is reported
+    m_reassembled.push_back(std::move(datagram));
+    const uint64_t reported = m_stats.datagrams;
+    udp(time, reinterpret_cast<const uint8_t*>(m_reassembled.back().data()),
+        static_cast<uint32_t>(m_reassembled.back().size()), visit);
+    if (m_stats.datagrams != reported) {
+        ++m_stats.reassembled;
+    } else {
+        m_reassembled.pop_back();
+    }
+}
+
+bool PcapReader::wantedPort(uint16_t port) const
+{
+    return std::find(m_ports.begin(), m_ports.end(), port) != m_ports.end();
+}
@@ -0,0 +1,77 @@
+#ifndef PCAPREADER_H
+#define PCAPREADER_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <QtGlobal>
+
+// Extracts UDP payloads from a pcap or pcapng capture held in memory
+// (normally a read-only file mapping).
+//
+// Handles classic pcap in either byte order with micro- or nanosecond
+// timestamps, and pcapng sections with per-interface link types and
+// timestamp resolutions. Link layers: Ethernet (with VLAN tags), BSD
+// loopback, raw IP and Linux cooked (SLL/SLL2); network layers: IPv4 and
+// IPv6. Datagrams are reported as pointers into the capture itself; only
+// IP-fragmented datagrams (large raw ADC frames) are copied, into buffers
+// owned by the reader, so the reader must outlive the reported pointers.
+class PcapReader
+{
+public:
+    struct Stats {
+        uint64_t packets = 0;           // Packet records in the capture
+        uint64_t datagrams = 0;         // UDP datagrams to a wanted port
+        uint64_t reassembled = 0;       // ...of which rebuilt from IP fragments
+        uint64_t truncated = 0;         // Wanted datagrams cut short by the snap length
+        uint64_t fragmentsDropped = 0;  // Fragments of datagrams never completed
+        uint64_t skipped = 0;           // Other traffic and unsupported link types
+    };
+
+    // time is the capture timestamp in ms since epoch
+    using Visitor = std::function<void(qint64 time, const char* payload, uint32_t size)>;
+
+    // Only datagrams sent to one of `ports` are reported
+    explicit PcapReader(std::vector<uint16_t> ports = {5000});
+    ~PcapReader();
+
+    PcapReader(const PcapReader&) = delete;
+    PcapReader& operator=(const PcapReader&) = delete;
+
+    void setPorts(std::vector<uint16_t> ports) { m_ports = std::move(ports); }
+    const std::vector<uint16_t>& ports() const { return m_ports; }
+
+    static bool isCapture(const char* data, uint64_t size);
+
+    // Walk the capture in file order. False (with `error` set) if the file
+    // is not a capture or is damaged; datagrams before the damage have
+    // already been reported.
+    bool read(const char* data, uint64_t size, const Visitor& visit, std::string* error = nullptr);
+
+    const Stats& stats() const { return m_stats; }
+    // Drop the reassembled datagram buffers and statistics
+    void clear();
+
+private:
+    struct Fragments;
+
+    bool readPcap(const char* data, uint64_t size, const Visitor& visit, std::string* error);
+    bool readPcapng(const char* data, uint64_t size, const Visitor& visit, std::string* error);
+    void packet(uint32_t linkType, qint64 time, const uint8_t* frame, uint32_t captured,
+                const Visitor& visit);
+    void ipv4(qint64 time, const uint8_t* ip, uint32_t captured, const Visitor& visit);
+    void ipv6(qint64 time, const uint8_t* ip, uint32_t captured, const Visitor& visit);
+    void udp(qint64 time, const uint8_t* udp, uint32_t captured, const Visitor& visit);
+    void fragment(qint64 time, const uint8_t* key, size_t keyBytes, uint32_t offset,
+                  const uint8_t* data, uint32_t length, bool last, const Visitor& visit);
+    bool wantedPort(uint16_t port) const;
+
+    std::vector<uint16_t> m_ports;
+    Stats m_stats;
+    std::vector<std::unique_ptr<Fragments>> m_pending;      // Datagrams being reassembled
+    std::vector<std::vector<char>> m_reassembled;           // Reported reassembled datagrams
+};
+
+#endif // PCAPREADER_H
@@ -0,0 +1,210 @@
+#include "PhaseTracker.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+constexpr float SPEED_OF_LIGHT = 299792458.0f; // m/s
+constexpr double TWO_PI = 6.28318530717958647692;
+}
+
+PhaseTracker::PhaseTracker(size_t windowLength)
+    : m_windowLength(std::max<size_t>(16, windowLength))
+    , m_centerFreq(24000000000.0f)
+    , m_minFrequency(0.1f)      // ~6 breaths/min
+    , m_maxFrequency(3.0f)      // ~180 beats/min
+    , m_locked(false)
+    , m_range(0.0f)
+    , m_rangeBin(0)
+{
+    resetState();
+}
+
+void PhaseTracker::setFrequencyBand(float minHz, float maxHz)
+{
+    m_minFrequency = std::max(0.0f, std::min(minHz, maxHz));
+    m_maxFrequency = std::max(minHz, maxHz);
+    // Band bins are re-derived at the next full recompute
+    m_updatesSinceRecompute = m_windowLength;
+}
+
+void PhaseTracker::lock(float range)
+{
+    m_locked = true;
+    m_range = range;
+    resetState();
+}
+
+void PhaseTracker::unlock()
+{
+    m_locked = false;
+    resetState();
+}
+
+void PhaseTracker::resetState()
+{
+    m_hasPhase = false;
+    m_lastPhase = 0.0f;
+    m_unwrappedPhase = 0.0;
+    m_displacementUm = 0.0f;
+
+    m_lastTimestamp = 0;
+    m_frameInterval = 0.0f;
+    m_frameRate = 0.0f;
+
+    m_window.assign(m_windowLength, 0.0);
+    m_windowPos = 0;
+    m_windowCount = 0;
+    m_updatesSinceRecompute = 0;
+    m_firstBin = 0;
+    m_lastBin = 0;
+    m_spectrum.clear();
+    m_rotation.clear();
+
+    m_history.assign(HISTORY_LENGTH, 0.0f);
+    m_historyPos = 0;
+    m_historyCount = 0;
+}
+
+bool PhaseTracker::process(const RangeProfileCube& cube)
+{
+    if (!m_locked || cube.empty()) return false;
+
+    m_rangeBin = cube.rangeToBin(m_range);
+
+    // Frame rate from receive timestamps
+    if (m_lastTimestamp > 0 && cube.timestamp > m_lastTimestamp) {
+        const float interval = static_cast<float>(cube.timestamp - m_lastTimestamp) / 1000.0f;
+        m_frameInterval = (m_frameInterval > 0.0f) ? 0.9f * m_frameInterval + 0.1f * interval : interval;
+        m_frameRate = 1.0f / m_frameInterval;
+    }
+    m_lastTimestamp = cube.timestamp;
+
+    // Coherent sum over chirps and RX at the locked bin: one phase sample per frame
+    std::complex<float> sum(0.0f, 0.0f);
+    for (uint32_t c = 0; c < cube.num_chirps; ++c) {
+        for (uint32_t r = 0; r < cube.num_rx_antennas; ++r) {
+            sum += cube.channel(c, r)[m_rangeBin];
+        }
+    }
+    ComplexSample sample;
+    sample.I = sum.real();
+    sample.Q = sum.imag();
+    const float phase = sample.phase();
+
+    // Incremental unwrap: accumulate the wrapped phase step
+    if (m_hasPhase) {
+        double delta = static_cast<double>(phase) - static_cast<double>(m_lastPhase);
+        delta -= TWO_PI * std::floor((delta + M_PI) / TWO_PI);
+        m_unwrappedPhase += delta;
+    }
+    m_hasPhase = true;
+    m_lastPhase = phase;
+
+    // Two-way path: d = lambda * phi / (4 pi)
+    const double lambda = SPEED_OF_LIGHT / m_centerFreq;
+    m_displacementUm = static_cast<float>(lambda * m_unwrappedPhase / (2.0 * TWO_PI) * 1e6);
+
+    m_history[m_historyPos] = m_displacementUm;
+    m_historyPos = (m_historyPos + 1) % HISTORY_LENGTH;
+    m_historyCount = std::min(m_historyCount + 1, HISTORY_LENGTH);
+
+    updateSpectrum(m_displacementUm);
+    return true;
+}
+
+void PhaseTracker::updateSpectrum(double newSample)
+{
+    const double oldSample = m_window[m_windowPos];
+    m_window[m_windowPos] = newSample;
+    m_windowPos = (m_windowPos + 1) % m_windowLength;
+    m_windowCount = std::min(m_windowCount + 1, m_windowLength);
+    if (m_windowCount < m_windowLength) return;
+
+    // Full recompute once per window length bounds rounding drift and
+    // re-derives the band bins from the current frame-rate estimate
+    if (++m_updatesSinceRecompute >= m_windowLength || m_spectrum.empty()) {
+        recomputeSpectrum();
+        return;
+    }
+
+    // Sliding DFT: X_k <- (X_k - x_old + x_new) * e^{+j2pi k/N}
+    const double diff = newSample - oldSample;
+    for (size_t i = 0; i < m_spectrum.size(); ++i) {
+        m_spectrum[i] = (m_spectrum[i] + diff) * m_rotation[i];
+    }
+}
+
+void PhaseTracker::recomputeSpectrum()
+{
+    m_updatesSinceRecompute = 0;
+    const size_t n = m_windowLength;
+
+    // Band edges in DFT bins at the current frame rate (bin 0 is the static offset)
+    const double rate = m_frameRate > 0.0f ? m_frameRate : 1.0;
+    m_firstBin = std::max<size_t>(1, static_cast<size_t>(std::floor(m_minFrequency * n / rate)));
+    m_lastBin = std::min<size_t>(n / 2, static_cast<size_t>(std::ceil(m_maxFrequency * n / rate)));
+    if (m_lastBin < m_firstBin) {
+        m_spectrum.clear();
+        m_rotation.clear();
+        return;
+    }
+
+    const size_t count = m_lastBin - m_firstBin + 1;
+    m_spectrum.assign(count, std::complex<double>(0.0, 0.0));
+    m_rotation.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const double angle = TWO_PI * static_cast<double>(m_firstBin + i) / static_cast<double>(n);
+        m_rotation[i] = std::complex<double>(std::cos(angle), std::sin(angle));
+
+        // Direct DFT of the window in time order (oldest sample at m_windowPos);
+        // matches the phase convention the sliding update maintains
+        std::complex<double> acc(0.0, 0.0);
+        for (size_t m = 0; m < n; ++m) {
+            const double x = m_window[(m_windowPos + m) % n];
+            const double a = -angle * static_cast<double>(m);
+            acc += x * std::complex<double>(std::cos(a), std::sin(a));
+        }
+        m_spectrum[i] = acc;
+    }
+}
+
+float PhaseTracker::dominantFrequency() const
+{
+    if (m_spectrum.empty() || m_frameRate <= 0.0f) return 0.0f;
+
+    size_t best = 0;
+    for (size_t i = 1; i < m_spectrum.size(); ++i) {
+        if (std::norm(m_spectrum[i]) > std::norm(m_spectrum[best])) best = i;
+    }
+
+    // Parabolic interpolation on magnitudes for sub-bin resolution
+    double offset = 0.0;
+    if (best > 0 && best + 1 < m_spectrum.size()) {
+        const double a = std::abs(m_spectrum[best - 1]);
+        const double b = std::abs(m_spectrum[best]);
+        const double c = std::abs(m_spectrum[best + 1]);
+        const double denom = a - 2.0 * b + c;
+        if (denom != 0.0) offset = 0.5 * (a - c) / denom;
+    }
+    const double bin = static_cast<double>(m_firstBin + best) + offset;
+    return static_cast<float>(bin * m_frameRate / static_cast<double>(m_windowLength));
+}
+
+float PhaseTracker::dominantMagnitude() const
+{
+    double peak = 0.0;
+    for (const auto& x : m_spectrum) {
+        peak = std::max(peak, std::abs(x));
+    }
+    return static_cast<float>(peak / static_cast<double>(m_windowLength));
+}
+
+std::vector<float> PhaseTracker::history() const
+{
+    std::vector<float> out(m_historyCount);
+    const size_t start = (m_historyPos + HISTORY_LENGTH - m_historyCount) % HISTORY_LENGTH;
+    for (size_t i = 0; i < m_historyCount; ++i) {
+        out[i] = m_history[(start + i) % HISTORY_LENGTH];
+    }
+    return out;
+}
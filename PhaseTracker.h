@@ -0,0 +1,89 @@
+#ifndef PHASETRACKER_H
+#define PHASETRACKER_H
+
+#include <vector>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include "DataStructures.h"
+
+// Phase tracking at a fixed range bin for vibration / vital-sign monitoring.
+//
+// One phase sample is taken per frame from the RX- and chirp-summed range bin,
+// unwrapped incrementally against the previous sample and converted to radial
+// displacement (d = lambda * phi / 4pi). The displacement feeds a sliding DFT
+// that keeps only the bins inside [minFrequency, maxFrequency], so each frame
+// costs O(band bins) no matter how long the analysis window is.
+class PhaseTracker
+{
+public:
+    static constexpr size_t HISTORY_LENGTH = 512;       // Displacement samples kept for display
+    static constexpr size_t DEFAULT_WINDOW = 256;       // Sliding DFT length (frames)
+
+    explicit PhaseTracker(size_t windowLength = DEFAULT_WINDOW);
+
+    void setCenterFrequency(float centerFreq) { m_centerFreq = centerFreq; }
+    void setFrequencyBand(float minHz, float maxHz);
+
+    // Lock to a range (m); resets unwrapping and spectrum state
+    void lock(float range);
+    void unlock();
+    bool isLocked() const { return m_locked; }
+    float lockedRange() const { return m_range; }
+    uint32_t rangeBin() const { return m_rangeBin; }
+
+    // Process one frame; returns false when not locked or the cube is empty
+    bool process(const RangeProfileCube& cube);
+
+    // Latest results
+    float displacementUm() const { return m_displacementUm; }
+    float wrappedPhase() const { return m_lastPhase; }
+    float frameRate() const { return m_frameRate; }
+    float dominantFrequency() const;            // Hz, 0 until the window is full
+    float dominantMagnitude() const;
+
+    // Displacement history (um), oldest first
+    std::vector<float> history() const;
+
+private:
+    void resetState();
+    void updateSpectrum(double newSample);
+    void recomputeSpectrum();
+
+    size_t m_windowLength;
+    float m_centerFreq;
+    float m_minFrequency;
+    float m_maxFrequency;
+
+    bool m_locked;
+    float m_range;
+    uint32_t m_rangeBin;
+
+    // Incremental unwrapper
+    bool m_hasPhase;
+    float m_lastPhase;
+    double m_unwrappedPhase;
+    float m_displacementUm;
+
+    // Frame rate from cube timestamps (EMA of the frame interval)
+    qint64 m_lastTimestamp;
+    float m_frameInterval;
+    float m_frameRate;
+
+    // Sliding DFT over the displacement window
+    std::vector<double> m_window;               // Ring of the last windowLength samples
+    size_t m_windowPos;
+    size_t m_windowCount;
+    size_t m_updatesSinceRecompute;
+    size_t m_firstBin;
+    size_t m_lastBin;
+    std::vector<std::complex<double>> m_spectrum;  // Bins m_firstBin..m_lastBin
+    std::vector<std::complex<double>> m_rotation;  // e^{+j2pi k/N} per tracked bin
+
+    // Display history ring
+    std::vector<float> m_history;
+    size_t m_historyPos;
+    size_t m_historyCount;
+};
+
+#endif // PHASETRACKER_H
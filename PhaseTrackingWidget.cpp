@@ -0,0 +1,171 @@
+#include "PhaseTrackingWidget.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QPainterPath>
+#include <algorithm>
+
+//==============================================================================
+// DisplacementPlot
+//==============================================================================
+DisplacementPlot::DisplacementPlot(const PhaseTracker& tracker, QWidget *parent)
+    : QWidget(parent)
+    , m_tracker(tracker)
+    , m_isDarkTheme(false)
+{
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    setMinimumHeight(120);
+}
+
+void DisplacementPlot::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), m_isDarkTheme ? QColor(15, 23, 42) : QColor(255, 255, 255));
+
+    const QColor textColor = m_isDarkTheme ? QColor(226, 232, 240) : QColor(30, 41, 59);
+    const QColor lineColor = m_isDarkTheme ? QColor(250, 250, 250) : QColor(26, 26, 26);
+    const QColor gridColor = m_isDarkTheme ? QColor(71, 85, 105, 150) : QColor(226, 232, 240, 150);
+
+    const std::vector<float> history = m_tracker.history();
+    if (!m_tracker.isLocked() || history.size() < 2) {
+        painter.setPen(textColor);
+        painter.drawText(rect(), Qt::AlignCenter, "Set a range and press Lock to track phase");
+        return;
+    }
+
+    const QRect plot = rect().adjusted(60, 10, -10, -20);
+    auto [minIt, maxIt] = std::minmax_element(history.begin(), history.end());
+    float minVal = *minIt;
+    float maxVal = *maxIt;
+    if (maxVal - minVal < 1.0f) {
+        const float mid = 0.5f * (maxVal + minVal);
+        minVal = mid - 0.5f;
+        maxVal = mid + 0.5f;
+    }
+
+    // Grid and axis labels
+    painter.setFont(QFont("Segoe UI", 9));
+    for (int i = 0; i <= 4; ++i) {
+        const int y = plot.top() + i * plot.height() / 4;
+        painter.setPen(QPen(gridColor, 1));
+        painter.drawLine(plot.left(), y, plot.right(), y);
+        const float value = maxVal - i * (maxVal - minVal) / 4.0f;
+        painter.setPen(textColor);
+        painter.drawText(QRect(0, y - 8, plot.left() - 6, 16), Qt::AlignRight | Qt::AlignVCenter,
+                         QString::number(value, 'f', 0));
+    }
+    painter.drawText(QRect(plot.left(), plot.bottom() + 2, plot.width(), 16), Qt::AlignCenter,
+                     "Displacement (um), last " + QString::number(history.size()) + " frames");
+
+    // Oldest sample on the left; x spacing fixed by the history capacity
+    QPainterPath path;
+    const float xStep = static_cast<float>(plot.width()) / (PhaseTracker::HISTORY_LENGTH - 1);
+    const float xStart = plot.right() - (history.size() - 1) * xStep;
+    for (size_t i = 0; i < history.size(); ++i) {
+        const float x = xStart + i * xStep;
+        const float y = plot.bottom() - (history[i] - minVal) / (maxVal - minVal) * plot.height();
+        if (i == 0) {
+            path.moveTo(x, y);
+        } else {
+            path.lineTo(x, y);
+        }
+    }
+    painter.setPen(QPen(lineColor, 1.5));
+    painter.drawPath(path);
+}
+
+//==============================================================================
+// PhaseTrackingWidget
+//==============================================================================
+PhaseTrackingWidget::PhaseTrackingWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_framesSinceReadout(0)
+{
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(4, 4, 4, 4);
+
+    QHBoxLayout* controls = new QHBoxLayout();
+    controls->addWidget(new QLabel("Range (m):"));
+    m_rangeSpinBox = new QDoubleSpinBox();
+    m_rangeSpinBox->setRange(0.0, 200.0);
+    m_rangeSpinBox->setDecimals(2);
+    m_rangeSpinBox->setSingleStep(0.1);
+    m_rangeSpinBox->setValue(1.0);
+    controls->addWidget(m_rangeSpinBox);
+
+    m_lockButton = new QPushButton("Lock");
+    m_lockButton->setCheckable(true);
+    controls->addWidget(m_lockButton);
+
+    m_binLabel = new QLabel();
+    m_displacementLabel = new QLabel();
+    m_frequencyLabel = new QLabel();
+    controls->addSpacing(12);
+    controls->addWidget(m_binLabel);
+    controls->addSpacing(12);
+    controls->addWidget(m_displacementLabel);
+    controls->addSpacing(12);
+    controls->addWidget(m_frequencyLabel, 1);
+    layout->addLayout(controls);
+
+    m_plot = new DisplacementPlot(m_tracker);
+    layout->addWidget(m_plot, 1);
+
+    connect(m_lockButton, &QPushButton::toggled, this, &PhaseTrackingWidget::onLockToggled);
+
+    updateReadouts();
+}
+
+void PhaseTrackingWidget::onLockToggled(bool locked)
+{
+    if (locked) {
+        m_tracker.lock(static_cast<float>(m_rangeSpinBox->value()));
+        m_lockButton->setText("Unlock");
+    } else {
+        m_tracker.unlock();
+        m_lockButton->setText("Lock");
+    }
+    m_rangeSpinBox->setEnabled(!locked);
+    updateReadouts();
+    m_plot->update();
+}
+
+void PhaseTrackingWidget::processFrame(const RangeProfileCube& cube)
+{
+    if (!m_tracker.process(cube)) return;
+
+    if (++m_framesSinceReadout >= READOUT_INTERVAL_FRAMES) {
+        m_framesSinceReadout = 0;
+        updateReadouts();
+    }
+    m_plot->update();
+}
+
+void PhaseTrackingWidget::updateReadouts()
+{
+    if (!m_tracker.isLocked()) {
+        m_binLabel->setText("Bin: -");
+        m_displacementLabel->setText("Displacement: -");
+        m_frequencyLabel->setText("Frequency: -");
+        return;
+    }
+
+    m_binLabel->setText(QString("Bin: %1").arg(m_tracker.rangeBin()));
+    m_displacementLabel->setText(QString("Displacement: %1 um").arg(m_tracker.displacementUm(), 0, 'f', 1));
+
+    const float freq = m_tracker.dominantFrequency();
+    if (freq > 0.0f) {
+        m_frequencyLabel->setText(QString("Frequency: %1 Hz (%2 /min)")
+                                  .arg(freq, 0, 'f', 2)
+                                  .arg(freq * 60.0f, 0, 'f', 1));
+    } else {
+        m_frequencyLabel->setText("Frequency: collecting...");
+    }
+}
+
+void PhaseTrackingWidget::setDarkTheme(bool isDark)
+{
+    m_plot->setDarkTheme(isDark);
+}
@@ -0,0 +1,61 @@
+#ifndef PHASETRACKINGWIDGET_H
+#define PHASETRACKINGWIDGET_H
+
+#include <QWidget>
+#include <QPainter>
+#include <QPushButton>
+#include <QDoubleSpinBox>
+#include <QLabel>
+#include "DataStructures.h"
+#include "PhaseTracker.h"
+
+// Displacement trace for the locked range bin
+class DisplacementPlot : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DisplacementPlot(const PhaseTracker& tracker, QWidget *parent = nullptr);
+
+    void setDarkTheme(bool isDark) { m_isDarkTheme = isDark; update(); }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    const PhaseTracker& m_tracker;
+    bool m_isDarkTheme;
+};
+
+// Phase-tracking mode: lock to a range, show displacement (um) and the
+// dominant breathing/vibration frequency from the sliding DFT
+class PhaseTrackingWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PhaseTrackingWidget(QWidget *parent = nullptr);
+
+    void processFrame(const RangeProfileCube& cube);
+    void setCenterFrequency(float centerFreq) { m_tracker.setCenterFrequency(centerFreq); }
+    void setDarkTheme(bool isDark);
+
+private slots:
+    void onLockToggled(bool locked);
+
+private:
+    void updateReadouts();
+
+    PhaseTracker m_tracker;
+    DisplacementPlot* m_plot;
+    QDoubleSpinBox* m_rangeSpinBox;
+    QPushButton* m_lockButton;
+    QLabel* m_binLabel;
+    QLabel* m_displacementLabel;
+    QLabel* m_frequencyLabel;
+    int m_framesSinceReadout;
+
+    static constexpr int READOUT_INTERVAL_FRAMES = 5;  // Limit label churn at high frame rates
+};
+
+#endif // PHASETRACKINGWIDGET_H
@@ -20,8 +20,34 @@ SOURCES += \
     MainWindow.cpp \
     PPIWidget.cpp \
     FFTWidget.cpp \
+    FFTEngine.cpp \
+    IQCorrector.cpp \
+    BatchFFT.cpp \
+    RangeProcessor.cpp \
+    MicroDopplerProcessor.cpp \
+    MicroDopplerWidget.cpp \
+    PhaseTracker.cpp \
+    PhaseTrackingWidget.cpp \
+    KalmanFilterBank.cpp \
+    DetectionTracker.cpp \
+    DetectionClusterer.cpp \
+    TargetSelector.cpp \
+    TrackLifecycle.cpp \
+    TargetFrameAssembler.cpp \
+    TrackRecorder.cpp \
+    RawCaptureRing.cpp \
+    RawIQCapture.cpp \
+    SessionReplay.cpp \
+    PcapReader.cpp \
+    TrackLogImporter.cpp \
+    TrackLogSegments.cpp \
+    TrackLogCodec.cpp \
+    TrackRecordingIndex.cpp \
+    TrackLogExporter.cpp \
+    SpatialGrid.cpp \
     SpeedMeasurementWidget.cpp \
     TimeSeriesPlotsWidget.cpp \
+    LoggingWidget.cpp \
     dialogs.cpp \
     udphandler.cpp
 
@@ -30,8 +56,38 @@ HEADERS += \
     MainWindow.h \
     PPIWidget.h \
     FFTWidget.h \
+    FFTEngine.h \
+    FFTKernels.h \
+    IQCorrector.h \
+    BatchFFT.h \
+    RangeProcessor.h \
+    MicroDopplerProcessor.h \
+    MicroDopplerWidget.h \
+    PhaseTracker.h \
+    PhaseTrackingWidget.h \
+    TrackStateStore.h \
+    RangeRateEstimator.h \
+    KalmanFilterBank.h \
+    DetectionTracker.h \
+    DetectionClusterer.h \
+    TargetSelector.h \
+    TrackLifecycle.h \
+    TargetFrameAssembler.h \
+    TrackRecorder.h \
+    SpscQueue.h \
+    RawCaptureRing.h \
+    RawIQCapture.h \
+    SessionReplay.h \
+    PcapReader.h \
+    TrackLogImporter.h \
+    TrackLogSegments.h \
+    TrackLogCodec.h \
+    TrackRecordingIndex.h \
+    TrackLogExporter.h \
+    SpatialGrid.h \
     SpeedMeasurementWidget.h \
     TimeSeriesPlotsWidget.h \
+    LoggingWidget.h \
     dialogs.h \
     udphandler.h \
     structures.h
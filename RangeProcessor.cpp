@@ -0,0 +1,107 @@
+#include "RangeProcessor.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+constexpr float SPEED_OF_LIGHT = 299792458.0f; // m/s
+}
+
+RangeProcessor::RangeProcessor()
+    : m_sampleRate(100000.0f)
+    , m_sweepTime(0.001f)
+    , m_bandwidth(50000000.0f)
+{
+}
+
+void RangeProcessor::setRadarParameters(float sampleRate, float sweepTime, float bandwidth)
+{
+    m_sampleRate = sampleRate;
+    m_sweepTime = sweepTime;
+    m_bandwidth = bandwidth;
+}
+
+const std::vector<float>& RangeProcessor::windowTable(size_t validSamples)
+{
+    if (m_window.size() != validSamples) {
+        m_window.resize(validSamples);
+        for (size_t i = 0; i < validSamples; ++i) {
+            m_window[i] = validSamples > 1
+                ? 0.5f * (1.0f - std::cos(2.0f * M_PI * i / (validSamples - 1)))
+                : 1.0f;
+        }
+    }
+    return m_window;
+}
+
+bool RangeProcessor::process(const RawDataHeader_t& header, const float* samples, uint32_t totalSamples,
+                             qint64 timestamp, RangeProfileCube& cube)
+{
+    const uint32_t numChirps = header.num_chirps;
+    const uint32_t numRx = header.num_rx_antennas;
+    const uint32_t floatsPerChirp = header.num_samples_per_chirp;  // Includes I and Q for complex
+    const bool isComplex = (header.data_format == 1);
+    const uint32_t numSamples = isComplex ? floatsPerChirp / 2 : floatsPerChirp;
+
+    if (numChirps == 0 || numRx == 0 || numSamples == 0) return false;
+    if (static_cast<uint64_t>(floatsPerChirp) * numChirps * numRx > totalSamples) return false;
+
+    const size_t fftSize = std::max<size_t>(2, FFTEngine::nextPowerOfTwo(numSamples));
+    const size_t channels = static_cast<size_t>(numChirps) * numRx;
+    const std::vector<float>& window = windowTable(numSamples);
+
+    m_work.assign(channels * fftSize, std::complex<float>(0.0f, 0.0f));
+
+    // Deinterleave into [chirp][rx][sample] channels
+    for (uint32_t c = 0; c < numChirps; ++c) {
+        const float* chirpBase = samples + static_cast<size_t>(c) * numRx * floatsPerChirp;
+        for (uint32_t r = 0; r < numRx; ++r) {
+            std::complex<float>* out = m_work.data() + (static_cast<size_t>(c) * numRx + r) * fftSize;
+            for (uint32_t s = 0; s < numSamples; ++s) {
+                float I, Q = 0.0f;
+                if (header.interleaved_rx) {
+                    // Per chirp: sample-major, antenna-minor
+                    size_t idx = static_cast<size_t>(s) * numRx + r;
+                    if (isComplex) {
+                        I = chirpBase[2 * idx];
+                        Q = chirpBase[2 * idx + 1];
+                    } else {
+                        I = chirpBase[idx];
+                    }
+                } else {
+                    // Per chirp: one contiguous block per antenna
+                    const float* rxBase = chirpBase + static_cast<size_t>(r) * floatsPerChirp;
+                    if (isComplex) {
+                        I = rxBase[2 * s];
+                        Q = rxBase[2 * s + 1];
+                    } else {
+                        I = rxBase[s];
+                    }
+                }
+                out[s] = std::complex<float>(I * window[s], Q * window[s]);
+            }
+        }
+    }
+
+    m_fft.forward(m_work.data(), channels, fftSize);
+
+    // Keep the positive-range half of each channel
+    const size_t numBins = fftSize / 2;
+    cube.frame_number = header.frame_number;
+    cube.num_chirps = numChirps;
+    cube.num_rx_antennas = numRx;
+    cube.num_bins = static_cast<uint32_t>(numBins);
+    cube.fft_size = static_cast<uint32_t>(fftSize);
+    cube.num_samples = numSamples;
+    cube.data_format = isComplex ? Rx_Data_Format_t::COMPLEX_FLOAT : Rx_Data_Format_t::REAL_FLOAT;
+    cube.timestamp = timestamp;
+    // FMCW: R = f_beat * c * T / (2B), with f_beat = bin * fs / N
+    cube.bin_spacing = m_bandwidth > 0.0f
+        ? (m_sampleRate / fftSize) * SPEED_OF_LIGHT * m_sweepTime / (2.0f * m_bandwidth)
+        : 0.0f;
+    cube.bins.resize(channels * numBins);
+    for (size_t ch = 0; ch < channels; ++ch) {
+        std::copy(m_work.begin() + ch * fftSize, m_work.begin() + ch * fftSize + numBins,
+                  cube.bins.begin() + ch * numBins);
+    }
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef RANGEPROCESSOR_H
+#define RANGEPROCESSOR_H
+
+#include <vector>
+#include <complex>
+#include "DataStructures.h"
+#include "BatchFFT.h"
+
+// Range FFT over all chirps and RX antennas of a raw ADC frame.
+// Splits the UDP sample block described by RawDataHeader_t into
+// num_chirps x num_rx_antennas channels, applies a Hanning window,
+// zero-pads to a power of two and transforms all channels in one batch.
+class RangeProcessor
+{
+public:
+    RangeProcessor();
+
+    // Returns false if the header and sample count are inconsistent
+    bool process(const RawDataHeader_t& header, const float* samples, uint32_t totalSamples,
+                 qint64 timestamp, RangeProfileCube& cube);
+
+    void setMaxThreads(unsigned maxThreads) { m_fft.setMaxThreads(maxThreads); }
+
+    // FMCW parameters used to fill RangeProfileCube::bin_spacing
+    void setRadarParameters(float sampleRate, float sweepTime, float bandwidth);
+
+private:
+    const std::vector<float>& windowTable(size_t validSamples);
+
+    BatchFFT m_fft;
+    std::vector<std::complex<float>> m_work;   // [channel][fft_size] batch buffer
+    std::vector<float> m_window;
+
+    float m_sampleRate;
+    float m_sweepTime;
+    float m_bandwidth;
+};
+
+#endif // RANGEPROCESSOR_H
@@ -0,0 +1,194 @@
+#ifndef RANGERATEESTIMATOR_H
+#define RANGERATEESTIMATOR_H
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <QtGlobal>
+
+// Running sums for a least-squares line fit r = a + b*t.
+//
+// Samples can be added and removed in O(1); slope() solves the normal
+// equations from the centred second moments. Times should be given relative
+// to a nearby origin (in seconds) so the squared terms keep their precision.
+class LineFitSums
+{
+public:
+    void clear()
+    {
+        m_n = 0;
+        m_sumT = m_sumR = m_sumTT = m_sumTR = 0.0;
+    }
+
+    void add(double t, double r)
+    {
+        ++m_n;
+        m_sumT += t;
+        m_sumR += r;
+        m_sumTT += t * t;
+        m_sumTR += t * r;
+    }
+
+    void remove(double t, double r)
+    {
+        --m_n;
+        m_sumT -= t;
+        m_sumR -= r;
+        m_sumTT -= t * t;
+        m_sumTR -= t * r;
+    }
+
+    size_t count() const { return m_n; }
+
+    // Least-squares slope dr/dt; false with fewer than two distinct times
+    bool slope(double& out) const
+    {
+        if (m_n < 2) return false;
+        const double n = static_cast<double>(m_n);
+        const double stt = m_sumTT - m_sumT * m_sumT / n;
+        if (stt <= MIN_TIME_SPREAD * n) return false;
+        out = (m_sumTR - m_sumT * m_sumR / n) / stt;
+        return true;
+    }
+
+private:
+    // Variance below 1 ms^2 per sample means the times are effectively equal
+    static constexpr double MIN_TIME_SPREAD = 1e-6;
+
+    size_t m_n = 0;
+    double m_sumT = 0.0;
+    double m_sumR = 0.0;
+    double m_sumTT = 0.0;
+    double m_sumTR = 0.0;
+};
+
+// Streaming range-rate estimate for one track.
+//
+// Keeps the last `window` (time, range) samples in a ring together with their
+// LineFitSums, so each update is O(1): the new sample is added and the one
+// falling out of the window is removed. The slope is then averaged over the
+// last `smoothing` estimates, also with a running sum. Every `window`
+// evictions the sums are rebuilt from the ring against a fresh time origin,
+// which bounds floating-point drift at amortised O(1) cost.
+class RangeRateEstimator
+{
+public:
+    explicit RangeRateEstimator(int window = 5, int smoothing = 1)
+    {
+        configure(window, smoothing);
+    }
+
+    // Change the window sizes; discards accumulated state
+    void configure(int window, int smoothing)
+    {
+        m_window = static_cast<size_t>(std::max(2, window));
+        m_smoothing = static_cast<size_t>(std::max(1, smoothing));
+        reset();
+    }
+
+    void reset()
+    {
+        m_times.assign(m_window, 0);
+        m_ranges.assign(m_window, 0.0f);
+        m_rates.assign(m_smoothing, 0.0);
+        m_head = m_count = 0;
+        m_rateHead = m_rateCount = 0;
+        m_rateSum = 0.0;
+        m_sinceRebase = 0;
+        m_origin = 0;
+        m_fit.clear();
+    }
+
+    int window() const { return static_cast<int>(m_window); }
+    int smoothing() const { return static_cast<int>(m_smoothing); }
+
+    // Add a sample and return the smoothed range rate (m/s). `fallback` is
+    // returned until the window spans two distinct timestamps.
+    float update(qint64 timestampMs, float range, float fallback)
+    {
+        if (m_count == 0) {
+            m_origin = timestampMs;
+        }
+
+        if (m_count == m_window) {
+            m_fit.remove(seconds(m_times[m_head]), m_ranges[m_head]);
+            --m_count;
+            if (++m_sinceRebase >= m_window) {
+                m_times[m_head] = timestampMs;
+                m_ranges[m_head] = range;
+                m_head = (m_head + 1) % m_window;
+                ++m_count;
+                rebase();
+                return smooth(fallback);
+            }
+        }
+
+        m_times[m_head] = timestampMs;
+        m_ranges[m_head] = range;
+        m_head = (m_head + 1) % m_window;
+        ++m_count;
+        m_fit.add(seconds(timestampMs), range);
+        return smooth(fallback);
+    }
+
+private:
+    double seconds(qint64 timestampMs) const
+    {
+        return static_cast<double>(timestampMs - m_origin) * 0.001;
+    }
+
+    // Recompute the fit from the ring, with the oldest sample as origin
+    void rebase()
+    {
+        const size_t oldest = (m_head + m_window - m_count) % m_window;
+        m_origin = m_times[oldest];
+        m_fit.clear();
+        for (size_t k = 0; k < m_count; ++k) {
+            const size_t i = (oldest + k) % m_window;
+            m_fit.add(seconds(m_times[i]), m_ranges[i]);
+        }
+        m_rateSum = 0.0;
+        for (size_t k = 0; k < m_rateCount; ++k) {
+            m_rateSum += m_rates[k];
+        }
+        m_sinceRebase = 0;
+    }
+
+    float smooth(float fallback)
+    {
+        double rate;
+        if (!m_fit.slope(rate)) {
+            rate = fallback;
+        }
+
+        if (m_rateCount == m_smoothing) {
+            m_rateSum -= m_rates[m_rateHead];
+        } else {
+            ++m_rateCount;
+        }
+        m_rates[m_rateHead] = rate;
+        m_rateSum += rate;
+        m_rateHead = (m_rateHead + 1) % m_smoothing;
+        return static_cast<float>(m_rateSum / static_cast<double>(m_rateCount));
+    }
+
+    size_t m_window = 2;
+    size_t m_smoothing = 1;
+
+    // Sample ring (oldest at m_head once full)
+    std::vector<qint64> m_times;
+    std::vector<float> m_ranges;
+    size_t m_head = 0;
+    size_t m_count = 0;
+    qint64 m_origin = 0;
+    size_t m_sinceRebase = 0;
+    LineFitSums m_fit;
+
+    // Ring of recent raw estimates for smoothing
+    std::vector<double> m_rates;
+    size_t m_rateHead = 0;
+    size_t m_rateCount = 0;
+    double m_rateSum = 0.0;
+};
+
+#endif // RANGERATEESTIMATOR_H
@@ -0,0 +1,162 @@
+#include "RawCaptureRing.h"
+#include <cstring>
+
+namespace {
+const char RING_MAGIC[8] = {'I', 'Q', 'R', 'I', 'N', 'G', '0', '1'};
+}
+
+RawCaptureRing::RawCaptureRing()
+    : m_header(nullptr)
+    , m_data(nullptr)
+{
+}
+
+bool RawCaptureRing::create(char* base, uint64_t size, qint64 startTime)
+{
+    if (!base || size < HEADER_BYTES + 2 * sizeof(RawCaptureRecordHeader)) {
+        return false;
+    }
+
+    m_header = reinterpret_cast<RawCaptureFileHeader*>(base);
+    m_data = base + HEADER_BYTES;
+
+    std::memset(base, 0, HEADER_BYTES);
+    std::memcpy(m_header->magic, RING_MAGIC, sizeof(m_header->magic));
+    m_header->headerBytes = HEADER_BYTES;
+    m_header->capacity = (size - HEADER_BYTES) & ~uint64_t(7);
+    m_header->startTime = startTime;
+    return true;
+}
+
+void RawCaptureRing::detach()
+{
+    m_header = nullptr;
+    m_data = nullptr;
+}
+
+uint64_t RawCaptureRing::capacity() const
+{
+    return m_header ? m_header->capacity : 0;
+}
+
+uint64_t RawCaptureRing::recordBytes(uint32_t payloadBytes)
+{
+    return (sizeof(RawCaptureRecordHeader) + uint64_t(payloadBytes) + 7) & ~uint64_t(7);
+}
+
+bool RawCaptureRing::skip(const char* data, uint64_t capacity, uint64_t& offset)
+{
+    if (capacity - offset < sizeof(RawCaptureRecordHeader)) {
+        offset = 0;
+        return false;
+    }
+    RawCaptureRecordHeader record;
+    std::memcpy(&record, data + offset, sizeof(record));
+    if (record.magic != RECORD_MAGIC) {
+        offset = 0;                 // Wrap marker
+        return false;
+    }
+    offset += recordBytes(record.payloadBytes);
+    if (offset >= capacity) {
+        offset = 0;
+    }
+    return true;
+}
+
+void RawCaptureRing::dropOldest()
+{
+    // A wrap marker only moves the oldest offset; keep going to a record
+    while (!skip(m_data, m_header->capacity, m_header->oldestOffset)) {
+    }
+    --m_header->recordCount;
+    ++m_header->overwritten;
+}
+
+bool RawCaptureRing::append(const void* payload, uint32_t payloadBytes, qint64 receiveTime)
+{
+    if (!m_header) return false;
+
+    RawCaptureFileHeader& h = *m_header;
+    const uint64_t length = recordBytes(payloadBytes);
+    if (length > h.capacity) return false;
+
+    uint64_t write = h.writeOffset;
+    if (h.capacity - write < length) {
+        // Records between here and the end are lost to the wrap
+        while (h.recordCount > 0 && h.oldestOffset >= write) {
+            dropOldest();
+        }
+        if (h.capacity - write >= sizeof(RawCaptureRecordHeader)) {
+            RawCaptureRecordHeader marker = {WRAP_MAGIC, 0, 0, 0};
+            std::memcpy(m_data + write, &marker, sizeof(marker));
+        }
+        write = 0;
+    }
+
+    // Overwrite the oldest records that start inside the new one
+    while (h.recordCount > 0 && h.oldestOffset >= write && h.oldestOffset < write + length) {
+        dropOldest();
+    }
+    if (h.recordCount == 0) {
+        h.oldestOffset = write;
+    }
+
+    RawCaptureRecordHeader record;
+    record.magic = RECORD_MAGIC;
+    record.payloadBytes = payloadBytes;
+    record.sequence = h.nextSequence;
+    record.receiveTime = receiveTime;
+    std::memcpy(m_data + write, &record, sizeof(record));
+    std::memcpy(m_data + write + sizeof(record), payload, payloadBytes);
+
+    write += length;
+    h.writeOffset = (write >= h.capacity) ? 0 : write;
+    ++h.recordCount;
+    ++h.nextSequence;
+    return true;
+}
+
+bool RawCaptureRing::forEach(const char* base, uint64_t size, const Visitor& visit)
+{
+    if (!base || size < HEADER_BYTES) return false;
+
+    RawCaptureFileHeader h;
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, RING_MAGIC, sizeof(h.magic)) != 0 ||
+        h.headerBytes < sizeof(RawCaptureFileHeader) || h.headerBytes > size ||
+        h.capacity > size - h.headerBytes || h.oldestOffset >= h.capacity) {
+        return false;
+    }
+
+    const char* data = base + h.headerBytes;
+    uint64_t offset = h.oldestOffset;
+    for (uint64_t i = 0; i < h.recordCount; ++i) {
+        RawCaptureRecordHeader record;
+        // At most one wrap (marker or short tail) before each record
+        for (int attempt = 0; ; ++attempt) {
+            if (attempt > 1) return false;
+            if (h.capacity - offset < sizeof(record)) {
+                offset = 0;
+                continue;
+            }
+            std::memcpy(&record, data + offset, sizeof(record));
+            if (record.magic == WRAP_MAGIC) {
+                offset = 0;
+                continue;
+            }
+            break;
+        }
+        if (record.magic != RECORD_MAGIC ||
+            recordBytes(record.payloadBytes) > h.capacity - offset) {
+            return false;
+        }
+        if (!visit(record, data + offset + sizeof(record))) {
+            break;
+        }
+        offset += recordBytes(record.payloadBytes);
+        if (offset >= h.capacity) {
+            offset = 0;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,79 @@
+#ifndef RAWCAPTURERING_H
+#define RAWCAPTURERING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <QtGlobal>
+
+// On-disk layout of a raw IQ capture ring (all fields little-endian).
+//
+// The file is a fixed-size header page followed by a circular data region.
+// Each captured datagram is stored whole (RawDataHeader_t + samples) behind
+// a RawCaptureRecordHeader and padded to 8 bytes. A record never straddles
+// the end of the region: when it would, a wrap marker (or fewer bytes than
+// a record header) fills the tail and writing restarts at offset 0. Once
+// the region is full the oldest records are overwritten, so disk usage is
+// fixed at the file size. The file header tracks where the oldest record
+// starts and where the next one goes.
+struct RawCaptureFileHeader {
+    char magic[8];              // "IQRING01"
+    uint32_t headerBytes;       // Offset of the data region
+    uint32_t reserved;
+    uint64_t capacity;          // Size of the data region
+    uint64_t writeOffset;       // Next record goes here
+    uint64_t oldestOffset;      // Oldest record still in the ring
+    uint64_t recordCount;       // Records currently in the ring
+    uint64_t nextSequence;      // Sequence number of the next record
+    uint64_t overwritten;       // Records lost to wrap-around
+    qint64 startTime;           // ms since epoch
+};
+
+struct RawCaptureRecordHeader {
+    uint32_t magic;             // RECORD_MAGIC or WRAP_MAGIC
+    uint32_t payloadBytes;
+    uint64_t sequence;
+    qint64 receiveTime;         // ms since epoch
+};
+static_assert(sizeof(RawCaptureRecordHeader) == 24, "RawCaptureRecordHeader is an on-disk format");
+
+// Writes capture records into a memory region laid out as above (normally a
+// memory-mapped file). Not thread-safe: use from the capture thread only.
+class RawCaptureRing
+{
+public:
+    static constexpr uint32_t HEADER_BYTES = 4096;
+    static constexpr uint32_t RECORD_MAGIC = 0x52465149u;  // "IQFR"
+    static constexpr uint32_t WRAP_MAGIC = 0x50415257u;    // "WRAP"
+
+    RawCaptureRing();
+
+    // Format `size` bytes at `base` as an empty ring; false if too small
+    bool create(char* base, uint64_t size, qint64 startTime);
+    void detach();
+
+    // Append one record, overwriting the oldest ones as needed. False if
+    // the payload can never fit in the ring.
+    bool append(const void* payload, uint32_t payloadBytes, qint64 receiveTime);
+
+    uint64_t capacity() const;
+    const RawCaptureFileHeader* header() const { return m_header; }
+
+    // Visit the records of a ring from oldest to newest; the callback gets
+    // each header and payload and returns false to stop early. False if
+    // `base` does not hold a valid ring.
+    using Visitor = std::function<bool(const RawCaptureRecordHeader&, const char* payload)>;
+    static bool forEach(const char* base, uint64_t size, const Visitor& visit);
+
+private:
+    static uint64_t recordBytes(uint32_t payloadBytes);
+    // Step past the record (or wrap marker) at `offset`; true if a record
+    // was skipped, false for a wrap marker
+    static bool skip(const char* data, uint64_t capacity, uint64_t& offset);
+    void dropOldest();
+
+    RawCaptureFileHeader* m_header;
+    char* m_data;
+};
+
+#endif // RAWCAPTURERING_H
@@ -0,0 +1,117 @@
+#include "RawIQCapture.h"
+#include <chrono>
+#include <QDateTime>
+
+RawIQCapture::RawIQCapture()
+    : m_map(nullptr)
+    , m_queue(QUEUE_FRAMES)
+    , m_stopping(false)
+    , m_framesCaptured(0)
+    , m_framesDropped(0)
+    , m_framesOverwritten(0)
+{
+}
+
+RawIQCapture::~RawIQCapture()
+{
+    stop();
+}
+
+bool RawIQCapture::start(const QString& path, qint64 fileBytes)
+{
+    stop();
+    m_error.clear();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    // Allocate the whole ring up front so capture never extends the file
+    if (!m_file.resize(fileBytes)) {
+        m_error = m_file.errorString();
+        m_file.close();
+        return false;
+    }
+    m_map = m_file.map(0, fileBytes);
+    if (!m_map) {
+        m_error = m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    if (!m_ring.create(reinterpret_cast<char*>(m_map), static_cast<uint64_t>(fileBytes),
+                       QDateTime::currentMSecsSinceEpoch())) {
+        m_error = QStringLiteral("Capture file too small");
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_file.close();
+        return false;
+    }
+
+    m_framesCaptured.store(0, std::memory_order_relaxed);
+    m_framesDropped.store(0, std::memory_order_relaxed);
+    m_framesOverwritten.store(0, std::memory_order_relaxed);
+    m_stopping.store(false, std::memory_order_relaxed);
+    m_thread = std::thread(&RawIQCapture::captureLoop, this);
+    return true;
+}
+
+void RawIQCapture::stop()
+{
+    if (!m_map) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping.store(true, std::memory_order_release);
+    }
+    m_wake.notify_one();
+    m_thread.join();
+
+    m_ring.detach();
+    m_file.unmap(m_map);
+    m_map = nullptr;
+    m_file.close();
+}
+
+void RawIQCapture::capture(const QByteArray& datagram, qint64 receiveTime)
+{
+    if (!m_map) return;
+
+    Frame frame;
+    frame.datagram = datagram;              // Shares the buffer, no copy
+    frame.receiveTime = receiveTime;
+    if (!m_queue.push(frame)) {
+        m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_wake.notify_one();
+}
+
+void RawIQCapture::captureLoop()
+{
+    for (;;) {
+        Frame frame;
+        while (m_queue.pop(frame)) {
+            if (m_ring.append(frame.datagram.constData(), static_cast<uint32_t>(frame.datagram.size()),
+                              frame.receiveTime)) {
+                m_framesCaptured.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            frame.datagram.clear();
+        }
+        m_framesOverwritten.store(m_ring.header()->overwritten, std::memory_order_relaxed);
+
+        if (m_stopping.load(std::memory_order_acquire)) {
+            if (m_queue.empty()) break;
+            continue;
+        }
+
+        // The GUI notifies without the lock, so also wake on a short timeout
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wake.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+            return m_stopping.load(std::memory_order_acquire) || !m_queue.empty();
+        });
+    }
+}
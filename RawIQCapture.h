@@ -0,0 +1,74 @@
+#ifndef RAWIQCAPTURE_H
+#define RAWIQCAPTURE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include "RawCaptureRing.h"
+#include "SpscQueue.h"
+
+// Full-rate capture of raw ADC datagrams to a memory-mapped ring file.
+//
+// start() pre-allocates the file at its final size and maps it, so disk
+// usage never grows past that; once full, the oldest frames are
+// overwritten (see RawCaptureRing for the layout). The GUI thread only
+// hands each datagram to a capture thread through a lock-free queue - a
+// reference-counted QByteArray copy, no I/O and no locks - and the capture
+// thread copies it into the mapping, taking any page faults itself. If the
+// queue is full the frame is dropped and counted instead of blocking.
+class RawIQCapture
+{
+public:
+    static constexpr qint64 DEFAULT_FILE_BYTES = qint64(1) << 30;   // 1 GiB
+    static constexpr size_t QUEUE_FRAMES = 256;
+
+    RawIQCapture();
+    ~RawIQCapture();
+
+    RawIQCapture(const RawIQCapture&) = delete;
+    RawIQCapture& operator=(const RawIQCapture&) = delete;
+
+    // Create and map the ring file and start the capture thread
+    bool start(const QString& path, qint64 fileBytes = DEFAULT_FILE_BYTES);
+    // Write out the queued frames and unmap the file
+    void stop();
+    bool isCapturing() const { return m_map != nullptr; }
+    QString path() const { return m_file.fileName(); }
+    QString errorString() const { return m_error; }
+
+    // GUI thread only; never blocks
+    void capture(const QByteArray& datagram, qint64 receiveTime);
+
+    quint64 framesCaptured() const { return m_framesCaptured.load(std::memory_order_relaxed); }
+    quint64 framesDropped() const { return m_framesDropped.load(std::memory_order_relaxed); }
+    quint64 framesOverwritten() const { return m_framesOverwritten.load(std::memory_order_relaxed); }
+
+private:
+    struct Frame {
+        QByteArray datagram;
+        qint64 receiveTime = 0;
+    };
+
+    void captureLoop();
+
+    QFile m_file;
+    uchar* m_map;
+    QString m_error;
+    RawCaptureRing m_ring;
+
+    SpscQueue<Frame> m_queue;               // GUI -> capture thread
+    std::thread m_thread;
+    std::atomic<bool> m_stopping;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+
+    std::atomic<quint64> m_framesCaptured;
+    std::atomic<quint64> m_framesDropped;
+    std::atomic<quint64> m_framesOverwritten;
+};
+
+#endif // RAWIQCAPTURE_H
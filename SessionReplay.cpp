@@ -0,0 +1,303 @@
+#include "SessionReplay.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "DataStructures.h"
+#include "RawCaptureRing.h"
+#include "TargetFrameAssembler.h"
+#include "TrackRecorder.h"
+
+namespace {
+constexpr size_t TARGET_PACKET_BYTES = sizeof(TargetDataPacket_t) + sizeof(TargetFrameTrailer_t);
+constexpr size_t MAX_FRAME_TARGETS = 255;          // num_targets is 8 bits
+
+void setError(QString* error, const QString& message)
+{
+    if (error) *error = message;
+}
+}
+
+SessionReplay::SessionReplay()
+    : m_map(nullptr)
+    , m_format(Format::None)
+    , m_position(0)
+    , m_sessionTime(0)
+    , m_mode(Mode::RealTime)
+    , m_speed(1.0)
+    , m_playing(false)
+    , m_wallAnchor(0)
+    , m_sessionAnchor(0)
+{
+}
+
+SessionReplay::~SessionReplay()
+{
+    close();
+}
+
+bool SessionReplay::open(const QString& path, QString* error)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        setError(error, m_file.errorString());
+        return false;
+    }
+    const qint64 size = m_file.size();
+    m_map = size > 0 ? m_file.map(0, size) : nullptr;
+    if (!m_map) {
+        setError(error, QStringLiteral("Cannot map %1").arg(path));
+        close();
+        return false;
+    }
+
+    const char* base = reinterpret_cast<const char*>(m_map);
+    bool ok;
+    if (size >= 8 && std::memcmp(base, "IQRING01", 8) == 0) {
+        m_format = Format::RawCapture;
+        ok = indexRawCapture(base, size, error);
+    } else if (size >= 4 && std::memcmp(base, "TRKR", 4) == 0) {
+        m_format = Format::TrackRecording;
+        ok = buildTargetPackets(base, size, error);
+        // Packets are rebuilt into memory; the mapping is no longer needed
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    } else if (PcapReader::isCapture(base, static_cast<uint64_t>(size))) {
+        m_format = Format::PacketCapture;
+        ok = indexPacketCapture(base, size, error);
+    } else {
+        setError(error, QStringLiteral("%1 is not a raw IQ capture, track recording or packet capture").arg(path));
+        ok = false;
+    }
+    if (!ok) {
+        close();
+        return false;
+    }
+
+    // Receive times can step back (clock adjustments, multi-queue capture).
+    // Keep the datagrams in receive order and clamp their times instead, so
+    // event times never decrease and seek() can search them.
+    for (size_t i = 1; i < m_events.size(); ++i) {
+        m_events[i].time = std::max(m_events[i].time, m_events[i - 1].time);
+    }
+
+    rewind();
+    return true;
+}
+
+void SessionReplay::close()
+{
+    m_events.clear();
+    m_packets.clear();
+    m_packets.shrink_to_fit();
+    m_pcap.clear();
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_file.close();
+    m_format = Format::None;
+    m_playing = false;
+    m_position = 0;
+    m_sessionTime = 0;
+}
+
+bool SessionReplay::indexRawCapture(const char* base, qint64 size, QString* error)
+{
+    const bool valid = RawCaptureRing::forEach(base, static_cast<uint64_t>(size),
+        [this](const RawCaptureRecordHeader& record, const char* payload) {
+            m_events.push_back({record.receiveTime, payload, record.payloadBytes});
+            return true;
+        });
+    if (!valid) {
+        m_events.clear();
+        setError(error, QStringLiteral("Raw IQ capture is damaged"));
+        return false;
+    }
+    return true;
+}
+
+bool SessionReplay::indexPacketCapture(const char* base, qint64 size, QString* error)
+{
+    std::string message;
+    const bool valid = m_pcap.read(base, static_cast<uint64_t>(size),
+        [this](qint64 time, const char* payload, uint32_t bytes) {
+            m_events.push_back({time, payload, bytes});
+        }, &message);
+    // A damaged capture still replays what was read before the damage
+    if (m_events.empty()) {
+        setError(error, valid ? QStringLiteral("No UDP datagrams for the radar port in the capture")
+                              : QString::fromStdString(message));
+        return false;
+    }
+    return true;
+}
+
+bool SessionReplay::buildTargetPackets(const char* base, qint64 size, QString* error)
+{
+    TrackRecordingHeader header;
+    if (size < static_cast<qint64>(sizeof(header))) {
+        setError(error, QStringLiteral("Track recording is truncated"));
+        return false;
+    }
+    std::memcpy(&header, base, sizeof(header));
+    if (header.recordSize != sizeof(TrackRecord) ||
+        header.kind != static_cast<uint32_t>(TrackRecordKind::Raw)) {
+        setError(error, QStringLiteral("Only raw track recordings can be replayed"));
+        return false;
+    }
+
+    const size_t count = static_cast<size_t>(size - sizeof(header)) / sizeof(TrackRecord);
+    const char* records = base + sizeof(header);
+    m_packets.assign(count * TARGET_PACKET_BYTES, 0);
+    m_events.reserve(count);
+
+    // Split the records into frames, then write each frame's packets with
+    // its size and a frame id so the assembler needs no inference
+    const qint64 packetGapMs = TargetFrameAssembler::Config().packetGapMs;
+    std::vector<TrackRecord> frame;
+    frame.reserve(MAX_FRAME_TARGETS);
+    uint32_t frameId = 0;
+    size_t written = 0;
+
+    auto flushFrame = [&]() {
+        for (const TrackRecord& r : frame) {
+            TargetDataPacket_t packet;
+            std::memset(&packet, 0, sizeof(packet));
+            packet.message_type = 0x02;
+            packet.num_targets = static_cast<uint8_t>(frame.size());
+            packet.target_id = r.target_id;
+            packet.level = r.level;
+            packet.radius = r.radius;
+            packet.azimuth = r.azimuth;
+            packet.elevation = r.elevation;
+            packet.radial_speed = r.radial_speed;
+            packet.azimuth_speed = r.azimuth_speed;
+            packet.elevation_speed = r.elevation_speed;
+            TargetFrameTrailer_t trailer;
+            trailer.frame_id = frameId;
+
+            char* out = m_packets.data() + written * TARGET_PACKET_BYTES;
+            std::memcpy(out, &packet, sizeof(packet));
+            std::memcpy(out + sizeof(packet), &trailer, sizeof(trailer));
+            m_events.push_back({r.timestamp, out, static_cast<uint32_t>(TARGET_PACKET_BYTES)});
+            ++written;
+        }
+        frame.clear();
+        ++frameId;
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        TrackRecord r;
+        std::memcpy(&r, records + i * sizeof(TrackRecord), sizeof(r));
+        if (!frame.empty()) {
+            const bool repeated = std::any_of(frame.begin(), frame.end(), [&r](const TrackRecord& f) {
+                return f.target_id == r.target_id;
+            });
+            if (repeated || r.timestamp - frame.back().timestamp > packetGapMs ||
+                frame.size() == MAX_FRAME_TARGETS) {
+                flushFrame();
+            }
+        }
+        frame.push_back(r);
+    }
+    if (!frame.empty()) {
+        flushFrame();
+    }
+    return true;
+}
+
+qint64 SessionReplay::startTime() const
+{
+    return m_events.empty() ? 0 : m_events.front().time;
+}
+
+qint64 SessionReplay::endTime() const
+{
+    return m_events.empty() ? 0 : m_events.back().time;
+}
+
+void SessionReplay::setMode(Mode mode, double speed)
+{
+    m_mode = mode;
+    m_speed = (std::isfinite(speed) && speed > 0.0) ? speed : 1.0;
+    m_wallAnchor = -1;                      // Re-anchor on the next call
+}
+
+void SessionReplay::play(qint64 wallNow)
+{
+    m_playing = true;
+    anchor(wallNow);
+}
+
+void SessionReplay::pause()
+{
+    m_playing = false;
+}
+
+void SessionReplay::rewind()
+{
+    m_position = 0;
+    m_sessionTime = startTime();
+    m_wallAnchor = -1;
+}
+
+void SessionReplay::seek(qint64 time)
+{
+    // open() makes event times non-decreasing
+    const auto it = std::lower_bound(m_events.begin(), m_events.end(), time,
+                                     [](const Event& event, qint64 t) { return event.time < t; });
+    m_position = static_cast<size_t>(it - m_events.begin());
+    m_sessionTime = std::min(std::max(time, startTime()), endTime());
+    m_wallAnchor = -1;
+}
+
+void SessionReplay::anchor(qint64 wallNow)
+{
+    // The next event is due now; later ones follow at the recorded spacing
+    m_wallAnchor = wallNow;
+    m_sessionAnchor = atEnd() ? m_sessionTime : m_events[m_position].time;
+}
+
+qint64 SessionReplay::dueTime(const Event& event) const
+{
+    const double offset = static_cast<double>(event.time - m_sessionAnchor) / m_speed;
+    return m_wallAnchor + static_cast<qint64>(std::floor(offset));
+}
+
+const SessionReplay::Event* SessionReplay::next(qint64 wallNow)
+{
+    if (!m_playing || atEnd() || m_mode == Mode::SingleStep) {
+        return nullptr;
+    }
+    if (m_mode == Mode::RealTime) {
+        if (m_wallAnchor < 0) {
+            anchor(wallNow);
+        }
+        if (dueTime(m_events[m_position]) > wallNow) {
+            return nullptr;
+        }
+    }
+    return step();
+}
+
+const SessionReplay::Event* SessionReplay::step()
+{
+    if (atEnd()) return nullptr;
+
+    const Event* event = &m_events[m_position++];
+    m_sessionTime = event->time;
+    return event;
+}
+
+qint64 SessionReplay::msUntilNext(qint64 wallNow) const
+{
+    if (!m_playing || atEnd() || m_mode == Mode::SingleStep) {
+        return -1;
+    }
+    if (m_mode == Mode::AsFastAsPossible || m_wallAnchor < 0) {
+        return 0;
+    }
+    return std::max<qint64>(0, dueTime(m_events[m_position]) - wallNow);
+}
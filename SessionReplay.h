@@ -0,0 +1,119 @@
+#ifndef SESSIONREPLAY_H
+#define SESSIONREPLAY_H
+
+#include <cstdint>
+#include <vector>
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+#include "PcapReader.h"
+
+// Recorded session played back as the datagrams originally received.
+//
+// Raw IQ captures (.iqr, see RawIQCapture) already hold every raw ADC
+// datagram with its receive time and are replayed straight from a
+// read-only mapping. Track recordings (.trk, see TrackRecorder) hold one
+// record per target packet; they are turned back into binary target
+// packets with a frame id trailer, grouping records into frames the same
+// way TargetFrameAssembler infers boundaries (a repeated target id or a
+// gap between packets). pcap/pcapng captures (tcpdump) are mapped too and
+// replay the UDP payloads sent to the radar port(s); only IP-fragmented
+// datagrams are copied out of the mapping.
+//
+// Each event carries its recorded receive time, which the pipeline uses in
+// place of the wall clock, so a replay produces the same results whatever
+// the playback speed. Events stay in receive order; a time that steps back
+// is clamped to the one before, so event times never decrease. The pacing
+// here only decides *when* the next event is handed out: at recorded speed,
+// scaled, as fast as possible, or one at a time with step().
+class SessionReplay
+{
+public:
+    enum class Format {
+        None,
+        RawCapture,
+        TrackRecording,
+        PacketCapture
+    };
+
+    enum class Mode {
+        RealTime,               // Recorded timing scaled by speed()
+        AsFastAsPossible,
+        SingleStep              // Only step() hands out events
+    };
+
+    struct Event {
+        qint64 time;            // Recorded receive time, ms since epoch
+        const char* data;
+        uint32_t size;
+    };
+
+    SessionReplay();
+    ~SessionReplay();
+
+    SessionReplay(const SessionReplay&) = delete;
+    SessionReplay& operator=(const SessionReplay&) = delete;
+
+    // Load a session; playback starts paused at the first event
+    bool open(const QString& path, QString* error = nullptr);
+    void close();
+    bool isOpen() const { return m_format != Format::None; }
+    Format format() const { return m_format; }
+    QString path() const { return m_file.fileName(); }
+
+    // UDP destination ports taken from packet captures
+    void setCapturePorts(std::vector<uint16_t> ports) { m_pcap.setPorts(std::move(ports)); }
+    const PcapReader::Stats& captureStats() const { return m_pcap.stats(); }
+
+    size_t eventCount() const { return m_events.size(); }
+    size_t position() const { return m_position; }
+    bool atEnd() const { return m_position >= m_events.size(); }
+    qint64 startTime() const;
+    qint64 endTime() const;
+    // Recorded time of the last event handed out (startTime() before any)
+    qint64 sessionTime() const { return m_sessionTime; }
+
+    void setMode(Mode mode, double speed = 1.0);
+    Mode mode() const { return m_mode; }
+    double speed() const { return m_speed; }
+
+    // Pacing runs against the caller's wall clock (ms)
+    void play(qint64 wallNow);
+    void pause();
+    bool isPlaying() const { return m_playing; }
+    void rewind();
+    // Continue from the first event at or after recorded time `time`
+    void seek(qint64 time);
+
+    // The next event due at `wallNow`, or nullptr if none is due yet
+    const Event* next(qint64 wallNow);
+    // The next event regardless of mode and timing; nullptr at the end
+    const Event* step();
+    // Wall ms until next() has an event: 0 if one is due, -1 if paused,
+    // single-stepping or at the end
+    qint64 msUntilNext(qint64 wallNow) const;
+
+private:
+    bool indexRawCapture(const char* base, qint64 size, QString* error);
+    bool buildTargetPackets(const char* base, qint64 size, QString* error);
+    bool indexPacketCapture(const char* base, qint64 size, QString* error);
+    void anchor(qint64 wallNow);
+    qint64 dueTime(const Event& event) const;
+
+    QFile m_file;
+    uchar* m_map;
+    Format m_format;
+    std::vector<char> m_packets;            // Rebuilt target packets
+    PcapReader m_pcap;                      // Owns reassembled datagrams
+    std::vector<Event> m_events;
+    size_t m_position;
+    qint64 m_sessionTime;
+
+    Mode m_mode;
+    double m_speed;
+    bool m_playing;
+    qint64 m_wallAnchor;                    // Wall time at which...
+    qint64 m_sessionAnchor;                 // ...this recorded time is due
+};
+
+#endif // SESSIONREPLAY_H
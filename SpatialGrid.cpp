@@ -0,0 +1,156 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : m_requestedCell(std::max(1e-3f, cellSize))
+    , m_cell(m_requestedCell)
+    , m_minX(0.0f)
+    , m_minY(0.0f)
+    , m_cols(0)
+    , m_rows(0)
+{
+}
+
+void SpatialGrid::setCellSize(float cellSize)
+{
+    m_requestedCell = std::max(1e-3f, cellSize);
+}
+
+void SpatialGrid::clear()
+{
+    m_staged.clear();
+    m_points.clear();
+    m_cellStart.clear();
+    m_cols = m_rows = 0;
+}
+
+void SpatialGrid::reserve(size_t count)
+{
+    m_staged.reserve(count);
+    m_points.reserve(count);
+    m_cellOf.reserve(count);
+}
+
+void SpatialGrid::addPoint(float x, float y, uint32_t id)
+{
+    if (!std::isfinite(x) || !std::isfinite(y)) return;
+    m_staged.push_back({x, y, id});
+}
+
+void SpatialGrid::build()
+{
+    m_points.clear();
+    m_cellStart.clear();
+    m_cols = m_rows = 0;
+    if (m_staged.empty()) return;
+
+    float minX = m_staged[0].x, maxX = minX;
+    float minY = m_staged[0].y, maxY = minY;
+    for (const Point& p : m_staged) {
+        minX = std::min(minX, p.x); maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y); maxY = std::max(maxY, p.y);
+    }
+
+    // Grow the cell if a wide, sparse point set would need too many cells
+    float cell = m_requestedCell;
+    while ((static_cast<double>((maxX - minX) / cell) + 1.0) *
+           (static_cast<double>((maxY - minY) / cell) + 1.0) > MAX_GRID_CELLS) {
+        cell *= 2.0f;
+    }
+    m_cell = cell;
+    m_minX = minX;
+    m_minY = minY;
+    m_cols = static_cast<int>((maxX - minX) / cell) + 1;
+    m_rows = static_cast<int>((maxY - minY) / cell) + 1;
+
+    // Counting sort of points into cells (CSR)
+    const size_t cells = static_cast<size_t>(m_cols) * m_rows;
+    m_cellStart.assign(cells + 1, 0);
+    m_cellOf.resize(m_staged.size());
+    for (size_t i = 0; i < m_staged.size(); ++i) {
+        const int cx = std::min(m_cols - 1, static_cast<int>((m_staged[i].x - minX) / cell));
+        const int cy = std::min(m_rows - 1, static_cast<int>((m_staged[i].y - minY) / cell));
+        m_cellOf[i] = static_cast<uint32_t>(cy * m_cols + cx);
+        ++m_cellStart[m_cellOf[i] + 1];
+    }
+    for (size_t c = 0; c < cells; ++c) {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+    m_points.resize(m_staged.size());
+    std::vector<uint32_t> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < m_staged.size(); ++i) {
+        m_points[fill[m_cellOf[i]]++] = m_staged[i];
+    }
+    m_staged.clear();
+}
+
+bool SpatialGrid::cellRange(float x, float y, float radius,
+                            int& cx0, int& cy0, int& cx1, int& cy1) const
+{
+    if (m_cols == 0 || radius < 0.0f) return false;
+
+    const float fx0 = std::floor((x - radius - m_minX) / m_cell);
+    const float fy0 = std::floor((y - radius - m_minY) / m_cell);
+    const float fx1 = std::floor((x + radius - m_minX) / m_cell);
+    const float fy1 = std::floor((y + radius - m_minY) / m_cell);
+    if (fx1 < 0.0f || fy1 < 0.0f || fx0 >= m_cols || fy0 >= m_rows) return false;
+
+    cx0 = std::max(0, static_cast<int>(fx0));
+    cy0 = std::max(0, static_cast<int>(fy0));
+    cx1 = std::min(m_cols - 1, static_cast<int>(fx1));
+    cy1 = std::min(m_rows - 1, static_cast<int>(fy1));
+    return true;
+}
+
+int SpatialGrid::nearest(float x, float y, float maxRadius) const
+{
+    int cx0, cy0, cx1, cy1;
+    if (!cellRange(x, y, maxRadius, cx0, cy0, cx1, cy1)) return NO_POINT;
+
+    int best = NO_POINT;
+    float bestDist2 = maxRadius * maxRadius;
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        const size_t row = static_cast<size_t>(cy) * m_cols;
+        for (uint32_t k = m_cellStart[row + cx0]; k < m_cellStart[row + cx1 + 1]; ++k) {
+            const Point& p = m_points[k];
+            const float dx = p.x - x;
+            const float dy = p.y - y;
+            const float d2 = dx * dx + dy * dy;
+            if (d2 < bestDist2 || (d2 == bestDist2 && (best == NO_POINT || p.id < static_cast<uint32_t>(best)))) {
+                bestDist2 = d2;
+                best = static_cast<int>(p.id);
+            }
+        }
+    }
+    return best;
+}
+
+void SpatialGrid::withinRadius(float x, float y, float radius, std::vector<uint32_t>& ids) const
+{
+    ids.clear();
+    int cx0, cy0, cx1, cy1;
+    if (!cellRange(x, y, radius, cx0, cy0, cx1, cy1)) return;
+
+    // Size for every candidate, then compact without a data-dependent branch
+    size_t candidates = 0;
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        const size_t row = static_cast<size_t>(cy) * m_cols;
+        candidates += m_cellStart[row + cx1 + 1] - m_cellStart[row + cx0];
+    }
+    ids.resize(candidates);
+
+    const float r2 = radius * radius;
+    size_t count = 0;
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        const size_t row = static_cast<size_t>(cy) * m_cols;
+        for (uint32_t k = m_cellStart[row + cx0]; k < m_cellStart[row + cx1 + 1]; ++k) {
+            const Point& p = m_points[k];
+            const float dx = p.x - x;
+            const float dy = p.y - y;
+            ids[count] = p.id;
+            count += (dx * dx + dy * dy <= r2) ? 1 : 0;
+        }
+    }
+    ids.resize(count);
+}
@@ -0,0 +1,65 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Uniform-grid spatial index over 2D points for nearest and radius queries.
+//
+// Points are staged with addPoint() and bucketed by build() with a counting
+// sort into a CSR layout, so each cell's points are contiguous. Coordinates
+// can be in any space (screen pixels, metres, ...) as long as queries use the
+// same one. With the cell size set to the usual query radius, a query visits
+// at most 3x3 cells, so lookups cost O(1) regardless of how many points are
+// indexed. Rebuild when the points or the mapping to their space change.
+class SpatialGrid
+{
+public:
+    static constexpr int NO_POINT = -1;
+
+    explicit SpatialGrid(float cellSize = 16.0f);
+
+    // Cell edge length; grown automatically if the points span too many cells
+    void setCellSize(float cellSize);
+    float cellSize() const { return m_requestedCell; }
+
+    // Stage points for the next build(); id is returned by the queries
+    void clear();
+    void reserve(size_t count);
+    void addPoint(float x, float y, uint32_t id);
+    void build();
+
+    // Closest point within maxRadius (inclusive), or NO_POINT. Equal distances
+    // resolve to the lowest id.
+    int nearest(float x, float y, float maxRadius) const;
+
+    // Ids of all points within radius (inclusive), in cell order
+    void withinRadius(float x, float y, float radius, std::vector<uint32_t>& ids) const;
+
+    size_t size() const { return m_points.size(); }
+    bool empty() const { return m_points.empty(); }
+
+private:
+    struct Point {
+        float x;
+        float y;
+        uint32_t id;
+    };
+
+    bool cellRange(float x, float y, float radius, int& cx0, int& cy0, int& cx1, int& cy1) const;
+
+    float m_requestedCell;
+    float m_cell;
+    float m_minX, m_minY;
+    int m_cols, m_rows;
+
+    std::vector<Point> m_staged;
+    std::vector<Point> m_points;            // Sorted by cell
+    std::vector<uint32_t> m_cellStart;      // CSR offsets, cols*rows + 1
+    std::vector<uint32_t> m_cellOf;         // Scratch: cell of each staged point
+
+    static constexpr int MAX_GRID_CELLS = 65536;
+};
+
+#endif // SPATIALGRID_H
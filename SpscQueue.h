@@ -0,0 +1,70 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+// Bounded lock-free queue for exactly one producer and one consumer thread.
+//
+// A power-of-two ring indexed by free-running head/tail counters. Each side
+// only writes its own counter (release) and reads the other's (acquire), so
+// neither push() nor pop() ever blocks or takes a lock. The counters sit on
+// separate cache lines to avoid false sharing between the two threads.
+template<typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t cap = 2;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        m_items.resize(cap);
+        m_mask = cap - 1;
+    }
+
+    size_t capacity() const { return m_items.size(); }
+
+    // Producer side; false when full
+    bool push(const T& item)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == m_items.size()) {
+            return false;
+        }
+        m_items[tail & m_mask] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; false when empty
+    bool pop(T& item)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        // Move out so the slot does not keep a reference to the item alive
+        item = std::move(m_items[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> m_items;
+    size_t m_mask = 0;
+    alignas(CACHE_LINE) std::atomic<size_t> m_head{0};   // Next slot to pop
+    alignas(CACHE_LINE) std::atomic<size_t> m_tail{0};   // Next slot to push
+};
+
+#endif // SPSCQUEUE_H
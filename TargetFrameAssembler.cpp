@@ -0,0 +1,183 @@
+#include "TargetFrameAssembler.h"
+
+namespace {
+constexpr size_t MAX_SPARE_BUFFERS = 4;
+
+// Wrap-safe "a is newer than b" for 32-bit frame counters
+inline bool isNewer(uint32_t a, uint32_t b)
+{
+    return static_cast<int32_t>(a - b) > 0;
+}
+}
+
+TargetFrameAssembler::TargetFrameAssembler()
+    : m_hasOpen(false)
+    , m_openHasFrameId(false)
+    , m_lastPacketTime(0)
+    , m_lastPublishedId(0)
+    , m_havePublishedId(false)
+    , m_localSequence(0)
+{
+}
+
+void TargetFrameAssembler::addPacket(const TargetTrack& target, uint32_t expectedTargets,
+                                     const uint32_t* frameId, qint64 now)
+{
+    poll(now);
+
+    if (frameId) {
+        const bool sameAsOpen = m_hasOpen && m_openHasFrameId && m_open.frameId == *frameId;
+        if (!sameAsOpen && isRestart(*frameId)) {
+            // Ids restarted from a small value: nothing of the old sequence
+            // can follow, so start over instead of waiting for the data timeout
+            if (m_hasOpen) {
+                publishOpen();
+            }
+            m_havePublishedId = false;
+            ++m_stats.senderRestarts;
+        } else if (!sameAsOpen) {
+            // Drop stragglers of frames that have already been published
+            if ((m_hasOpen && m_openHasFrameId && !isNewer(*frameId, m_open.frameId)) ||
+                (m_havePublishedId && !isNewer(*frameId, m_lastPublishedId))) {
+                ++m_stats.latePackets;
+                return;
+            }
+            if (m_hasOpen) {
+                publishOpen();
+            }
+        }
+    } else if (m_hasOpen) {
+        // No frame id: infer the boundary from the packet stream
+        if (m_openHasFrameId ||
+            expectedTargets != m_open.expectedTargets ||
+            now - m_lastPacketTime > m_config.packetGapMs ||
+            containsTarget(target.target_id)) {
+            publishOpen();
+        }
+    }
+
+    if (!m_hasOpen) {
+        openFrame(expectedTargets, frameId, now);
+    }
+    m_lastPacketTime = now;
+
+    // An empty frame is complete as soon as it is announced
+    if (expectedTargets == 0) {
+        publishOpen();
+        return;
+    }
+
+    bool replaced = false;
+    if (frameId) {
+        for (TargetTrack& existing : m_open.targets) {
+            if (existing.target_id == target.target_id) {
+                existing = target;      // Retransmission within the frame
+                replaced = true;
+                break;
+            }
+        }
+    }
+    if (!replaced) {
+        m_open.targets.push_back(target);
+    }
+
+    if (m_open.targets.size() >= m_open.expectedTargets) {
+        publishOpen();
+    }
+}
+
+void TargetFrameAssembler::poll(qint64 now)
+{
+    if (m_hasOpen && now >= deadline()) {
+        publishOpen();
+    }
+}
+
+qint64 TargetFrameAssembler::deadline() const
+{
+    return m_hasOpen ? m_open.firstPacketTime + m_config.frameTimeoutMs : -1;
+}
+
+bool TargetFrameAssembler::takeFrame(Frame& out)
+{
+    if (m_ready.empty()) return false;
+
+    Frame& front = m_ready.front();
+    out.targets.swap(front.targets);
+    out.frameId = front.frameId;
+    out.expectedTargets = front.expectedTargets;
+    out.firstPacketTime = front.firstPacketTime;
+    out.complete = front.complete;
+
+    // The caller's previous buffer is reused for a later frame
+    if (m_spare.size() < MAX_SPARE_BUFFERS) {
+        front.targets.clear();
+        m_spare.push_back(std::move(front.targets));
+    }
+    m_ready.pop_front();
+    return true;
+}
+
+void TargetFrameAssembler::reset()
+{
+    m_open.targets.clear();
+    m_hasOpen = false;
+    m_openHasFrameId = false;
+    m_havePublishedId = false;
+    m_ready.clear();
+}
+
+void TargetFrameAssembler::openFrame(uint32_t expectedTargets, const uint32_t* frameId, qint64 now)
+{
+    if (!m_spare.empty()) {
+        m_open.targets.swap(m_spare.back());
+        m_spare.pop_back();
+    }
+    m_open.targets.clear();
+    m_open.frameId = frameId ? *frameId : ++m_localSequence;
+    m_open.expectedTargets = expectedTargets;
+    m_open.firstPacketTime = now;
+    m_open.complete = false;
+    m_openHasFrameId = (frameId != nullptr);
+    m_hasOpen = true;
+}
+
+void TargetFrameAssembler::publishOpen()
+{
+    m_open.complete = m_open.targets.size() >= m_open.expectedTargets;
+    if (m_open.complete) {
+        ++m_stats.completeFrames;
+    } else {
+        ++m_stats.partialFrames;
+    }
+    if (m_openHasFrameId) {
+        m_lastPublishedId = m_open.frameId;
+        m_havePublishedId = true;
+    }
+
+    m_ready.push_back(std::move(m_open));
+    m_open = Frame();
+    m_hasOpen = false;
+    m_openHasFrameId = false;
+}
+
+bool TargetFrameAssembler::isRestart(uint32_t frameId) const
+{
+    uint32_t newest;
+    if (m_hasOpen && m_openHasFrameId) {
+        newest = m_open.frameId;
+    } else if (m_havePublishedId) {
+        newest = m_lastPublishedId;
+    } else {
+        return false;
+    }
+    return isNewer(newest, frameId) && newest - frameId > m_config.restartFrameJump;
+}
+
+bool TargetFrameAssembler::containsTarget(uint32_t targetId) const
+{
+    for (const TargetTrack& t : m_open.targets) {
+        if (t.target_id == targetId) return true;
+    }
+    return false;
+}
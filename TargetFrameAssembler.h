@@ -0,0 +1,92 @@
+#ifndef TARGETFRAMEASSEMBLER_H
+#define TARGETFRAMEASSEMBLER_H
+
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <cstddef>
+#include <QtGlobal>
+#include "DataStructures.h"
+
+// Groups per-target UDP packets into frames with a bounded publish delay.
+//
+// Each TargetDataPacket_t carries one target and the frame's target count.
+// When the sender appends a frame id (see TargetFrameTrailer_t) packets are
+// grouped by it. Otherwise a frame boundary is inferred when the target
+// count changes, a target id repeats, or the gap since the previous packet
+// exceeds packetGapMs. A frame is published as soon as all its targets have
+// arrived, or as a partial frame once frameTimeoutMs has passed since its
+// first packet (the caller drives the deadline with poll()). A lost packet
+// therefore delays one frame by at most the timeout and never merges two.
+// Packets a few frames behind are dropped as late; a frame id further back
+// than restartFrameJump means the sender restarted and starts a new sequence.
+class TargetFrameAssembler
+{
+public:
+    struct Config {
+        qint64 frameTimeoutMs = 100;    // Longest wait for a frame's missing packets
+        qint64 packetGapMs = 40;        // Silence that ends a frame without frame ids
+        uint32_t restartFrameJump = 16; // Backwards id jump taken as a sender restart
+    };
+
+    struct Frame {
+        std::vector<TargetTrack> targets;
+        uint32_t frameId = 0;           // Sender's id, or a local sequence number
+        uint32_t expectedTargets = 0;
+        qint64 firstPacketTime = 0;     // ms
+        bool complete = false;
+    };
+
+    struct Stats {
+        uint64_t completeFrames = 0;
+        uint64_t partialFrames = 0;
+        uint64_t latePackets = 0;       // Packets for a frame already published
+        uint64_t senderRestarts = 0;    // Frame id sequences restarted
+    };
+
+    TargetFrameAssembler();
+
+    void setConfig(const Config& config) { m_config = config; }
+    const Config& config() const { return m_config; }
+
+    // Add one target packet received at `now`. `frameId` is null when the
+    // packet carries no frame id.
+    void addPacket(const TargetTrack& target, uint32_t expectedTargets,
+                   const uint32_t* frameId, qint64 now);
+
+    // Publish the open frame as partial if its deadline has passed
+    void poll(qint64 now);
+
+    // Deadline of the open frame, or -1 when no frame is open
+    qint64 deadline() const;
+
+    // Pop the oldest published frame; false when none is ready
+    bool takeFrame(Frame& out);
+
+    // Open frame progress, for status display
+    size_t openTargets() const { return m_open.targets.size(); }
+    uint32_t openExpected() const { return m_hasOpen ? m_open.expectedTargets : 0; }
+
+    const Stats& stats() const { return m_stats; }
+    void reset();
+
+private:
+    void openFrame(uint32_t expectedTargets, const uint32_t* frameId, qint64 now);
+    void publishOpen();
+    bool containsTarget(uint32_t targetId) const;
+    bool isRestart(uint32_t frameId) const;
+
+    Config m_config;
+    Frame m_open;
+    bool m_hasOpen;
+    bool m_openHasFrameId;
+    qint64 m_lastPacketTime;
+    uint32_t m_lastPublishedId;     // Sender frame id of the last published frame
+    bool m_havePublishedId;
+    uint32_t m_localSequence;       // Frame numbering when the sender sends no ids
+    std::deque<Frame> m_ready;
+    std::vector<std::vector<TargetTrack>> m_spare;  // Recycled target buffers
+    Stats m_stats;
+};
+
+#endif // TARGETFRAMEASSEMBLER_H
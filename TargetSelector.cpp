@@ -0,0 +1,99 @@
+#include "TargetSelector.h"
+#include "structures.h"
+#include <algorithm>
+#include <cmath>
+
+bool TargetSelector::Config::operator==(const Config& other) const
+{
+    return minRange == other.minRange
+        && minSpeedKmh == other.minSpeedKmh
+        && showReceding == other.showReceding
+        && showApproaching == other.showApproaching
+        && mode == other.mode
+        && maxTargets == other.maxTargets
+        && direction == other.direction;
+}
+
+void TargetSelector::applySelectionSettings(const DSP_Settings_Extended_t& settings, Config& config)
+{
+    config.mode = settings.target_selection_mode <= static_cast<uint8_t>(Mode::Strongest)
+                      ? static_cast<Mode>(settings.target_selection_mode)
+                      : Mode::All;
+    config.maxTargets = settings.max_targets;
+    config.direction = settings.direction_filter <= static_cast<uint8_t>(Direction::Receding)
+                           ? static_cast<Direction>(settings.direction_filter)
+                           : Direction::Both;
+}
+
+bool TargetSelector::passesDisplayFilters(const TargetTrack& track, float minRange, float minSpeedKmh,
+                                          bool showReceding, bool showApproaching)
+{
+    // Filter by minimum range
+    if (track.radius < minRange) {
+        return false;
+    }
+
+    // Filter by minimum velocity (absolute value, convert m/s to kph)
+    if (std::abs(track.radial_speed * 3.6f) < minSpeedKmh) {
+        return false;
+    }
+
+    // If neither direction is checked, allow all
+    if (!showReceding && !showApproaching) {
+        return true;
+    }
+    return (showReceding && track.radial_speed < 0) || (showApproaching && track.radial_speed > 0);
+}
+
+void TargetSelector::select(const TargetTrackData& targets)
+{
+    const size_t n = std::min<size_t>(targets.numTracks, targets.targets.size());
+    const TargetTrack* tracks = targets.targets.data();
+    const Config& c = m_config;
+
+    // Single filtering pass
+    m_indices.clear();
+    m_indices.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        const TargetTrack& t = tracks[i];
+        if (!passesDisplayFilters(t, c.minRange, c.minSpeedKmh, c.showReceding, c.showApproaching)) {
+            continue;
+        }
+        if ((c.direction == Direction::Approaching && !(t.radial_speed > 0)) ||
+            (c.direction == Direction::Receding && !(t.radial_speed < 0))) {
+            continue;
+        }
+        m_indices.push_back(static_cast<uint32_t>(i));
+    }
+
+    if (c.mode == Mode::All) return;
+
+    // "Better" ordering for the selection mode; ties keep frame order
+    auto better = [tracks, mode = c.mode](uint32_t a, uint32_t b) {
+        float ka = 0.0f, kb = 0.0f;
+        switch (mode) {
+        case Mode::Nearest:   ka = -tracks[a].radius;                 kb = -tracks[b].radius; break;
+        case Mode::Fastest:   ka = std::abs(tracks[a].radial_speed);  kb = std::abs(tracks[b].radial_speed); break;
+        case Mode::Strongest: ka = tracks[a].level;                   kb = tracks[b].level; break;
+        case Mode::All:       break;
+        }
+        return ka > kb || (ka == kb && a < b);
+    };
+
+    const size_t keep = (c.maxTargets == 0) ? m_indices.size()
+                                             : std::min<size_t>(c.maxTargets, m_indices.size());
+    if (keep < m_indices.size()) {
+        std::nth_element(m_indices.begin(), m_indices.begin() + keep, m_indices.end(), better);
+        m_indices.resize(keep);
+    }
+    std::sort(m_indices.begin(), m_indices.end(), better);
+}
+
+void TargetSelector::materialise(const TargetTrackData& targets, TargetTrackData& out) const
+{
+    out.targets.resize(m_indices.size());
+    for (size_t i = 0; i < m_indices.size(); ++i) {
+        out.targets[i] = targets.targets[m_indices[i]];
+    }
+    out.numTracks = static_cast<uint32_t>(out.targets.size());
+}
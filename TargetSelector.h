@@ -0,0 +1,76 @@
+#ifndef TARGETSELECTOR_H
+#define TARGETSELECTOR_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "DataStructures.h"
+
+struct DSP_Settings_Extended_t;
+
+// Display filter and target selection, evaluated in one pass per frame.
+//
+// select() walks the frame's tracks once, applying the range/speed/direction
+// display filters and the DSP direction filter together, and records the
+// indices of the survivors. Top-N modes (nearest, fastest, strongest) then
+// run std::nth_element over that index list and sort only the N kept
+// entries. The result is an index view into the source frame; materialise()
+// copies it into a TargetTrackData for widgets that take one.
+class TargetSelector
+{
+public:
+    enum class Mode : uint8_t {
+        All = 0,
+        Nearest = 1,
+        Fastest = 2,
+        Strongest = 3
+    };
+
+    enum class Direction : uint8_t {
+        Both = 0,
+        Approaching = 1,    // radial_speed > 0
+        Receding = 2        // radial_speed < 0
+    };
+
+    struct Config {
+        // Display filters (track filter panel)
+        float minRange = 0.0f;              // m
+        float minSpeedKmh = 0.0f;           // |radial speed|
+        bool showReceding = false;          // Neither set: both directions shown
+        bool showApproaching = false;
+
+        // Target selection (DSP_Settings_Extended_t)
+        Mode mode = Mode::All;
+        uint32_t maxTargets = 0;            // Top-N count for non-All modes; 0 = no limit
+        Direction direction = Direction::Both;
+
+        bool operator==(const Config& other) const;
+        bool operator!=(const Config& other) const { return !(*this == other); }
+    };
+
+    void setConfig(const Config& config) { m_config = config; }
+    const Config& config() const { return m_config; }
+
+    // Copy the target-selection fields of the DSP settings into the config
+    static void applySelectionSettings(const DSP_Settings_Extended_t& settings, Config& config);
+
+    // Display-filter predicate shared with the track filter panel
+    static bool passesDisplayFilters(const TargetTrack& track, float minRange, float minSpeedKmh,
+                                     bool showReceding, bool showApproaching);
+
+    // Build the index view for this frame
+    void select(const TargetTrackData& targets);
+
+    // Indices into the frame passed to select(), in display order
+    const std::vector<uint32_t>& indices() const { return m_indices; }
+    size_t size() const { return m_indices.size(); }
+
+    // Copy the selected tracks into out (reuses out's storage)
+    void materialise(const TargetTrackData& targets, TargetTrackData& out) const;
+
+private:
+    Config m_config;
+    std::vector<uint32_t> m_indices;
+};
+
+#endif // TARGETSELECTOR_H
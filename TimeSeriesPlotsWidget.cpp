@@ -1,4 +1,5 @@
 #include "TimeSeriesPlotsWidget.h"
+#include "TargetSelector.h"
 #include <QPaintEvent>
 #include <QResizeEvent>
 #include <QPainterPath>
@@ -14,7 +15,6 @@
 #include <QDebug>
 // ==================== DigitalRangeRateDisplay Implementation ====================
 
-unsigned long int iCount=0;
 DigitalRangeRateDisplay::DigitalRangeRateDisplay(QWidget *parent)
     : QWidget(parent)
     , m_targetValue(0.0f)
@@ -200,6 +200,7 @@ TimeSeriesPlotWidget::TimeSeriesPlotWidget(QWidget *parent)
     , m_defaultMaxY(100.0f)
     , m_timeWindowSeconds(60)
     , m_pointSize(4)
+    , m_currentTime(QDateTime::currentMSecsSinceEpoch())
     , m_marginLeft(70)
     , m_marginRight(20)
     , m_marginTop(20)
@@ -210,6 +211,12 @@ TimeSeriesPlotWidget::TimeSeriesPlotWidget(QWidget *parent)
     , m_panOffsetY(0.0f)
     , m_hoveredPointIndex(-1)
     , m_showTooltip(false)
+    , m_hitIndex(HOVER_RADIUS)
+    , m_hitIndexDirty(true)
+    , m_hitIndexOrigin(0)
+    , m_hitIndexMinY(0.0f)
+    , m_hitIndexMaxY(0.0f)
+    , m_hitIndexWindow(0)
     , m_cleanupTimer(nullptr)
 {
     // No hard-coded minimum size to allow responsive layout
@@ -274,12 +281,14 @@ void TimeSeriesPlotWidget::setTimeWindowSeconds(int seconds)
 void TimeSeriesPlotWidget::clearData()
 {
     m_dataPoints.clear();
+    m_hitIndexDirty = true;
     update();
 }
 
 void TimeSeriesPlotWidget::addDataPoint(qint64 timestamp, float value)
 {
     m_dataPoints.append(qMakePair(timestamp, value));
+    m_hitIndexDirty = true;
     
     // DISABLED: Don't automatically clear old data - retain all data until user clicks "Clear All Data" button
     // cleanupOldData();
@@ -289,7 +298,7 @@ void TimeSeriesPlotWidget::addDataPoint(qint64 timestamp, float value)
 
 void TimeSeriesPlotWidget::cleanupOldData()
 {
-    qint64 cutoffTime = QDateTime::currentMSecsSinceEpoch() - (m_timeWindowSeconds * 1000);
+    qint64 cutoffTime = m_currentTime - (m_timeWindowSeconds * 1000);
     
     // Remove all data points older than the time window
     while (!m_dataPoints.isEmpty() && m_dataPoints.first().first < cutoffTime) {
@@ -300,6 +309,7 @@ void TimeSeriesPlotWidget::cleanupOldData()
     while (m_dataPoints.size() > MAX_DATA_POINTS) {
         m_dataPoints.removeFirst();
     }
+    m_hitIndexDirty = true;
     
     // Trigger repaint if data was removed
     update();
@@ -430,8 +440,7 @@ void TimeSeriesPlotWidget::drawData(QPainter& painter)
 {
     if (m_dataPoints.isEmpty()) return;
     
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    qint64 startTime = currentTime - (m_timeWindowSeconds * 1000);
+    qint64 startTime = m_currentTime - (m_timeWindowSeconds * 1000);
     
     // Draw as scatter plot (point cloud) with filled circles
     painter.setPen(Qt::NoPen);
@@ -502,10 +511,9 @@ void TimeSeriesPlotWidget::drawLabels(QPainter& painter)
     }
     
     // X-axis tick labels (time) - always show even with no data
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
     int numXTicks = 4;
     for (int i = 0; i <= numXTicks; ++i) {
-        qint64 tickTime = currentTime - m_timeWindowSeconds * 1000 + 
+        qint64 tickTime = m_currentTime - m_timeWindowSeconds * 1000 + 
                           (m_timeWindowSeconds * 1000 * i / numXTicks);
         QDateTime dt = QDateTime::fromMSecsSinceEpoch(tickTime);
         QString timeStr = dt.toString("hh:mm:ss");
@@ -575,8 +583,7 @@ void TimeSeriesPlotWidget::drawTooltip(QPainter& painter)
 
 QPointF TimeSeriesPlotWidget::dataToScreen(qint64 timestamp, float value) const
 {
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    qint64 startTime = currentTime - (m_timeWindowSeconds * 1000);
+    qint64 startTime = m_currentTime - (m_timeWindowSeconds * 1000);
     
     float timeRatio = float(timestamp - startTime) / float(m_timeWindowSeconds * 1000);
     float x = m_plotRect.left() + timeRatio * m_plotRect.width();
@@ -593,8 +600,7 @@ bool TimeSeriesPlotWidget::screenToData(const QPoint& screenPos, qint64& timesta
         return false;
     }
     
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    qint64 startTime = currentTime - (m_timeWindowSeconds * 1000);
+    qint64 startTime = m_currentTime - (m_timeWindowSeconds * 1000);
     
     float timeRatio = float(screenPos.x() - m_plotRect.left()) / m_plotRect.width();
     timestamp = startTime + qint64(timeRatio * m_timeWindowSeconds * 1000);
@@ -611,27 +617,37 @@ int TimeSeriesPlotWidget::findNearestPoint(const QPoint& pos) const
         return -1;
     }
     
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    qint64 startTime = currentTime - (m_timeWindowSeconds * 1000);
+    if (m_hitIndexDirty || m_hitIndexRect != m_plotRect || m_hitIndexWindow != m_timeWindowSeconds ||
+        m_hitIndexMinY != m_minY || m_hitIndexMaxY != m_maxY) {
+        rebuildHitIndex();
+    }
     
-    int nearestIndex = -1;
-    float minDistance = 20.0f;  // Maximum distance to consider
+    // Screen x of the index origin for the current time window
+    const float originX = static_cast<float>(dataToScreen(m_hitIndexOrigin, m_minY).x());
+    return m_hitIndex.nearest(pos.x() - originX, static_cast<float>(pos.y()), HOVER_RADIUS);
+}
+
+void TimeSeriesPlotWidget::rebuildHitIndex() const
+{
+    m_hitIndexOrigin = m_dataPoints.isEmpty() ? 0 : m_dataPoints.first().first;
+    m_hitIndexRect = m_plotRect;
+    m_hitIndexWindow = m_timeWindowSeconds;
+    m_hitIndexMinY = m_minY;
+    m_hitIndexMaxY = m_maxY;
     
+    // Same mapping as dataToScreen(), with x relative to the origin sample
+    const float pixelsPerMs = m_plotRect.width() / float(m_timeWindowSeconds * 1000);
+    m_hitIndex.clear();
+    m_hitIndex.reserve(m_dataPoints.size());
     for (int i = 0; i < m_dataPoints.size(); ++i) {
         const auto& point = m_dataPoints[i];
-        QPointF screenPos = dataToScreen(point.first, point.second);
-        
-        float dx = screenPos.x() - pos.x();
-        float dy = screenPos.y() - pos.y();
-        float distance = std::sqrt(dx * dx + dy * dy);
-        
-        if (distance < minDistance) {
-            minDistance = distance;
-            nearestIndex = i;
-        }
+        const float x = float(point.first - m_hitIndexOrigin) * pixelsPerMs;
+        const float valueRatio = (point.second - m_minY) / (m_maxY - m_minY);
+        const float y = m_plotRect.bottom() - valueRatio * m_plotRect.height();
+        m_hitIndex.addPoint(x, y, static_cast<uint32_t>(i));
     }
-    
-    return nearestIndex;
+    m_hitIndex.build();
+    m_hitIndexDirty = false;
 }
 
 void TimeSeriesPlotWidget::mouseMoveEvent(QMouseEvent *event)
@@ -747,6 +763,9 @@ RangeVelocityPlotWidget::RangeVelocityPlotWidget(QWidget *parent)
     , m_panOffsetY(0.0f)
     , m_hoveredPointIndex(-1)
     , m_showTooltip(false)
+    , m_hitIndex(HOVER_RADIUS)
+    , m_hitIndexDirty(true)
+    , m_hitIndexLimits{0.0f, 0.0f, 0.0f, 0.0f}
 {
     // No hard-coded minimum size to allow responsive layout
     setBackgroundRole(QPalette::Base);
@@ -823,6 +842,7 @@ void RangeVelocityPlotWidget::onResetZoom()
 void RangeVelocityPlotWidget::clearData()
 {
     m_dataPoints.clear();
+    m_hitIndexDirty = true;
     m_velocityHistogram.fill(0);
     m_rangeHistogram.fill(0);
     update();
@@ -831,6 +851,7 @@ void RangeVelocityPlotWidget::clearData()
 void RangeVelocityPlotWidget::addDataPoint(float velocity, float range)
 {
     m_dataPoints.append(qMakePair(velocity, range));
+    m_hitIndexDirty = true;
     
     // Update histograms
     if (m_showHistogram) {
@@ -1162,12 +1183,28 @@ int RangeVelocityPlotWidget::findNearestPoint(const QPoint& pos) const
         return -1;
     }
     
-    int nearestIndex = -1;
-    float minDistance = 20.0f;  // Maximum distance to consider
+    if (m_hitIndexDirty || m_hitIndexRect != m_plotRect ||
+        m_hitIndexLimits[0] != m_minVelocity || m_hitIndexLimits[1] != m_maxVelocity ||
+        m_hitIndexLimits[2] != m_minRange || m_hitIndexLimits[3] != m_maxRange) {
+        rebuildHitIndex();
+    }
+    
+    return m_hitIndex.nearest(static_cast<float>(pos.x()), static_cast<float>(pos.y()), HOVER_RADIUS);
+}
+
+void RangeVelocityPlotWidget::rebuildHitIndex() const
+{
+    m_hitIndexRect = m_plotRect;
+    m_hitIndexLimits[0] = m_minVelocity;
+    m_hitIndexLimits[1] = m_maxVelocity;
+    m_hitIndexLimits[2] = m_minRange;
+    m_hitIndexLimits[3] = m_maxRange;
     
     float velocityRange = m_maxVelocity - m_minVelocity;
     float rangeRange = m_maxRange - m_minRange;
     
+    m_hitIndex.clear();
+    m_hitIndex.reserve(m_dataPoints.size());
     for (int i = 0; i < m_dataPoints.size(); ++i) {
         const auto& point = m_dataPoints[i];
         float velocity = point.first;
@@ -1184,20 +1221,13 @@ int RangeVelocityPlotWidget::findNearestPoint(const QPoint& pos) const
         
         if (xRatio < 0 || xRatio > 1 || yRatio < 0 || yRatio > 1) continue;
         
+        // Same pixel positions drawDataPoints() uses
         int x = m_plotRect.left() + int(xRatio * m_plotRect.width());
         int y = m_plotRect.bottom() - int(yRatio * m_plotRect.height());
-        
-        float dx = x - pos.x();
-        float dy = y - pos.y();
-        float distance = std::sqrt(dx * dx + dy * dy);
-        
-        if (distance < minDistance) {
-            minDistance = distance;
-            nearestIndex = i;
-        }
+        m_hitIndex.addPoint(static_cast<float>(x), static_cast<float>(y), static_cast<uint32_t>(i));
     }
-    
-    return nearestIndex;
+    m_hitIndex.build();
+    m_hitIndexDirty = false;
 }
 
 void RangeVelocityPlotWidget::mouseMoveEvent(QMouseEvent *event)
@@ -1317,13 +1347,9 @@ TimeSeriesPlotsWidget::TimeSeriesPlotsWidget(QWidget *parent)
     , m_filterMovingAvgSize(1)
     , m_filterReceding(true)
     , m_filterApproaching(true)
-    , m_previousRangeRate(0.0f)
-    , m_currentRangeRate(0.0f)
-    , m_rangeRateMovingAvg(0.0f)
     , m_lastDataReceivedTime(0)
     , m_cleanupTimer(nullptr)
     , m_isFilterLoggingActive(false)
-    , m_filterLogFile(nullptr)
     , m_filterLogFilename("")
 {
     setupUI();
@@ -1487,8 +1513,8 @@ void TimeSeriesPlotsWidget::setupFilterControls()
     filterLayout->addWidget(minVelocityLabel);
     filterLayout->addWidget(m_filterMinVelocitySpinBox);
     
-    // Moving Avg size
-    QLabel* movingAvgLabel = new QLabel("Moving Avg size", this);
+    // Kalman filter smoothing (1 = follows measurements closely, 20 = heaviest smoothing)
+    QLabel* movingAvgLabel = new QLabel("Filter smoothing", this);
     m_filterMovingAvgSpinBox = new QSpinBox(this);
     m_filterMovingAvgSpinBox->setRange(1, 20);
     m_filterMovingAvgSpinBox->setValue(1);  // Default: 1
@@ -1674,9 +1700,22 @@ void TimeSeriesPlotsWidget::setupSettingsPanel()
     settingsLayout->addLayout(buttonLayout);
 }
 
-void TimeSeriesPlotsWidget::updateFromTargets(const TargetTrackData& targets)
+void TimeSeriesPlotsWidget::setCurrentTime(qint64 currentTime)
+{
+    if (m_velocityTimePlot) {
+        m_velocityTimePlot->setCurrentTime(currentTime);
+    }
+    if (m_rangeTimePlot) {
+        m_rangeTimePlot->setCurrentTime(currentTime);
+    }
+    if (m_rangeRatePlot) {
+        m_rangeRatePlot->setCurrentTime(currentTime);
+    }
+}
+
+void TimeSeriesPlotsWidget::updateFromTargets(const TargetTrackData& targets, qint64 currentTime)
 {
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+    setCurrentTime(currentTime);
     
     // Check if no tracks are received at all
     if (targets.numTracks == 0) {
@@ -1730,52 +1769,58 @@ void TimeSeriesPlotsWidget::updateFromTargets(const TargetTrackData& targets)
     
     bool anyTrackPassed = false;
     
+    // Stage every passing track in the Kalman bank, then update them all in one pass
+    m_passedTrackIndices.clear();
     for (size_t i = 0; i < targets.numTracks && i < targets.targets.size(); ++i) {
         const auto& target = targets.targets[i];
         // Preserve sign for velocity (can be positive or negative)
         float velocityKmh = target.radial_speed;// * 3.6f;  // Convert m/s to km/h
-        qDebug()<<"target.radial_speed=="<<target.radial_speed;
-        float rangeM = target.radius;
         
         // Apply filters
         if (!passesFilters(target, velocityKmh)) {
             continue;  // Skip this track if it doesn't pass filters
         }
         
-        anyTrackPassed = true;
+        // Report time, so the same report seen on several display refreshes is absorbed once
+        qint64 reportTime = target.lastUpdateTime > 0 ? target.lastUpdateTime : currentTime;
+        m_trackFilter.addMeasurement(target.target_id, reportTime, target.radius, target.azimuth);
+        m_passedTrackIndices.push_back(i);
+    }
+    m_trackFilter.step();
+    
+    for (size_t i : m_passedTrackIndices) {
+        const auto& target = targets.targets[i];
+        float velocityKmh = target.radial_speed;
         
-        // Apply moving average to range and velocity
-        float avgRangeM = applyMovingAverage(target.target_id, rangeM);
-        float avgVelocityKmh = applyMovingAverage(target.target_id + 1000000, velocityKmh);  // Use offset ID for velocity buffer
+        KalmanFilterBank::Estimate estimate;
+        if (!m_trackFilter.estimate(target.target_id, estimate)) {
+            continue;
+        }
         
-        // Log filtered trackdata to D drive (after filters pass, before range rate computation)
-        logFilteredTrackData(target, velocityKmh, avgRangeM, currentTime);
+        anyTrackPassed = true;
         
-        // Calculate range rate (dR/dT)
-        float rangeRateKmh = calculateRangeRate(target.target_id, avgRangeM, currentTime);
+        float filteredRangeM = estimate.range;
+        float rangeRateKmh = estimate.rangeRate * 3.6f;  // Convert m/s to kph
         
-        // Calculate moving average of range rate: (previous + current) / 2
-        m_currentRangeRate = rangeRateKmh;
-        m_rangeRateMovingAvg = (m_previousRangeRate + m_currentRangeRate) / 2.0f;
-        m_previousRangeRate = m_currentRangeRate;
+        // Log filtered trackdata to D drive
+        logFilteredTrackData(target, velocityKmh, filteredRangeM, currentTime);
         
-        // Update range rate display
+        // Update range rate display with the filtered estimate
         if (m_rangeRateDisplay) {
-            //m_rangeRateDisplay->setValue(m_rangeRateMovingAvg);
-            m_rangeRateDisplay->setValue(velocityKmh);
+            m_rangeRateDisplay->setValue(rangeRateKmh);
         }
         
         // Update range-velocity plot (preserves velocity sign)
         if (m_rangeVelocityPlot) {
-            m_rangeVelocityPlot->addDataPoint(avgVelocityKmh, avgRangeM);
+            m_rangeVelocityPlot->addDataPoint(velocityKmh, filteredRangeM);
         }
         
         // Update time series plots (velocity preserves sign)
         if (m_velocityTimePlot) {
-            m_velocityTimePlot->addDataPoint(currentTime, avgVelocityKmh);
+            m_velocityTimePlot->addDataPoint(currentTime, velocityKmh);
         }
         if (m_rangeTimePlot) {
-            m_rangeTimePlot->addDataPoint(currentTime, avgRangeM);
+            m_rangeTimePlot->addDataPoint(currentTime, filteredRangeM);
         }
         if (m_rangeRatePlot) {
             m_rangeRatePlot->addDataPoint(currentTime, rangeRateKmh);
@@ -2024,9 +2069,8 @@ void TimeSeriesPlotsWidget::clearAllData()
         m_rangeRateDisplay->clearValue();
     }
     
-    // Clear track history and moving average buffers
-    m_trackHistory.clear();
-    m_movingAvgBuffer.clear();
+    // Restart all track filters
+    m_trackFilter.clear();
 }
 
 void TimeSeriesPlotsWidget::applyTheme()
@@ -2358,9 +2402,9 @@ void TimeSeriesPlotsWidget::onFilterMinVelocityChanged(double value)
 void TimeSeriesPlotsWidget::onFilterMovingAvgChanged(int value)
 {
     m_filterMovingAvgSize = value;
-    // Clear moving average buffers when size changes
-    m_movingAvgBuffer.clear();
-    // Note: moving avg doesn't affect PPI/table filtering, but emit for consistency
+    // Higher smoothing = lower process noise (trusts the motion model more)
+    m_trackFilter.setProcessNoise(RANGE_PROCESS_NOISE / value, AZIMUTH_PROCESS_NOISE / value);
+    // Note: smoothing doesn't affect PPI/table filtering
 }
 
 void TimeSeriesPlotsWidget::onFilterDirectionChanged()
@@ -2377,35 +2421,8 @@ bool TimeSeriesPlotsWidget::trackPassesFilters(const TargetTrack& track,
                                                 bool filterReceding,
                                                 bool filterApproaching)
 {
-    // Filter by minimum range
-    if (track.radius < filterMinRange) {
-        return false;
-    }
-    
-    // Filter by minimum velocity (absolute value, convert m/s to kph)
-    float velocityKmh = std::abs(track.radial_speed * 3.6f);
-    if (velocityKmh < filterMinVelocityKph) {
-        return false;
-    }
-    
-    // Filter by direction (receding = negative velocity, approaching = positive velocity)
-    bool isReceding = (track.radial_speed < 0);
-    bool isApproaching = (track.radial_speed > 0);
-    
-    // If neither filter is checked, allow all
-    if (!filterReceding && !filterApproaching) {
-        return true;
-    }
-    
-    // Check direction filters
-    if (filterReceding && isReceding) {
-        return true;
-    }
-    if (filterApproaching && isApproaching) {
-        return true;
-    }
-    
-    return false;
+    return TargetSelector::passesDisplayFilters(track, filterMinRange, filterMinVelocityKph,
+                                                filterReceding, filterApproaching);
 }
 
 // Check if a track passes all filters (instance method delegates to static)
@@ -2441,80 +2458,6 @@ bool TimeSeriesPlotsWidget::passesFilters(const TargetTrack& track, float veloci
     return false;
 }
 
-// Apply moving average to a value
-float TimeSeriesPlotsWidget::applyMovingAverage(uint32_t trackId, float value)
-{
-    if (m_filterMovingAvgSize <= 1) {
-        return value;  // No averaging needed
-    }
-    
-    // Get or create buffer for this track
-    if (!m_movingAvgBuffer.contains(trackId)) {
-        m_movingAvgBuffer[trackId] = QVector<float>();
-    }
-    
-    QVector<float>& buffer = m_movingAvgBuffer[trackId];
-    buffer.append(value);
-    
-    // Keep only the last N values
-    while (buffer.size() > m_filterMovingAvgSize) {
-        buffer.removeFirst();
-    }
-    
-    // Calculate average
-    float sum = 0.0f;
-    for (float v : buffer) {
-        sum += v;
-    }
-    
-    return sum / buffer.size();
-}
-
-// Calculate range rate (dR/dT) in kph
-float TimeSeriesPlotsWidget::calculateRangeRate(uint32_t trackId, float currentRange, qint64 timestamp)
-{
-    // Get or create history for this track
-    if (!m_trackHistory.contains(trackId)) {
-        m_trackHistory[trackId] = QVector<TrackHistory>();
-    }
-    
-    QVector<TrackHistory>& history = m_trackHistory[trackId];
-    
-    float rangeRate = 0.0f;
-    
-    bool iCntMet = ((iCount%6)==0)?true:false;
-
-       // If we have previous data, calculate range rate
-       if(iCntMet)
-       {
-           qDebug()<<"iCntMet Met"<<iCntMet<<iCount;
-           if (!history.isEmpty()) {
-               const TrackHistory& lastPoint = history.last();
-               float dR = currentRange - lastPoint.range;  // meters
-               float dT = (timestamp - lastPoint.timestamp) / 1000.0f;  // convert ms to seconds
-
-               if (dT > 0.001f) {  // Avoid division by zero
-                   rangeRate = (dR / dT) * 3.6f;  // Convert m/s to kph
-               }
-           }
-
-           // Add current point to history
-           TrackHistory current;
-           current.timestamp = timestamp;
-           current.range = currentRange;
-           history.append(current);
-
-           // Keep only the last 10 points per track to avoid memory growth
-           while (history.size() > 10) {
-               history.removeFirst();
-           }
-       }
-
-       iCount++;
-       return rangeRate;
-   }
-
-
 // Create timestamped filename for filtered trackdata logging
 QString TimeSeriesPlotsWidget::createFilterLogFilename()
 {
@@ -2522,8 +2465,8 @@ QString TimeSeriesPlotsWidget::createFilterLogFilename()
     QDateTime now = QDateTime::currentDateTime();
     QString timestamp = now.toString("yyyyMMdd_HHmmss");
     
-    // Create filename: trackdata_filter_<timestamp>.csv
-    QString filename = QString("trackdata_filter_%1.csv").arg(timestamp);
+    // Create filename: trackdata_filter_<timestamp>.trk
+    QString filename = QString("trackdata_filter_%1.trk").arg(timestamp);
     
     // Construct full path to D drive
     QString fullPath = QString("D:/%1").arg(filename);
@@ -2531,59 +2474,36 @@ QString TimeSeriesPlotsWidget::createFilterLogFilename()
     return fullPath;
 }
 
-// Log filtered trackdata to CSV file on D drive
+// Log filtered trackdata to a binary recording on D drive
 void TimeSeriesPlotsWidget::logFilteredTrackData(const TargetTrack& target, float velocityKmh, float avgRangeM, qint64 currentTime)
 {
     // Only log if filter logging is active
-    if (!m_isFilterLoggingActive || !m_filterLogFile) {
+    if (!m_isFilterLoggingActive) {
         return;
     }
     
-    QTextStream out(m_filterLogFile);
-    
-    // Write data row
-    out << currentTime << ","
-        << target.target_id << ","
-        << target.level << ","
-        << target.radius << ","
-        << target.azimuth << ","
-        << target.elevation << ","
-        << target.radial_speed << ","
-        << target.azimuth_speed << ","
-        << target.elevation_speed << ","
-        << velocityKmh << ","
-        << avgRangeM << "\n";
-    
-    // Flush to ensure data is written immediately
-    out.flush();
+    // Written on the recorder thread; export to CSV from File menu
+    m_filterRecorder.record(TrackRecord::fromTarget(target, currentTime, velocityKmh, avgRangeM));
 }
 
 // Start filter logging
 void TimeSeriesPlotsWidget::startFilterLogging()
 {
     // If already logging, close existing file first
-    if (m_filterLogFile) {
+    if (m_filterRecorder.isRecording()) {
         stopFilterLogging();
     }
     
     // Create timestamped filename
     m_filterLogFilename = createFilterLogFilename();
     
-    // Create and open new log file
-    m_filterLogFile = new QFile(m_filterLogFilename);
-    
-    if (!m_filterLogFile->open(QIODevice::WriteOnly | QIODevice::Text)) {
+    // Create the recording; the header is written here, records on the recorder thread
+    if (!m_filterRecorder.start(QFile::encodeName(m_filterLogFilename).toStdString(),
+                                TrackRecordKind::Filtered, QDateTime::currentMSecsSinceEpoch())) {
         qWarning() << "Failed to open trackdata filter log file:" << m_filterLogFilename;
-        delete m_filterLogFile;
-        m_filterLogFile = nullptr;
         return;
     }
     
-    // Write CSV header
-    QTextStream out(m_filterLogFile);
-    out << "Timestamp_ms,Target_ID,Level_dB,Range_m,Azimuth_deg,Elevation_deg,Radial_Speed_m_s,Azimuth_Speed_deg_s,Elevation_Speed_deg_s,Velocity_kmh,Avg_Range_m\n";
-    out.flush();
-    
     // Set logging active
     m_isFilterLoggingActive = true;
     
@@ -2593,12 +2513,12 @@ void TimeSeriesPlotsWidget::startFilterLogging()
 // Stop filter logging
 void TimeSeriesPlotsWidget::stopFilterLogging()
 {
-    if (m_filterLogFile) {
-        m_filterLogFile->close();
-        delete m_filterLogFile;
-        m_filterLogFile = nullptr;
+    if (m_filterRecorder.isRecording()) {
+        m_filterRecorder.stop();
         
-        qDebug() << "Filter logging stopped. File saved:" << m_filterLogFilename;
+        qDebug() << "Filter logging stopped. File saved:" << m_filterLogFilename
+                 << "(" << m_filterRecorder.recordsWritten() << "records,"
+                 << m_filterRecorder.recordsDropped() << "dropped)";
     }
     
     m_isFilterLoggingActive = false;
@@ -21,6 +21,9 @@
 #include <QMap>
 #include <QPropertyAnimation>
 #include "DataStructures.h"
+#include "KalmanFilterBank.h"
+#include "TrackRecorder.h"
+#include "SpatialGrid.h"
 
 // Structure to hold time series data point
 struct TimeSeriesDataPoint {
@@ -47,6 +50,10 @@ public:
     void setPointSize(int size);
     void clearData();
     
+    // Pipeline time at the right edge of the time axis (ms since epoch).
+    // Replays advance it with their recorded times; repainted on the next update
+    void setCurrentTime(qint64 currentTime) { m_currentTime = currentTime; }
+    
     // Add data point
     void addDataPoint(qint64 timestamp, float value);
     
@@ -83,6 +90,7 @@ private:
     QPointF dataToScreen(qint64 timestamp, float value) const;
     bool screenToData(const QPoint& screenPos, qint64& timestamp, float& value) const;
     int findNearestPoint(const QPoint& pos) const;
+    void rebuildHitIndex() const;
     
     // Theme colors
     QColor getBackgroundColor() const;
@@ -105,6 +113,7 @@ private:
     float m_defaultMaxY;
     int m_timeWindowSeconds;  // How many seconds of data to display
     int m_pointSize;  // Point radius in pixels
+    qint64 m_currentTime;  // Right edge of the time axis
     
     // Layout
     QRect m_plotRect;
@@ -127,11 +136,22 @@ private:
     QPoint m_mousePos;
     bool m_showTooltip;
     
+    // Hover index in pixels; x is measured from m_hitIndexOrigin so the
+    // scrolling time window only shifts queries instead of forcing a rebuild
+    mutable SpatialGrid m_hitIndex;
+    mutable bool m_hitIndexDirty;
+    mutable qint64 m_hitIndexOrigin;
+    mutable QRect m_hitIndexRect;
+    mutable float m_hitIndexMinY;
+    mutable float m_hitIndexMaxY;
+    mutable int m_hitIndexWindow;
+    
     // Cleanup timer
     QTimer* m_cleanupTimer;
     
     // Maximum data points to keep
     static constexpr int MAX_DATA_POINTS = 100000;
+    static constexpr float HOVER_RADIUS = 20.0f;  // Pixels
 };
 
 // Range-Velocity scatter plot widget
@@ -187,6 +207,7 @@ private:
     
     // Helper functions
     int findNearestPoint(const QPoint& pos) const;
+    void rebuildHitIndex() const;
     
     // Theme colors
     QColor getBackgroundColor() const;
@@ -235,6 +256,12 @@ private:
     QPoint m_mousePos;
     bool m_showTooltip;
     
+    // Hover index in screen pixels, keyed by the axis limits it was built for
+    mutable SpatialGrid m_hitIndex;
+    mutable bool m_hitIndexDirty;
+    mutable QRect m_hitIndexRect;
+    mutable float m_hitIndexLimits[4];     // minVelocity, maxVelocity, minRange, maxRange
+    
     // Histogram bins
     static constexpr int HISTOGRAM_BINS = 20;
     QVector<int> m_velocityHistogram;
@@ -242,6 +269,7 @@ private:
     
     // Maximum data points to keep
     static constexpr int MAX_DATA_POINTS = 500;
+    static constexpr float HOVER_RADIUS = 20.0f;  // Pixels
 };
 
 // Digital display widget with animated numbers (similar to Top Speed style)
@@ -278,12 +306,6 @@ private:
     int m_dataTimeoutMs;  // Timeout duration in milliseconds
 };
 
-// Structure to store previous track data for range rate calculation
-struct TrackHistory {
-    qint64 timestamp;
-    float range;
-};
-
 // Main TimeSeries Plots Widget
 class TimeSeriesPlotsWidget : public QWidget
 {
@@ -293,7 +315,11 @@ public:
     explicit TimeSeriesPlotsWidget(QWidget *parent = nullptr);
     ~TimeSeriesPlotsWidget();
     
-    void updateFromTargets(const TargetTrackData& targets);
+    // `currentTime` is the pipeline time of the report: the receive time
+    // live, the recorded time during a replay
+    void updateFromTargets(const TargetTrackData& targets, qint64 currentTime);
+    // Advance the plots' time axes without new reports
+    void setCurrentTime(qint64 currentTime);
     void setDarkTheme(bool isDark);
     bool isDarkTheme() const { return m_isDarkTheme; }
     
@@ -355,8 +381,6 @@ private:
     void saveSettings();
     void loadSettings();
     bool passesFilters(const TargetTrack& track, float velocityKmh) const;
-    float applyMovingAverage(uint32_t trackId, float value);
-    float calculateRangeRate(uint32_t trackId, float currentRange, qint64 timestamp);
     
     // UI Components
     RangeVelocityPlotWidget* m_rangeVelocityPlot;
@@ -397,18 +421,15 @@ private:
     // Track filtering parameters
     float m_filterMinRange;
     float m_filterMinVelocity;
-    int m_filterMovingAvgSize;
+    int m_filterMovingAvgSize;        // Kalman smoothing level (spin box keeps its old settings key)
     bool m_filterReceding;
     bool m_filterApproaching;
     
-    // Track history for range rate calculation and moving average
-    QMap<uint32_t, QVector<TrackHistory>> m_trackHistory;
-    QMap<uint32_t, QVector<float>> m_movingAvgBuffer;
-    
-    // Range rate moving average calculation
-    float m_previousRangeRate;
-    float m_currentRangeRate;
-    float m_rangeRateMovingAvg;
+    // Per-track Kalman filters for range, range rate and azimuth rate
+    KalmanFilterBank m_trackFilter;
+    std::vector<size_t> m_passedTrackIndices;  // Targets that passed the filters this frame
+    static constexpr float RANGE_PROCESS_NOISE = 1.0f;     // (m/s^2)^2/Hz at smoothing 1
+    static constexpr float AZIMUTH_PROCESS_NOISE = 25.0f;  // (deg/s^2)^2/Hz at smoothing 1
     
     // Track last data received time to detect when no data is coming in
     qint64 m_lastDataReceivedTime;
@@ -422,7 +443,7 @@ private:
     
     // Filter logging control
     bool m_isFilterLoggingActive;
-    QFile* m_filterLogFile;
+    TrackRecorder m_filterRecorder;
     QString m_filterLogFilename;
     
 public slots:
@@ -0,0 +1,159 @@
+#include "TrackLifecycle.h"
+#include <algorithm>
+
+TrackLifecycle::TrackLifecycle()
+    : m_index(64)
+{
+}
+
+void TrackLifecycle::update(const TargetTrackData& frame, qint64 now)
+{
+    m_events.clear();
+
+    for (Entry& entry : m_entries) {
+        entry.seen = false;
+    }
+
+    const size_t n = std::min<size_t>(frame.numTracks, frame.targets.size());
+    for (size_t i = 0; i < n; ++i) {
+        const TargetTrack& report = frame.targets[i];
+        uint32_t idx = m_index.find(report.target_id);
+
+        if (idx == TrackIndex::NO_SLOT) {
+            idx = static_cast<uint32_t>(m_entries.size());
+            m_entries.emplace_back();
+            m_index.insert(report.target_id, idx);
+            m_entries[idx].report.target_id = report.target_id;
+            emitEvent(Event::Type::Created, m_entries[idx]);
+        }
+
+        Entry& entry = m_entries[idx];
+        if (entry.seen) {
+            continue;           // Duplicate id within one frame: keep the first
+        }
+        entry.seen = true;
+        entry.report = report;
+        entry.current = report;
+        entry.lastReport = now;
+        ++entry.hits;
+
+        if (entry.state == State::Tentative && entry.hits >= m_config.confirmHits) {
+            entry.state = State::Confirmed;
+            emitEvent(Event::Type::Confirmed, entry);
+        } else if (entry.state == State::Coasting) {
+            entry.state = State::Confirmed;
+            emitEvent(Event::Type::Resumed, entry);
+        }
+        emitEvent(Event::Type::Updated, entry);
+    }
+
+    // Tracks missing from this frame
+    for (Entry& entry : m_entries) {
+        if (entry.seen) continue;
+
+        if (entry.state == State::Tentative) {
+            entry.state = State::Deleted;
+            emitEvent(Event::Type::Deleted, entry);
+            continue;
+        }
+        if (entry.state == State::Confirmed) {
+            entry.state = State::Coasting;
+            emitEvent(Event::Type::Coasting, entry);
+        }
+        coast(entry, now);
+    }
+
+    removeDeleted();
+    rebuildView();
+}
+
+void TrackLifecycle::advance(qint64 now)
+{
+    m_events.clear();
+
+    for (Entry& entry : m_entries) {
+        if (entry.state == State::Coasting) {
+            coast(entry, now);
+        } else if (now - entry.lastReport > m_config.coastTimeMs) {
+            // No frames at all since the last report
+            entry.state = State::Deleted;
+            emitEvent(Event::Type::Deleted, entry);
+        }
+    }
+
+    if (m_events.empty()) return;
+    removeDeleted();
+    rebuildView();
+}
+
+void TrackLifecycle::coast(Entry& entry, qint64 now)
+{
+    const qint64 age = now - entry.lastReport;
+    if (age > m_config.coastTimeMs) {
+        entry.state = State::Deleted;
+        emitEvent(Event::Type::Deleted, entry);
+        return;
+    }
+
+    // Constant-rate prediction from the last report (positive radial speed = approaching)
+    const float dt = static_cast<float>(age) * 0.001f;
+    const TargetTrack& r = entry.report;
+    entry.current = r;
+    entry.current.radius = std::max(0.0f, r.radius - r.radial_speed * dt);
+    entry.current.azimuth = r.azimuth + r.azimuth_speed * dt;
+    entry.current.elevation = r.elevation + r.elevation_speed * dt;
+    emitEvent(Event::Type::Updated, entry);
+}
+
+void TrackLifecycle::removeDeleted()
+{
+    // Stable compaction keeps the remaining tracks in creation order
+    size_t kept = 0;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        const uint32_t id = m_entries[i].report.target_id;
+        if (m_entries[i].state == State::Deleted) {
+            m_index.erase(id);
+            continue;
+        }
+        if (kept != i) {
+            m_entries[kept] = m_entries[i];
+            m_index.insert(id, static_cast<uint32_t>(kept));
+        }
+        ++kept;
+    }
+    m_entries.resize(kept);
+}
+
+void TrackLifecycle::rebuildView()
+{
+    m_view.targets.clear();
+    for (const Entry& entry : m_entries) {
+        if (entry.state != State::Tentative || m_config.showTentative) {
+            m_view.targets.push_back(entry.current);
+        }
+    }
+    m_view.numTracks = static_cast<uint32_t>(m_view.targets.size());
+}
+
+void TrackLifecycle::emitEvent(Event::Type type, const Entry& entry)
+{
+    m_events.push_back({type, entry.state, entry.report.target_id});
+}
+
+void TrackLifecycle::clear()
+{
+    m_events.clear();
+    for (const Entry& entry : m_entries) {
+        m_events.push_back({Event::Type::Deleted, State::Deleted, entry.report.target_id});
+    }
+    m_entries.clear();
+    m_index.clear();
+    m_view.targets.clear();
+    m_view.numTracks = 0;
+}
+
+TrackLifecycle::State TrackLifecycle::state(uint32_t trackId) const
+{
+    const uint32_t idx = m_index.find(trackId);
+    return idx == TrackIndex::NO_SLOT ? State::Deleted : m_entries[idx].state;
+}
@@ -0,0 +1,98 @@
+#ifndef TRACKLIFECYCLE_H
+#define TRACKLIFECYCLE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <QtGlobal>
+#include "DataStructures.h"
+#include "TrackStateStore.h"
+
+// Persistent track picture built from per-frame target reports.
+//
+// A track reported by the sensor starts Tentative and becomes Confirmed once
+// it has been seen in `confirmHits` frames. A confirmed track missing from a
+// frame is not dropped: it goes to Coasting and its position is predicted
+// from the last report (range from radial speed, angles from their rates)
+// until it is reported again or `coastTimeMs` has passed, when it is
+// Deleted. A tentative track is deleted on its first miss.
+//
+// Every update() / advance() records what changed as compact Events, so
+// consumers can refresh only the affected tracks instead of rebuilding.
+class TrackLifecycle
+{
+public:
+    enum class State : uint8_t {
+        Tentative,
+        Confirmed,
+        Coasting,
+        Deleted
+    };
+
+    struct Event {
+        enum class Type : uint8_t {
+            Created,        // New tentative track
+            Confirmed,      // Tentative -> Confirmed
+            Updated,        // New report, or new coasting prediction
+            Coasting,       // Confirmed -> Coasting
+            Resumed,        // Coasting -> Confirmed
+            Deleted
+        };
+
+        Type type;
+        State state;        // State after the event
+        uint32_t trackId;
+    };
+
+    struct Config {
+        uint32_t confirmHits = 2;       // Frames seen before a track is shown
+        qint64 coastTimeMs = 1500;      // Longest prediction without a report
+        bool showTentative = false;     // Include tentative tracks in tracks()
+    };
+
+    TrackLifecycle();
+
+    void setConfig(const Config& config) { m_config = config; }
+    const Config& config() const { return m_config; }
+
+    // Apply one complete frame of reports taken at `now`
+    void update(const TargetTrackData& frame, qint64 now);
+
+    // Re-predict coasting tracks and expire stale ones without a new frame
+    void advance(qint64 now);
+
+    void clear();
+
+    // Displayable tracks (confirmed and coasting), in creation order
+    const TargetTrackData& tracks() const { return m_view; }
+
+    // Changes made by the last update() or advance()
+    const std::vector<Event>& events() const { return m_events; }
+
+    // State of a track; Deleted if unknown
+    State state(uint32_t trackId) const;
+    size_t size() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        TargetTrack report;         // Last report from the sensor
+        TargetTrack current;        // Report, or its prediction while coasting
+        State state = State::Tentative;
+        uint32_t hits = 0;
+        qint64 lastReport = 0;      // ms
+        bool seen = false;          // Reported in the frame being applied
+    };
+
+    void coast(Entry& entry, qint64 now);
+    void removeDeleted();
+    void rebuildView();
+    void emitEvent(Event::Type type, const Entry& entry);
+
+    Config m_config;
+    std::vector<Entry> m_entries;
+    TrackIndex m_index;             // target_id -> entry index
+    std::vector<Event> m_events;
+    TargetTrackData m_view;
+};
+
+#endif // TRACKLIFECYCLE_H
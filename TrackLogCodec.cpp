@@ -0,0 +1,439 @@
+#include "TrackLogCodec.h"
+#include <cstring>
+#include <QtAlgorithms>
+
+namespace {
+const char FILE_MAGIC[4] = {'T', 'L', 'G', 'C'};
+const char BLOCK_MAGIC[4] = {'T', 'L', 'G', 'B'};
+constexpr uint16_t FORMAT_VERSION = 1;
+
+void setError(std::string* error, const std::string& message)
+{
+    if (error) *error = message;
+}
+
+uint64_t zigzag(uint64_t value)
+{
+    return (value << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(value) >> 63);
+}
+
+uint64_t unzigzag(uint64_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+void putVarint(std::vector<char>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool getVarint(const uchar*& p, const uchar* end, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        const uchar byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+uint32_t floatBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float bitsFloat(uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// MSB-first bit packing
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<char>& out) : m_out(out), m_acc(0), m_bits(0) {}
+
+    void put(uint32_t value, int count)
+    {
+        m_acc = (m_acc << count) | (value & ((uint64_t(1) << count) - 1));
+        m_bits += count;
+        while (m_bits >= 8) {
+            m_bits -= 8;
+            m_out.push_back(static_cast<char>(m_acc >> m_bits));
+        }
+    }
+
+    void flush()
+    {
+        if (m_bits > 0) {
+            m_out.push_back(static_cast<char>(m_acc << (8 - m_bits)));
+        }
+        m_acc = 0;
+        m_bits = 0;
+    }
+
+private:
+    std::vector<char>& m_out;
+    uint64_t m_acc;
+    int m_bits;
+};
+
+class BitReader
+{
+public:
+    BitReader(const uchar* p, const uchar* end) : m_p(p), m_end(end), m_acc(0), m_bits(0) {}
+
+    bool get(int count, uint32_t& value)
+    {
+        while (m_bits < count) {
+            if (m_p == m_end) return false;
+            m_acc = (m_acc << 8) | *m_p++;
+            m_bits += 8;
+        }
+        m_bits -= count;
+        value = static_cast<uint32_t>((m_acc >> m_bits) & ((uint64_t(1) << count) - 1));
+        return true;
+    }
+
+    // Next byte after the bits read so far
+    const uchar* position() const { return m_p; }
+
+private:
+    const uchar* m_p;
+    const uchar* m_end;
+    uint64_t m_acc;
+    int m_bits;
+};
+
+// XOR with the previous value: '0' if unchanged; '10' and the meaningful
+// bits if they fit the previous window; '11', 5-bit leading zero count,
+// 5-bit length - 1 and the meaningful bits otherwise
+void encodeFloats(const std::vector<float>& values, std::vector<char>& out)
+{
+    BitWriter writer(out);
+    uint32_t previous = 0;
+    int previousLeading = -1;
+    int previousTrailing = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        const uint32_t bits = floatBits(values[i]);
+        if (i == 0) {
+            writer.put(bits, 32);
+            previous = bits;
+            continue;
+        }
+        const uint32_t x = bits ^ previous;
+        previous = bits;
+        if (x == 0) {
+            writer.put(0, 1);
+            continue;
+        }
+        const int leading = static_cast<int>(qCountLeadingZeroBits(x));
+        const int trailing = static_cast<int>(qCountTrailingZeroBits(x));
+        if (previousLeading >= 0 && leading >= previousLeading && trailing >= previousTrailing) {
+            writer.put(2, 2);
+            writer.put(x >> previousTrailing, 32 - previousLeading - previousTrailing);
+        } else {
+            const int length = 32 - leading - trailing;
+            writer.put(3, 2);
+            writer.put(static_cast<uint32_t>(leading), 5);
+            writer.put(static_cast<uint32_t>(length - 1), 5);
+            writer.put(x >> trailing, length);
+            previousLeading = leading;
+            previousTrailing = trailing;
+        }
+    }
+    writer.flush();
+}
+
+bool decodeFloats(const uchar*& p, const uchar* end, uint32_t rows, std::vector<float>& values)
+{
+    values.resize(rows);
+    BitReader reader(p, end);
+    uint32_t previous = 0;
+    int previousLeading = -1;
+    int previousTrailing = 0;
+    for (uint32_t i = 0; i < rows; ++i) {
+        uint32_t bits;
+        if (i == 0) {
+            if (!reader.get(32, bits)) return false;
+            previous = bits;
+            values[i] = bitsFloat(bits);
+            continue;
+        }
+        uint32_t control;
+        if (!reader.get(1, control)) return false;
+        if (control) {
+            if (!reader.get(1, control)) return false;
+            uint32_t x;
+            if (control == 0) {
+                if (previousLeading < 0 ||
+                    !reader.get(32 - previousLeading - previousTrailing, x)) return false;
+                x <<= previousTrailing;
+            } else {
+                uint32_t leading, length;
+                if (!reader.get(5, leading) || !reader.get(5, length)) return false;
+                ++length;
+                if (leading + length > 32 || !reader.get(static_cast<int>(length), x)) return false;
+                previousLeading = static_cast<int>(leading);
+                previousTrailing = static_cast<int>(32 - leading - length);
+                x <<= previousTrailing;
+            }
+            previous ^= x;
+        }
+        values[i] = bitsFloat(previous);
+    }
+    p = reader.position();
+    return true;
+}
+}
+
+void TrackLogBlock::clear()
+{
+    trackId.clear();
+    timestamp.clear();
+    range.clear();
+    radialSpeed.clear();
+    azimuth.clear();
+    azimuthSpeed.clear();
+    level.clear();
+    rangeRate.clear();
+}
+
+void TrackLogBlock::append(uint32_t id, qint64 time, float rangeValue, float radialSpeedValue,
+                           float azimuthValue, float azimuthSpeedValue, float levelValue,
+                           float rangeRateValue)
+{
+    trackId.push_back(id);
+    timestamp.push_back(time);
+    range.push_back(rangeValue);
+    radialSpeed.push_back(radialSpeedValue);
+    azimuth.push_back(azimuthValue);
+    azimuthSpeed.push_back(azimuthSpeedValue);
+    level.push_back(levelValue);
+    rangeRate.push_back(rangeRateValue);
+}
+
+TrackLogEncoder::TrackLogEncoder()
+    : m_file(nullptr)
+    , m_rows(0)
+    , m_bytes(0)
+    , m_failed(false)
+{
+}
+
+TrackLogEncoder::~TrackLogEncoder()
+{
+    close();
+}
+
+bool TrackLogEncoder::open(const std::string& path, std::string* error)
+{
+    close();
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        setError(error, "Cannot create " + path);
+        return false;
+    }
+
+    TrackLogFileHeader header;
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.reserved = 0;
+    m_rows = 0;
+    m_failed = std::fwrite(&header, sizeof(header), 1, m_file) != 1;
+    m_bytes = sizeof(header);
+    m_block.clear();
+    if (m_failed) {
+        setError(error, "Cannot write " + path);
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool TrackLogEncoder::append(uint32_t trackId, qint64 timestamp, float range, float radialSpeed,
+                             float azimuth, float azimuthSpeed, float level, float rangeRate)
+{
+    if (!m_file) return false;
+    m_block.append(trackId, timestamp, range, radialSpeed, azimuth, azimuthSpeed, level, rangeRate);
+    if (m_block.size() >= BLOCK_ROWS) {
+        return writeBlock();
+    }
+    return true;
+}
+
+bool TrackLogEncoder::close()
+{
+    if (!m_file) return !m_failed;
+    writeBlock();
+    if (std::fclose(m_file) != 0) {
+        m_failed = true;
+    }
+    m_file = nullptr;
+    return !m_failed;
+}
+
+bool TrackLogEncoder::writeBlock()
+{
+    if (m_block.size() == 0) return true;
+    m_encoded.clear();
+    encodeBlock(m_block, m_encoded);
+    if (std::fwrite(m_encoded.data(), 1, m_encoded.size(), m_file) != m_encoded.size()) {
+        m_failed = true;
+    }
+    m_rows += m_block.size();
+    m_bytes += m_encoded.size();
+    m_block.clear();
+    return !m_failed;
+}
+
+void TrackLogEncoder::encodeBlock(const TrackLogBlock& block, std::vector<char>& out)
+{
+    const size_t headerAt = out.size();
+    out.resize(headerAt + sizeof(TrackLogBlockHeader));
+
+    TrackLogBlockHeader header;
+    std::memcpy(header.magic, BLOCK_MAGIC, sizeof(header.magic));
+    header.rows = static_cast<uint32_t>(block.size());
+    header.reserved = 0;
+    header.minTime = block.size() ? block.timestamp[0] : 0;
+    header.maxTime = header.minTime;
+
+    uint64_t previousId = 0;
+    for (uint32_t id : block.trackId) {
+        putVarint(out, zigzag(static_cast<uint64_t>(id) - previousId));
+        previousId = id;
+    }
+
+    // Unsigned arithmetic: wraps instead of overflowing on wild timestamps
+    uint64_t previousTime = 0;
+    uint64_t previousDelta = 0;
+    for (qint64 time : block.timestamp) {
+        const uint64_t delta = static_cast<uint64_t>(time) - previousTime;
+        putVarint(out, zigzag(delta - previousDelta));
+        previousTime = static_cast<uint64_t>(time);
+        previousDelta = delta;
+        header.minTime = qMin(header.minTime, time);
+        header.maxTime = qMax(header.maxTime, time);
+    }
+
+    encodeFloats(block.range, out);
+    encodeFloats(block.radialSpeed, out);
+    encodeFloats(block.azimuth, out);
+    encodeFloats(block.azimuthSpeed, out);
+    encodeFloats(block.level, out);
+    encodeFloats(block.rangeRate, out);
+
+    header.payloadBytes = static_cast<uint32_t>(out.size() - headerAt - sizeof(header));
+    std::memcpy(out.data() + headerAt, &header, sizeof(header));
+}
+
+TrackLogDecoder::TrackLogDecoder()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_offset(0)
+{
+}
+
+bool TrackLogDecoder::isTrackLog(const char* data, uint64_t size)
+{
+    return size >= sizeof(TrackLogFileHeader) && std::memcmp(data, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0;
+}
+
+bool TrackLogDecoder::open(const char* data, uint64_t size, std::string* error)
+{
+    m_data = data;
+    m_size = size;
+    m_offset = size;
+    if (!isTrackLog(data, size)) {
+        setError(error, "Not a compact track log");
+        return false;
+    }
+    TrackLogFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != FORMAT_VERSION) {
+        setError(error, "Unsupported compact track log version " + std::to_string(header.version));
+        return false;
+    }
+    m_offset = sizeof(header);
+    return true;
+}
+
+bool TrackLogDecoder::nextBlock(TrackLogBlockHeader& header, const char*& payload, std::string* error)
+{
+    if (atEnd()) return false;
+    if (m_size - m_offset < sizeof(header)) {
+        setError(error, "Truncated block header at offset " + std::to_string(m_offset));
+        m_offset = m_size;
+        return false;
+    }
+    std::memcpy(&header, m_data + m_offset, sizeof(header));
+    if (std::memcmp(header.magic, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0 ||
+        header.payloadBytes > m_size - m_offset - sizeof(header)) {
+        setError(error, "Damaged block at offset " + std::to_string(m_offset));
+        m_offset = m_size;
+        return false;
+    }
+    payload = m_data + m_offset + sizeof(header);
+    m_offset += sizeof(header) + header.payloadBytes;
+    return true;
+}
+
+bool TrackLogDecoder::next(TrackLogBlock& block, std::string* error)
+{
+    TrackLogBlockHeader header;
+    const char* payload;
+    const uint64_t blockOffset = m_offset;
+    if (!nextBlock(header, payload, error)) return false;
+    if (!decodeBlock(header, payload, block)) {
+        setError(error, "Damaged block at offset " + std::to_string(blockOffset));
+        m_offset = m_size;
+        return false;
+    }
+    return true;
+}
+
+bool TrackLogDecoder::decodeBlock(const TrackLogBlockHeader& header, const char* payload, TrackLogBlock& block)
+{
+    const uchar* p = reinterpret_cast<const uchar*>(payload);
+    const uchar* end = p + header.payloadBytes;
+    const uint32_t rows = header.rows;
+    // Every row takes at least two bytes (id and timestamp varints)
+    if (rows > header.payloadBytes / 2) return false;
+
+    block.trackId.resize(rows);
+    uint64_t id = 0;
+    for (uint32_t i = 0; i < rows; ++i) {
+        uint64_t value;
+        if (!getVarint(p, end, value)) return false;
+        id += unzigzag(value);
+        block.trackId[i] = static_cast<uint32_t>(id);
+    }
+
+    block.timestamp.resize(rows);
+    uint64_t time = 0;
+    uint64_t delta = 0;
+    for (uint32_t i = 0; i < rows; ++i) {
+        uint64_t value;
+        if (!getVarint(p, end, value)) return false;
+        delta += unzigzag(value);
+        time += delta;
+        block.timestamp[i] = static_cast<qint64>(time);
+    }
+
+    return decodeFloats(p, end, rows, block.range) &&
+           decodeFloats(p, end, rows, block.radialSpeed) &&
+           decodeFloats(p, end, rows, block.azimuth) &&
+           decodeFloats(p, end, rows, block.azimuthSpeed) &&
+           decodeFloats(p, end, rows, block.level) &&
+           decodeFloats(p, end, rows, block.rangeRate);
+}
@@ -0,0 +1,122 @@
+#ifndef TRACKLOGCODEC_H
+#define TRACKLOGCODEC_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <QtGlobal>
+
+// Compact track log (.tlg): the logging window's CSV columns in
+// independently decodable blocks of up to BLOCK_ROWS rows.
+//
+// File: TrackLogFileHeader, then blocks. Block: TrackLogBlockHeader, then
+// payloadBytes of column data, each column in row order:
+//   track id    zigzag varint of the difference to the previous row's id
+//   timestamp   zigzag varint of the delta-of-delta (ms)
+//   6 floats    range, radial speed, azimuth, azimuth speed, level, range
+//               rate; each XORed with the previous row's value and
+//               bit-packed Gorilla-style, padded to a byte
+// Repeated ids and regular sample intervals cost one byte a row and
+// unchanged or slowly changing floats one bit to a few bits, so rows
+// grouped by track (as the logging export writes them) compress best.
+struct TrackLogFileHeader {
+    char magic[4];              // "TLGC"
+    uint16_t version;
+    uint16_t reserved;
+};
+static_assert(sizeof(TrackLogFileHeader) == 8, "TrackLogFileHeader is an on-disk format");
+
+struct TrackLogBlockHeader {
+    char magic[4];              // "TLGB"
+    uint32_t rows;
+    uint32_t payloadBytes;
+    uint32_t reserved;
+    qint64 minTime;             // ms since epoch, over the block's rows
+    qint64 maxTime;
+};
+static_assert(sizeof(TrackLogBlockHeader) == 32, "TrackLogBlockHeader is an on-disk format");
+
+// Rows of one block, column by column
+struct TrackLogBlock {
+    std::vector<uint32_t> trackId;
+    std::vector<qint64> timestamp;
+    std::vector<float> range;
+    std::vector<float> radialSpeed;
+    std::vector<float> azimuth;
+    std::vector<float> azimuthSpeed;
+    std::vector<float> level;
+    std::vector<float> rangeRate;
+
+    size_t size() const { return timestamp.size(); }
+    void clear();
+    void append(uint32_t id, qint64 time, float rangeValue, float radialSpeedValue, float azimuthValue,
+                float azimuthSpeedValue, float levelValue, float rangeRateValue);
+};
+
+// Streaming writer: rows are buffered until a block is full, then encoded
+// and written with one fwrite
+class TrackLogEncoder
+{
+public:
+    static constexpr size_t BLOCK_ROWS = 4096;
+
+    TrackLogEncoder();
+    ~TrackLogEncoder();
+
+    TrackLogEncoder(const TrackLogEncoder&) = delete;
+    TrackLogEncoder& operator=(const TrackLogEncoder&) = delete;
+
+    bool open(const std::string& path, std::string* error = nullptr);
+    bool append(uint32_t trackId, qint64 timestamp, float range, float radialSpeed, float azimuth,
+                float azimuthSpeed, float level, float rangeRate);
+    // Write the partial block and close the file; false if any write failed
+    bool close();
+    bool isOpen() const { return m_file != nullptr; }
+
+    uint64_t rowsWritten() const { return m_rows; }
+    uint64_t bytesWritten() const { return m_bytes; }
+
+    // Append one encoded block (header and payload) to `out`
+    static void encodeBlock(const TrackLogBlock& block, std::vector<char>& out);
+
+private:
+    bool writeBlock();
+
+    std::FILE* m_file;
+    TrackLogBlock m_block;
+    std::vector<char> m_encoded;
+    uint64_t m_rows;
+    uint64_t m_bytes;
+    bool m_failed;
+};
+
+// Streaming reader over a track log held in memory (normally a read-only
+// file mapping). Blocks can also be located with nextBlock() and decoded
+// independently, e.g. on several threads.
+class TrackLogDecoder
+{
+public:
+    TrackLogDecoder();
+
+    static bool isTrackLog(const char* data, uint64_t size);
+
+    bool open(const char* data, uint64_t size, std::string* error = nullptr);
+    // Locate the next block without decoding it. False at the end of the
+    // log, or if the block is damaged (error set).
+    bool nextBlock(TrackLogBlockHeader& header, const char*& payload, std::string* error = nullptr);
+    // Decode the next block into `block` (replacing its rows)
+    bool next(TrackLogBlock& block, std::string* error = nullptr);
+    bool atEnd() const { return m_offset >= m_size; }
+    uint64_t offset() const { return m_offset; }
+
+    // Decode one block's payload; false if it is damaged
+    static bool decodeBlock(const TrackLogBlockHeader& header, const char* payload, TrackLogBlock& block);
+
+private:
+    const char* m_data;
+    uint64_t m_size;
+    uint64_t m_offset;
+};
+
+#endif // TRACKLOGCODEC_H
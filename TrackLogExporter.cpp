@@ -0,0 +1,303 @@
+#include "TrackLogExporter.h"
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstring>
+#include <QFile>
+
+namespace {
+// Rows between cancel checks and progress updates of a track log export
+constexpr size_t TRACK_LOG_STEP_ROWS = TrackLogEncoder::BLOCK_ROWS;
+// Significant digits that round-trip any float
+constexpr int FLOAT_DIGITS = 9;
+
+template<typename T>
+char* putInteger(char* out, T value, char separator)
+{
+    char digits[24];
+    int count = 0;
+    const bool negative = value < 0;
+    unsigned long long magnitude = negative ? 0ULL - static_cast<unsigned long long>(value)
+                                            : static_cast<unsigned long long>(value);
+    do {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (negative) *out++ = '-';
+    while (count > 0) {
+        *out++ = digits[--count];
+    }
+    *out++ = separator;
+    return out;
+}
+
+char* putField(char* out, long long value, char separator)
+{
+    return putInteger(out, value, separator);
+}
+
+char* putField(char* out, uint32_t value, char separator)
+{
+    return putInteger(out, value, separator);
+}
+
+// Exact powers of ten as doubles
+constexpr double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13
+};
+
+// FLOAT_DIGITS significant digits of 1e-5 <= |value| < 1e14 in fixed
+// notation, trailing zeros dropped. The one scaling step in double is off
+// by far less than the 5e-9 relative rounding step, so the digits are the
+// correctly rounded ones or their neighbour, both well within half a float
+// ulp (3e-8), and the text reads back as `value`. False outside that range.
+bool putFixedFloat(char*& out, float value)
+{
+    double magnitude = std::fabs(static_cast<double>(value));
+    if (!(magnitude >= 1e-5 && magnitude < 1e14)) return false;
+
+    int exponent = static_cast<int>(std::floor(std::log10(magnitude)));
+    exponent = std::max(-5, std::min(13, exponent));
+    const int shift = FLOAT_DIGITS - 1 - exponent;
+    double scaled = shift >= 0 ? magnitude * POWERS_OF_TEN[shift] : magnitude / POWERS_OF_TEN[-shift];
+    long long mantissa = std::llround(scaled);
+    if (mantissa >= 1000000000LL) {
+        if (exponent == 13) return false;
+        ++exponent;
+        mantissa = std::llround(shift > 0 ? magnitude * POWERS_OF_TEN[shift - 1] : magnitude / POWERS_OF_TEN[1 - shift]);
+    } else if (mantissa < 100000000LL) {
+        if (exponent == -5) return false;
+        --exponent;
+        mantissa = std::llround(shift + 1 >= 0 ? magnitude * POWERS_OF_TEN[shift + 1] : magnitude / POWERS_OF_TEN[-shift - 1]);
+    }
+
+    char digits[FLOAT_DIGITS];
+    for (int i = FLOAT_DIGITS - 1; i >= 0; --i) {
+        digits[i] = static_cast<char>('0' + mantissa % 10);
+        mantissa /= 10;
+    }
+    int used = FLOAT_DIGITS;
+    while (used > 0 && used > exponent + 1 && digits[used - 1] == '0') --used;
+
+    if (value < 0) *out++ = '-';
+    if (exponent < 0) {
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = -1; i > exponent; --i) *out++ = '0';
+        std::memcpy(out, digits, static_cast<size_t>(used));
+        out += used;
+    } else {
+        for (int i = 0; i <= exponent; ++i) {
+            *out++ = i < FLOAT_DIGITS ? digits[i] : '0';
+        }
+        if (used > exponent + 1) {
+            *out++ = '.';
+            std::memcpy(out, digits + exponent + 1, static_cast<size_t>(used - exponent - 1));
+            out += used - exponent - 1;
+        }
+    }
+    return true;
+}
+
+// Other floats go through snprintf, which follows LC_NUMERIC (set by Qt
+// from the environment); the files always use '.'
+char* putField(char* out, float value, char separator)
+{
+    if (!putFixedFloat(out, value)) {
+        const int length = std::snprintf(out, 32, "%.*g", FLOAT_DIGITS, static_cast<double>(value));
+        const char decimalPoint = std::localeconv()->decimal_point[0];
+        if (decimalPoint != '.') {
+            char* point = static_cast<char*>(std::memchr(out, decimalPoint, static_cast<size_t>(length)));
+            if (point) *point = '.';
+        }
+        out += length;
+    }
+    *out++ = separator;
+    return out;
+}
+}
+
+const char TrackLogExporter::CSV_HEADER[] =
+    "Timestamp,Track_ID,Range_m,Speed_m_s,Azimuth_deg,Azimuth_Speed_deg_s,Level_dB,Range_Rate_m_s\n";
+const char TrackLogExporter::TARGET_CSV_HEADER[] =
+    "ID,Range (m),Azimuth (deg),Radial Speed (m/s)\n";
+
+TrackLogExporter::TrackLogExporter()
+    : m_format(Format::Csv)
+    , m_totalRows(0)
+    , m_file(nullptr)
+    , m_rowsWritten(0)
+    , m_cancel(false)
+    , m_finished(false)
+{
+}
+
+TrackLogExporter::~TrackLogExporter()
+{
+    cancel();
+    takeResult();
+}
+
+TrackLogExporter::Format TrackLogExporter::formatFor(const QString& path)
+{
+    return path.endsWith(".tlg", Qt::CaseInsensitive) ? Format::TrackLog : Format::Csv;
+}
+
+bool TrackLogExporter::start(const QString& path, Format format, std::vector<TrackLogColumns> tracks,
+                             QString* error)
+{
+    cancel();
+    takeResult();
+
+    m_path = QFile::encodeName(path).toStdString();
+    m_format = format;
+    if (format == Format::TrackLog) {
+        std::string openError;
+        if (!m_encoder.open(m_path, &openError)) {
+            if (error) *error = QString::fromStdString(openError);
+            return false;
+        }
+    } else {
+        m_file = std::fopen(m_path.c_str(), "wb");
+        if (!m_file) {
+            if (error) *error = QString("Cannot create %1").arg(path);
+            return false;
+        }
+        // Rows are already batched into WRITE_BUFFER_BYTES writes
+        std::setvbuf(m_file, nullptr, _IONBF, 0);
+    }
+
+    m_tracks = std::move(tracks);
+    m_totalRows = 0;
+    for (const TrackLogColumns& track : m_tracks) {
+        m_totalRows += track.size();
+    }
+
+    m_result = Result();
+    m_rowsWritten.store(0, std::memory_order_relaxed);
+    m_cancel.store(false, std::memory_order_relaxed);
+    m_finished.store(false, std::memory_order_relaxed);
+    m_worker = std::thread(&TrackLogExporter::run, this);
+    return true;
+}
+
+void TrackLogExporter::cancel()
+{
+    m_cancel.store(true, std::memory_order_relaxed);
+}
+
+double TrackLogExporter::progress() const
+{
+    if (m_totalRows == 0) return isFinished() ? 1.0 : 0.0;
+    return static_cast<double>(m_rowsWritten.load(std::memory_order_relaxed)) / static_cast<double>(m_totalRows);
+}
+
+TrackLogExporter::Result TrackLogExporter::takeResult()
+{
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+    m_tracks.clear();
+    m_tracks.shrink_to_fit();
+
+    Result result;
+    std::swap(result, m_result);
+    return result;
+}
+
+char* TrackLogExporter::formatCsvRow(char* out, const TrackLogColumns& track, size_t i)
+{
+    out = putField(out, track.timestamp[i], ',');
+    out = putField(out, track.trackId, ',');
+    out = putField(out, track.range[i], ',');
+    out = putField(out, track.radialSpeed[i], ',');
+    out = putField(out, track.azimuth[i], ',');
+    out = putField(out, track.azimuthSpeed[i], ',');
+    out = putField(out, track.level[i], ',');
+    return putField(out, track.rangeRate[i], '\n');
+}
+
+char* TrackLogExporter::formatTargetCsvRow(char* out, const TrackLogColumns& track, size_t i)
+{
+    out = putField(out, track.trackId, ',');
+    out = putField(out, track.range[i], ',');
+    out = putField(out, track.azimuth[i], ',');
+    return putField(out, track.radialSpeed[i], '\n');
+}
+
+void TrackLogExporter::run()
+{
+    const bool ok = m_format == Format::TrackLog ? writeTrackLog() : writeCsv();
+    m_result.cancelled = m_cancel.load(std::memory_order_relaxed);
+    if (!ok || m_result.cancelled) {
+        std::remove(m_path.c_str());
+        if (!ok && !m_result.cancelled) {
+            m_result.error = "Error writing " + m_path;
+        }
+    }
+    m_finished.store(true, std::memory_order_release);
+}
+
+bool TrackLogExporter::writeCsv()
+{
+    const bool targets = m_format == Format::TargetCsv;
+    const char* const header = targets ? TARGET_CSV_HEADER : CSV_HEADER;
+    char* (*const formatRow)(char*, const TrackLogColumns&, size_t) =
+        targets ? &TrackLogExporter::formatTargetCsvRow : &TrackLogExporter::formatCsvRow;
+
+    std::vector<char> buffer(WRITE_BUFFER_BYTES + MAX_CSV_ROW_BYTES);
+    const size_t headerBytes = std::strlen(header);
+    std::memcpy(buffer.data(), header, headerBytes);
+    char* out = buffer.data() + headerBytes;
+    const char* const flushAt = buffer.data() + WRITE_BUFFER_BYTES;
+
+    bool ok = true;
+    uint64_t rows = 0;
+    auto flush = [&]() {
+        const size_t bytes = static_cast<size_t>(out - buffer.data());
+        ok = std::fwrite(buffer.data(), 1, bytes, m_file) == bytes;
+        m_result.bytes += bytes;
+        out = buffer.data();
+        m_rowsWritten.store(rows, std::memory_order_relaxed);
+    };
+
+    for (const TrackLogColumns& track : m_tracks) {
+        for (size_t i = 0; i < track.size(); ++i) {
+            out = formatRow(out, track, i);
+            ++rows;
+            if (out >= flushAt) {
+                flush();
+                if (!ok || m_cancel.load(std::memory_order_relaxed)) break;
+            }
+        }
+        if (!ok || m_cancel.load(std::memory_order_relaxed)) break;
+    }
+    if (ok) flush();
+    if (std::fclose(m_file) != 0) ok = false;
+    m_file = nullptr;
+    m_result.rows = rows;
+    return ok;
+}
+
+bool TrackLogExporter::writeTrackLog()
+{
+    // Rows stay grouped by track, which the codec encodes best
+    bool ok = true;
+    uint64_t rows = 0;
+    for (const TrackLogColumns& track : m_tracks) {
+        for (size_t i = 0; ok && i < track.size(); ++i) {
+            ok = m_encoder.append(track.trackId, track.timestamp[i], track.range[i], track.radialSpeed[i],
+                                  track.azimuth[i], track.azimuthSpeed[i], track.level[i], track.rangeRate[i]);
+            if (++rows % TRACK_LOG_STEP_ROWS == 0) {
+                m_rowsWritten.store(rows, std::memory_order_relaxed);
+                if (m_cancel.load(std::memory_order_relaxed)) break;
+            }
+        }
+        if (!ok || m_cancel.load(std::memory_order_relaxed)) break;
+    }
+    ok = m_encoder.close() && ok;
+    m_result.rows = m_encoder.rowsWritten();
+    m_result.bytes = m_encoder.bytesWritten();
+    m_rowsWritten.store(rows, std::memory_order_relaxed);
+    return ok;
+}
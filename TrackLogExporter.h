@@ -0,0 +1,89 @@
+#ifndef TRACKLOGEXPORTER_H
+#define TRACKLOGEXPORTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <QString>
+#include <QtGlobal>
+#include "TrackLogCodec.h"
+#include "TrackLogImporter.h"
+
+// Background writer for the logging window's export, as CSV (the columns
+// TrackLogImporter reads) or as a compact track log (TrackLogCodec.h), and
+// for File > Export Data's target CSV (ID, range, azimuth, radial speed).
+//
+// start() takes a snapshot of the rows, per-track columns written track
+// after track, and opens the file; formatting and writing run on a worker
+// thread. CSV rows are formatted (floats with 9 significant digits, which
+// round-trip) into a WRITE_BUFFER_BYTES buffer written with one fwrite each
+// time it fills. Poll progress() and isFinished(), then takeResult(). A
+// cancelled or failed export removes its partial file.
+class TrackLogExporter
+{
+public:
+    enum class Format {
+        Csv,
+        TrackLog,
+        TargetCsv       // One row per point: ID,Range (m),Azimuth (deg),Radial Speed (m/s)
+    };
+
+    struct Result {
+        uint64_t rows = 0;                      // Rows written
+        uint64_t bytes = 0;
+        bool cancelled = false;
+        std::string error;                      // Write failure; the file is removed
+    };
+
+    static constexpr size_t WRITE_BUFFER_BYTES = 1 << 20;
+    // Upper bound on one formatted CSV row
+    static constexpr size_t MAX_CSV_ROW_BYTES = 256;
+    static const char CSV_HEADER[];
+    static const char TARGET_CSV_HEADER[];
+
+    TrackLogExporter();
+    ~TrackLogExporter();
+
+    TrackLogExporter(const TrackLogExporter&) = delete;
+    TrackLogExporter& operator=(const TrackLogExporter&) = delete;
+
+    // .tlg files are written as track logs, anything else as CSV
+    static Format formatFor(const QString& path);
+
+    bool start(const QString& path, Format format, std::vector<TrackLogColumns> tracks,
+               QString* error = nullptr);
+    void cancel();
+    bool isRunning() const { return m_worker.joinable(); }
+    bool isFinished() const { return m_finished.load(std::memory_order_acquire); }
+    // Fraction of the rows written so far
+    double progress() const;
+    // Wait for the export to end and hand over its result
+    Result takeResult();
+
+    // Format row `i` of `track` as a CSV line at `out`, which must have
+    // MAX_CSV_ROW_BYTES of room; returns the end of the line
+    static char* formatCsvRow(char* out, const TrackLogColumns& track, size_t i);
+    static char* formatTargetCsvRow(char* out, const TrackLogColumns& track, size_t i);
+
+private:
+    void run();
+    bool writeCsv();
+    bool writeTrackLog();
+
+    std::string m_path;
+    Format m_format;
+    std::vector<TrackLogColumns> m_tracks;
+    uint64_t m_totalRows;
+    std::FILE* m_file;                          // CSV and target CSV output
+    TrackLogEncoder m_encoder;                  // Track log output
+    std::thread m_worker;
+    std::atomic<uint64_t> m_rowsWritten;
+    std::atomic<bool> m_cancel;
+    std::atomic<bool> m_finished;
+    Result m_result;
+};
+
+#endif // TRACKLOGEXPORTER_H
@@ -0,0 +1,419 @@
+#include "TrackLogImporter.h"
+#include <algorithm>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include "TrackLogCodec.h"
+#include "TrackStateStore.h"
+
+namespace {
+constexpr int CSV_FIELDS = 8;
+constexpr uint64_t PROGRESS_STEP_BYTES = 256 * 1024;
+
+// Longest field text handed to the C parsers
+constexpr size_t MAX_FIELD_CHARS = 63;
+
+// Exact powers of ten as doubles
+constexpr double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Plain decimals ([-]digits[.digits], up to 15 significant digits): the
+// digits and the power of ten are exact doubles, and one division rounded to
+// double then to float rounds the same as a direct float parse. False for
+// anything else (exponents, long mantissas, inf/nan), which goes to strtof.
+bool parsePlainDecimal(const char* begin, const char* end, float& value)
+{
+    const bool negative = begin < end && *begin == '-';
+    if (negative) ++begin;
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int decimals = 0;
+    bool point = false;
+    for (const char* c = begin; c < end; ++c) {
+        if (*c >= '0' && *c <= '9') {
+            if (mantissa != 0 || *c != '0') ++digits;
+            if (digits > 15) return false;
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*c - '0');
+            if (point) ++decimals;
+        } else if (*c == '.' && !point) {
+            point = true;
+        } else {
+            return false;
+        }
+    }
+    if (end == begin || decimals > 22 || (point && end - begin == 1)) return false;
+    const double magnitude = static_cast<double>(mantissa) / POWERS_OF_TEN[decimals];
+    value = static_cast<float>(negative ? -magnitude : magnitude);
+    return true;
+}
+
+// Plain unsigned integers of up to 18 digits; false for anything else
+bool parsePlainInteger(const char* begin, const char* end, uint64_t& value)
+{
+    if (end == begin || end - begin > 18) return false;
+    value = 0;
+    for (const char* c = begin; c < end; ++c) {
+        if (*c < '0' || *c > '9') return false;
+        value = value * 10 + static_cast<uint64_t>(*c - '0');
+    }
+    return true;
+}
+
+float parseNumber(const char* text, char** parsed, float)
+{
+    return std::strtof(text, parsed);
+}
+
+long long parseNumber(const char* text, char** parsed, long long)
+{
+    return std::strtoll(text, parsed, 10);
+}
+
+uint32_t parseNumber(const char* text, char** parsed, uint32_t)
+{
+    if (*text == '-') {
+        *parsed = const_cast<char*>(text);
+        return 0;
+    }
+    return static_cast<uint32_t>(std::strtoul(text, parsed, 10));
+}
+
+// Field value, or 0 when it does not parse (as QString::toFloat did). Other
+// than plain decimals, the field is copied and terminated for the C parsers,
+// with '.' turned into `decimalPoint`: Qt sets LC_NUMERIC from the
+// environment, but files always use '.'
+template<typename T>
+T parseField(const char* begin, const char* end, char decimalPoint)
+{
+    while (begin < end && (*begin == ' ' || *begin == '\t')) ++begin;
+    if (begin < end && *begin == '+') ++begin;
+    if (std::is_same<T, float>::value) {
+        float plain;
+        if (parsePlainDecimal(begin, end, plain)) return static_cast<T>(plain);
+    } else {
+        uint64_t plain;
+        if (parsePlainInteger(begin, end, plain) && plain <= static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+            return static_cast<T>(plain);
+        }
+    }
+
+    char text[MAX_FIELD_CHARS + 1];
+    const size_t length = std::min(static_cast<size_t>(end - begin), MAX_FIELD_CHARS);
+    for (size_t i = 0; i < length; ++i) {
+        text[i] = begin[i] == '.' ? decimalPoint : begin[i];
+    }
+    text[length] = '\0';
+
+    char* parsed = text;
+    const T value = parseNumber(text, &parsed, T());
+    return parsed == text ? 0 : value;
+}
+
+struct BlockRef {
+    TrackLogBlockHeader header;
+    const char* payload;
+};
+
+// Decode track log blocks straight into per-track columns
+void decodeBlocks(const BlockRef* begin, const BlockRef* end, TrackLogImporter::Result& result,
+                  std::atomic<uint64_t>& progress, const std::atomic<bool>& cancel)
+{
+    TrackIndex trackIndex;
+    TrackLogBlock block;
+    for (const BlockRef* ref = begin; ref < end && !cancel.load(std::memory_order_relaxed); ++ref) {
+        if (!TrackLogDecoder::decodeBlock(ref->header, ref->payload, block)) {
+            if (result.error.empty()) {
+                result.error = "Damaged block of " + std::to_string(ref->header.rows) + " rows skipped";
+            }
+            continue;
+        }
+
+        uint32_t lastId = 0;
+        uint32_t lastSlot = TrackIndex::NO_SLOT;
+        for (size_t i = 0; i < block.size(); ++i) {
+            const uint32_t trackId = block.trackId[i];
+            if (trackId != lastId || lastSlot == TrackIndex::NO_SLOT) {
+                lastSlot = trackIndex.find(trackId);
+                if (lastSlot == TrackIndex::NO_SLOT) {
+                    lastSlot = static_cast<uint32_t>(result.tracks.size());
+                    trackIndex.insert(trackId, lastSlot);
+                    result.tracks.emplace_back();
+                    result.tracks.back().trackId = trackId;
+                }
+                lastId = trackId;
+            }
+
+            TrackLogColumns& track = result.tracks[lastSlot];
+            track.timestamp.push_back(block.timestamp[i]);
+            track.range.push_back(block.range[i]);
+            track.radialSpeed.push_back(block.radialSpeed[i]);
+            track.azimuth.push_back(block.azimuth[i]);
+            track.azimuthSpeed.push_back(block.azimuthSpeed[i]);
+            track.level.push_back(block.level[i]);
+            track.rangeRate.push_back(block.rangeRate[i]);
+        }
+        result.rows += block.size();
+        progress.fetch_add(sizeof(ref->header) + ref->header.payloadBytes, std::memory_order_relaxed);
+    }
+}
+}
+
+void TrackLogColumns::append(const TrackLogColumns& other)
+{
+    timestamp.insert(timestamp.end(), other.timestamp.begin(), other.timestamp.end());
+    range.insert(range.end(), other.range.begin(), other.range.end());
+    radialSpeed.insert(radialSpeed.end(), other.radialSpeed.begin(), other.radialSpeed.end());
+    azimuth.insert(azimuth.end(), other.azimuth.begin(), other.azimuth.end());
+    azimuthSpeed.insert(azimuthSpeed.end(), other.azimuthSpeed.begin(), other.azimuthSpeed.end());
+    level.insert(level.end(), other.level.begin(), other.level.end());
+    rangeRate.insert(rangeRate.end(), other.rangeRate.begin(), other.rangeRate.end());
+}
+
+TrackLogImporter::TrackLogImporter()
+    : m_map(nullptr)
+    , m_size(0)
+    , m_bytesParsed(0)
+    , m_cancel(false)
+    , m_finished(false)
+{
+}
+
+TrackLogImporter::~TrackLogImporter()
+{
+    cancel();
+    takeResult();
+}
+
+bool TrackLogImporter::start(const QString& path, QString* error)
+{
+    cancel();
+    takeResult();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (error) *error = m_file.errorString();
+        return false;
+    }
+    m_size = static_cast<uint64_t>(m_file.size());
+    if (m_size > 0) {
+        m_map = m_file.map(0, static_cast<qint64>(m_size));
+        if (!m_map) {
+            if (error) *error = m_file.errorString();
+            m_file.close();
+            return false;
+        }
+    }
+
+    m_result = Result();
+    m_bytesParsed.store(0, std::memory_order_relaxed);
+    m_cancel.store(false, std::memory_order_relaxed);
+    m_finished.store(false, std::memory_order_relaxed);
+    m_coordinator = std::thread(&TrackLogImporter::run, this,
+                                reinterpret_cast<const char*>(m_map), m_size);
+    return true;
+}
+
+void TrackLogImporter::cancel()
+{
+    m_cancel.store(true, std::memory_order_relaxed);
+}
+
+double TrackLogImporter::progress() const
+{
+    if (m_size == 0) return isFinished() ? 1.0 : 0.0;
+    return static_cast<double>(m_bytesParsed.load(std::memory_order_relaxed)) / static_cast<double>(m_size);
+}
+
+TrackLogImporter::Result TrackLogImporter::takeResult()
+{
+    if (m_coordinator.joinable()) {
+        m_coordinator.join();
+    }
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_file.close();
+
+    Result result;
+    std::swap(result, m_result);
+    return result;
+}
+
+void TrackLogImporter::run(const char* data, uint64_t size)
+{
+    std::vector<Result> parts;
+    if (TrackLogDecoder::isTrackLog(data, size)) {
+        splitTrackLog(data, size, parts);
+    } else {
+        splitCsv(data, size, parts);
+    }
+
+    // Concatenate per-track columns in chunk (= file) order
+    TrackIndex trackIndex;
+    for (Result& part : parts) {
+        m_result.rows += part.rows;
+        m_result.skippedLines += part.skippedLines;
+        if (m_result.error.empty()) {
+            m_result.error = part.error;
+        }
+        for (TrackLogColumns& track : part.tracks) {
+            const uint32_t slot = trackIndex.find(track.trackId);
+            if (slot == TrackIndex::NO_SLOT) {
+                trackIndex.insert(track.trackId, static_cast<uint32_t>(m_result.tracks.size()));
+                m_result.tracks.push_back(std::move(track));
+            } else {
+                m_result.tracks[slot].append(track);
+            }
+        }
+        part.tracks.clear();
+        part.tracks.shrink_to_fit();
+    }
+    m_result.cancelled = m_cancel.load(std::memory_order_relaxed);
+    m_finished.store(true, std::memory_order_release);
+}
+
+void TrackLogImporter::splitCsv(const char* data, uint64_t size, std::vector<Result>& parts)
+{
+    // Skip the header line
+    const char* headerEnd = size ? static_cast<const char*>(std::memchr(data, '\n', size)) : nullptr;
+    const char* begin = headerEnd ? headerEnd + 1 : data + size;
+    const char* end = data + size;
+    m_bytesParsed.fetch_add(static_cast<uint64_t>(begin - data), std::memory_order_relaxed);
+
+    // One chunk per core, but none smaller than MIN_CHUNK_BYTES
+    const uint64_t bodyBytes = static_cast<uint64_t>(end - begin);
+    const uint64_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunks = static_cast<size_t>(std::max<uint64_t>(1, std::min(cores, bodyBytes / MIN_CHUNK_BYTES)));
+
+    // Chunk boundaries fall just after a newline
+    std::vector<const char*> bounds(chunks + 1, end);
+    bounds[0] = begin;
+    for (size_t k = 1; k < chunks; ++k) {
+        const char* guess = std::max(bounds[k - 1], begin + bodyBytes * k / chunks);
+        const char* newline = static_cast<const char*>(std::memchr(guess, '\n', static_cast<size_t>(end - guess)));
+        bounds[k] = newline ? newline + 1 : end;
+    }
+
+    parts.resize(chunks);
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for (size_t k = 1; k < chunks; ++k) {
+        workers.emplace_back(&TrackLogImporter::parseChunk, bounds[k], bounds[k + 1],
+                             std::ref(parts[k]), std::ref(m_bytesParsed), std::cref(m_cancel));
+    }
+    parseChunk(bounds[0], bounds[1], parts[0], m_bytesParsed, m_cancel);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void TrackLogImporter::splitTrackLog(const char* data, uint64_t size, std::vector<Result>& parts)
+{
+    // Walking the block headers is cheap; a damaged header ends the log
+    // but the blocks before it are still imported
+    parts.resize(1);
+    TrackLogDecoder decoder;
+    if (!decoder.open(data, size, &parts[0].error)) return;
+    m_bytesParsed.fetch_add(decoder.offset(), std::memory_order_relaxed);
+
+    std::vector<BlockRef> blocks;
+    BlockRef ref;
+    std::string error;
+    while (decoder.nextBlock(ref.header, ref.payload, &error)) {
+        blocks.push_back(ref);
+    }
+
+    // One run of consecutive blocks per core
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunks = std::max<size_t>(1, std::min(cores, blocks.size()));
+    parts.resize(chunks);
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    const BlockRef* first = blocks.data();
+    for (size_t k = 1; k < chunks; ++k) {
+        workers.emplace_back(decodeBlocks, first + blocks.size() * k / chunks,
+                             first + blocks.size() * (k + 1) / chunks,
+                             std::ref(parts[k]), std::ref(m_bytesParsed), std::cref(m_cancel));
+    }
+    decodeBlocks(first, first + blocks.size() / chunks, parts[0], m_bytesParsed, m_cancel);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    if (!error.empty()) {
+        parts.back().error = error;
+    }
+}
+
+void TrackLogImporter::parseChunk(const char* begin, const char* end, Result& result,
+                                  std::atomic<uint64_t>& progress, const std::atomic<bool>& cancel)
+{
+    TrackIndex trackIndex;
+    uint32_t lastId = 0;
+    uint32_t lastSlot = TrackIndex::NO_SLOT;
+    const char* reported = begin;
+    const char decimalPoint = std::localeconv()->decimal_point[0];
+
+    const char* line = begin;
+    while (line < end) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        const char* next = newline ? newline + 1 : end;
+        const char* lineEnd = newline ? newline : end;
+        if (lineEnd > line && lineEnd[-1] == '\r') --lineEnd;
+
+        if (lineEnd > line) {
+            // Split into the first CSV_FIELDS fields; extra fields are ignored
+            const char* fields[CSV_FIELDS + 1];
+            int count = 0;
+            const char* field = line;
+            while (count < CSV_FIELDS) {
+                fields[count++] = field;
+                const char* comma = static_cast<const char*>(std::memchr(field, ',', static_cast<size_t>(lineEnd - field)));
+                if (!comma) {
+                    field = lineEnd + 1;
+                    break;
+                }
+                field = comma + 1;
+            }
+            fields[count] = field;
+
+            if (count < CSV_FIELDS) {
+                ++result.skippedLines;
+            } else {
+                const uint32_t trackId = parseField<uint32_t>(fields[1], fields[2] - 1, decimalPoint);
+                if (trackId != lastId || lastSlot == TrackIndex::NO_SLOT) {
+                    lastSlot = trackIndex.find(trackId);
+                    if (lastSlot == TrackIndex::NO_SLOT) {
+                        lastSlot = static_cast<uint32_t>(result.tracks.size());
+                        trackIndex.insert(trackId, lastSlot);
+                        result.tracks.emplace_back();
+                        result.tracks.back().trackId = trackId;
+                    }
+                    lastId = trackId;
+                }
+
+                TrackLogColumns& track = result.tracks[lastSlot];
+                track.timestamp.push_back(parseField<long long>(fields[0], fields[1] - 1, decimalPoint));
+                track.range.push_back(parseField<float>(fields[2], fields[3] - 1, decimalPoint));
+                track.radialSpeed.push_back(parseField<float>(fields[3], fields[4] - 1, decimalPoint));
+                track.azimuth.push_back(parseField<float>(fields[4], fields[5] - 1, decimalPoint));
+                track.azimuthSpeed.push_back(parseField<float>(fields[5], fields[6] - 1, decimalPoint));
+                track.level.push_back(parseField<float>(fields[6], fields[7] - 1, decimalPoint));
+                track.rangeRate.push_back(parseField<float>(fields[7], std::min(fields[8] - 1, lineEnd), decimalPoint));
+                ++result.rows;
+            }
+        }
+
+        line = next;
+        if (static_cast<uint64_t>(line - reported) >= PROGRESS_STEP_BYTES) {
+            progress.fetch_add(static_cast<uint64_t>(line - reported), std::memory_order_relaxed);
+            reported = line;
+            if (cancel.load(std::memory_order_relaxed)) break;
+        }
+    }
+    progress.fetch_add(static_cast<uint64_t>(line - reported), std::memory_order_relaxed);
+}
@@ -0,0 +1,86 @@
+#ifndef TRACKLOGIMPORTER_H
+#define TRACKLOGIMPORTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+
+// One track's imported rows, column by column, in file order
+struct TrackLogColumns {
+    uint32_t trackId = 0;
+    std::vector<qint64> timestamp;
+    std::vector<float> range;
+    std::vector<float> radialSpeed;
+    std::vector<float> azimuth;
+    std::vector<float> azimuthSpeed;
+    std::vector<float> level;
+    std::vector<float> rangeRate;
+
+    size_t size() const { return timestamp.size(); }
+    void append(const TrackLogColumns& other);
+};
+
+// Background importer for the logging window's CSV export
+// (Timestamp,Track_ID,Range_m,Speed_m_s,Azimuth_deg,Azimuth_Speed_deg_s,
+// Level_dB,Range_Rate_m_s) and its compact track log (TrackLogCodec.h).
+//
+// The file is memory-mapped and split into one chunk per core, on line
+// boundaries for CSV and block boundaries for track logs. Each chunk is
+// parsed on its own thread (CSV with strtof/strtoll) straight into
+// per-track columns, then the chunks are concatenated in file order.
+// Nothing runs on the caller's thread after start(): poll progress() and
+// isFinished(), then takeResult().
+class TrackLogImporter
+{
+public:
+    struct Result {
+        std::vector<TrackLogColumns> tracks;    // In order of first appearance
+        uint64_t rows = 0;
+        uint64_t skippedLines = 0;              // Lines with fewer than 8 fields
+        bool cancelled = false;
+        std::string error;                      // Damaged track log; rows before it are kept
+    };
+
+    static constexpr uint64_t MIN_CHUNK_BYTES = 1 << 20;
+
+    TrackLogImporter();
+    ~TrackLogImporter();
+
+    TrackLogImporter(const TrackLogImporter&) = delete;
+    TrackLogImporter& operator=(const TrackLogImporter&) = delete;
+
+    bool start(const QString& path, QString* error = nullptr);
+    void cancel();
+    bool isRunning() const { return m_coordinator.joinable(); }
+    bool isFinished() const { return m_finished.load(std::memory_order_acquire); }
+    // Fraction of the file parsed so far
+    double progress() const;
+    // Wait for the import to end and hand over its result
+    Result takeResult();
+
+    // Parse CSV rows in [begin, end) into `tracks`; exposed for the chunk
+    // threads. Adds the bytes consumed to `progress` as it goes.
+    static void parseChunk(const char* begin, const char* end, Result& result,
+                           std::atomic<uint64_t>& progress, const std::atomic<bool>& cancel);
+
+private:
+    void run(const char* data, uint64_t size);
+    void splitCsv(const char* data, uint64_t size, std::vector<Result>& parts);
+    void splitTrackLog(const char* data, uint64_t size, std::vector<Result>& parts);
+
+    QFile m_file;
+    uchar* m_map;
+    uint64_t m_size;
+    std::thread m_coordinator;
+    std::atomic<uint64_t> m_bytesParsed;
+    std::atomic<bool> m_cancel;
+    std::atomic<bool> m_finished;
+    Result m_result;
+};
+
+#endif // TRACKLOGIMPORTER_H
@@ -0,0 +1,270 @@
+#include "TrackLogSegments.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+constexpr uint64_t COLUMN_BYTES = TrackLogSegments::SEGMENT_POINTS * 4;
+
+void clearColumns(TrackLogColumns& columns)
+{
+    columns.timestamp.clear();
+    columns.range.clear();
+    columns.radialSpeed.clear();
+    columns.azimuth.clear();
+    columns.azimuthSpeed.clear();
+    columns.level.clear();
+    columns.rangeRate.clear();
+}
+
+void putColumn(char*& column, const std::vector<float>& values)
+{
+    std::memcpy(column, values.data(), values.size() * sizeof(float));
+    column += COLUMN_BYTES;
+}
+
+void getColumn(const uchar*& column, std::vector<float>& values, uint32_t count)
+{
+    const size_t old = values.size();
+    values.resize(old + count);
+    std::memcpy(values.data() + old, column, count * sizeof(float));
+    column += COLUMN_BYTES;
+}
+}
+
+TrackLogSegments::TrackLogSegments()
+    : m_slotCount(0)
+    , m_usedSlots(0)
+    , m_lostPoints(0)
+{
+}
+
+TrackLogSegments::~TrackLogSegments() = default;
+
+void TrackLogSegments::append(uint32_t trackId, qint64 timestamp, float range, float radialSpeed,
+                              float azimuth, float azimuthSpeed, float level, float rangeRate)
+{
+    uint32_t index = m_index.find(trackId);
+    if (index == TrackIndex::NO_SLOT) {
+        index = static_cast<uint32_t>(m_tracks.size());
+        m_index.insert(trackId, index);
+        m_tracks.emplace_back();
+        m_tracks.back().trackId = trackId;
+        m_tracks.back().hot.trackId = trackId;
+    }
+    Track& track = m_tracks[index];
+    TrackLogColumns& hot = track.hot;
+
+    // Times are stored as 32-bit ms offsets, so a segment ends early on a
+    // time step backwards or one too long to encode
+    if (!hot.timestamp.empty()) {
+        const qint64 offset = timestamp - hot.timestamp.front();
+        if (offset < 0 || offset > static_cast<qint64>(std::numeric_limits<uint32_t>::max())) {
+            spill(track);
+        }
+    }
+
+    hot.timestamp.push_back(timestamp);
+    hot.range.push_back(range);
+    hot.radialSpeed.push_back(radialSpeed);
+    hot.azimuth.push_back(azimuth);
+    hot.azimuthSpeed.push_back(azimuthSpeed);
+    hot.level.push_back(level);
+    hot.rangeRate.push_back(rangeRate);
+
+    if (hot.size() == SEGMENT_POINTS) {
+        spill(track);
+    }
+}
+
+void TrackLogSegments::spill(Track& track)
+{
+    TrackLogColumns& hot = track.hot;
+    const uint32_t count = static_cast<uint32_t>(hot.size());
+    if (count == 0) return;
+
+    if (!m_file.isOpen() && !m_file.open()) {
+        m_error = m_file.errorString();
+        m_lostPoints += count;
+        clearColumns(hot);
+        return;
+    }
+
+    const bool reused = !m_freeSlots.empty();
+    const uint64_t slot = reused ? m_freeSlots.back() : m_slotCount;
+
+    m_scratch.assign(SLOT_BYTES, 0);
+    TrackLogSegmentHeader header;
+    std::memcpy(header.magic, "TLSG", 4);
+    header.trackId = track.trackId;
+    header.count = count;
+    header.reserved = 0;
+    header.firstTime = hot.timestamp.front();
+    std::memcpy(m_scratch.data(), &header, sizeof(header));
+
+    char* column = m_scratch.data() + sizeof(header);
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t offset = static_cast<uint32_t>(hot.timestamp[i] - header.firstTime);
+        std::memcpy(column + i * sizeof(uint32_t), &offset, sizeof(offset));
+    }
+    column += COLUMN_BYTES;
+    putColumn(column, hot.range);
+    putColumn(column, hot.radialSpeed);
+    putColumn(column, hot.azimuth);
+    putColumn(column, hot.azimuthSpeed);
+    putColumn(column, hot.level);
+    putColumn(column, hot.rangeRate);
+
+    if (!m_file.seek(static_cast<qint64>(slot * SLOT_BYTES)) ||
+        m_file.write(m_scratch.data(), static_cast<qint64>(SLOT_BYTES)) != static_cast<qint64>(SLOT_BYTES)) {
+        m_error = m_file.errorString();
+        m_lostPoints += count;
+        clearColumns(hot);
+        return;
+    }
+
+    if (reused) {
+        m_freeSlots.pop_back();
+    } else {
+        ++m_slotCount;
+    }
+    ++m_usedSlots;
+    track.slots.push_back(static_cast<uint32_t>(slot));
+    track.spilledPoints += count;
+    clearColumns(hot);
+}
+
+bool TrackLogSegments::read(uint32_t trackId, TrackLogColumns& out)
+{
+    const bool ok = readSpilled(trackId, 0, out);
+    readHot(trackId, out);
+    return ok;
+}
+
+bool TrackLogSegments::readSpilled(uint32_t trackId, size_t firstSegment, TrackLogColumns& out)
+{
+    const uint32_t index = m_index.find(trackId);
+    if (index == TrackIndex::NO_SLOT) return true;
+    const Track& track = m_tracks[index];
+    if (firstSegment >= track.slots.size()) return true;
+
+    // Pending writes must reach the file before it is mapped
+    m_file.flush();
+    uchar* map = m_file.map(0, static_cast<qint64>(m_slotCount * SLOT_BYTES));
+    if (!map) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    for (size_t i = firstSegment; i < track.slots.size(); ++i) {
+        readSegment(map + track.slots[i] * SLOT_BYTES, out);
+    }
+    m_file.unmap(map);
+    return true;
+}
+
+void TrackLogSegments::readHot(uint32_t trackId, TrackLogColumns& out) const
+{
+    const uint32_t index = m_index.find(trackId);
+    if (index != TrackIndex::NO_SLOT) {
+        out.append(m_tracks[index].hot);
+    }
+}
+
+size_t TrackLogSegments::spilledSegments(uint32_t trackId) const
+{
+    const uint32_t index = m_index.find(trackId);
+    return index == TrackIndex::NO_SLOT ? 0 : m_tracks[index].slots.size();
+}
+
+bool TrackLogSegments::writeRangeRates(uint32_t trackId, const float* rates, size_t count)
+{
+    const uint32_t index = m_index.find(trackId);
+    if (index == TrackIndex::NO_SLOT) return true;
+    Track& track = m_tracks[index];
+
+    if (!track.slots.empty()) {
+        m_file.flush();
+        uchar* map = m_file.map(0, static_cast<qint64>(m_slotCount * SLOT_BYTES));
+        if (!map) {
+            m_error = m_file.errorString();
+            return false;
+        }
+        // Range rate is the last column of a slot
+        for (uint32_t slot : track.slots) {
+            if (count == 0) break;
+            uchar* base = map + slot * SLOT_BYTES;
+            TrackLogSegmentHeader header;
+            std::memcpy(&header, base, sizeof(header));
+            const size_t n = std::min<size_t>(header.count, count);
+            std::memcpy(base + sizeof(header) + 6 * COLUMN_BYTES, rates, n * sizeof(float));
+            rates += n;
+            count -= n;
+        }
+        m_file.unmap(map);
+    }
+
+    const size_t n = std::min(track.hot.rangeRate.size(), count);
+    std::copy(rates, rates + n, track.hot.rangeRate.begin());
+    return true;
+}
+
+void TrackLogSegments::readSegment(const uchar* slot, TrackLogColumns& out) const
+{
+    TrackLogSegmentHeader header;
+    std::memcpy(&header, slot, sizeof(header));
+    const uint32_t count = header.count;
+
+    const uchar* column = slot + sizeof(header);
+    out.timestamp.reserve(out.timestamp.size() + count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t offset;
+        std::memcpy(&offset, column + i * sizeof(uint32_t), sizeof(offset));
+        out.timestamp.push_back(header.firstTime + offset);
+    }
+    column += COLUMN_BYTES;
+    getColumn(column, out.range, count);
+    getColumn(column, out.radialSpeed, count);
+    getColumn(column, out.azimuth, count);
+    getColumn(column, out.azimuthSpeed, count);
+    getColumn(column, out.level, count);
+    getColumn(column, out.rangeRate, count);
+}
+
+uint64_t TrackLogSegments::pointCount(uint32_t trackId) const
+{
+    const uint32_t index = m_index.find(trackId);
+    if (index == TrackIndex::NO_SLOT) return 0;
+    return m_tracks[index].spilledPoints + m_tracks[index].hot.size();
+}
+
+void TrackLogSegments::dropTrack(uint32_t trackId)
+{
+    const uint32_t index = m_index.find(trackId);
+    if (index == TrackIndex::NO_SLOT) return;
+
+    Track& track = m_tracks[index];
+    m_freeSlots.insert(m_freeSlots.end(), track.slots.begin(), track.slots.end());
+    m_usedSlots -= track.slots.size();
+    m_index.erase(trackId);
+
+    // Keep m_tracks dense: the last track takes the dropped one's place
+    if (index + 1 != m_tracks.size()) {
+        track = std::move(m_tracks.back());
+        m_index.insert(track.trackId, index);
+    }
+    m_tracks.pop_back();
+}
+
+void TrackLogSegments::clear()
+{
+    m_index.clear();
+    m_tracks.clear();
+    m_freeSlots.clear();
+    m_slotCount = 0;
+    m_usedSlots = 0;
+    m_lostPoints = 0;
+    m_error.clear();
+    if (m_file.isOpen()) {
+        m_file.resize(0);
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef TRACKLOGSEGMENTS_H
+#define TRACKLOGSEGMENTS_H
+
+#include <cstdint>
+#include <vector>
+#include <QString>
+#include <QTemporaryFile>
+#include <QtGlobal>
+#include "TrackLogImporter.h"
+#include "TrackStateStore.h"
+
+// On-disk segment header, followed by SEGMENT_POINTS entries of each column:
+// uint32 time offset (ms after firstTime), then float range, radial speed,
+// azimuth, azimuth speed, level and range rate
+struct TrackLogSegmentHeader {
+    char magic[4];              // "TLSG"
+    uint32_t trackId;
+    uint32_t count;             // Points used, up to SEGMENT_POINTS
+    uint32_t reserved;
+    qint64 firstTime;           // ms since epoch
+};
+static_assert(sizeof(TrackLogSegmentHeader) == 24, "TrackLogSegmentHeader is an on-disk format");
+
+// Cold tier of the logging window's track history.
+//
+// Points that age out of a track's in-memory history ring are appended
+// here. Each track gathers them into an in-RAM segment of SEGMENT_POINTS
+// samples; a full segment is written to a session spill file as one
+// fixed-size slot in columnar form (28 bytes a point instead of 40) and
+// only its slot number stays in memory. Slots of dropped tracks are reused,
+// so the file grows with the data still logged, not with session length.
+// read() maps the file and pages a track's points back in for plots and
+// export. The spill file is a temporary file, truncated by clear() and
+// removed on destruction.
+class TrackLogSegments
+{
+public:
+    static constexpr uint32_t SEGMENT_POINTS = 1024;
+    static constexpr uint64_t SLOT_BYTES = sizeof(TrackLogSegmentHeader) + SEGMENT_POINTS * 7 * 4;
+
+    TrackLogSegments();
+    ~TrackLogSegments();
+
+    TrackLogSegments(const TrackLogSegments&) = delete;
+    TrackLogSegments& operator=(const TrackLogSegments&) = delete;
+
+    // Points of one track must arrive oldest first
+    void append(uint32_t trackId, qint64 timestamp, float range, float radialSpeed,
+                float azimuth, float azimuthSpeed, float level, float rangeRate);
+
+    // Append the track's points, oldest first, to `out`. False if the spill
+    // file could not be mapped; the in-RAM points are still appended.
+    bool read(uint32_t trackId, TrackLogColumns& out);
+    // The two halves of read(): the spilled segments from `firstSegment` on,
+    // then the in-RAM points. Spilled segments never change once written
+    // (except through writeRangeRates), so a caller may decode them once
+    // and afterwards read only the segments spilled since.
+    bool readSpilled(uint32_t trackId, size_t firstSegment, TrackLogColumns& out);
+    void readHot(uint32_t trackId, TrackLogColumns& out) const;
+    size_t spilledSegments(uint32_t trackId) const;
+
+    // Overwrite the range rate of the track's first `count` points (oldest
+    // first, as read() returns them) in place, in the spill file and the
+    // in-RAM segment. False if the spill file could not be mapped.
+    bool writeRangeRates(uint32_t trackId, const float* rates, size_t count);
+
+    bool contains(uint32_t trackId) const { return m_index.contains(trackId); }
+    uint64_t pointCount(uint32_t trackId) const;
+    void dropTrack(uint32_t trackId);
+    void clear();
+
+    uint64_t segmentsOnDisk() const { return m_usedSlots; }
+    uint64_t diskBytes() const { return m_slotCount * SLOT_BYTES; }
+    uint64_t lostPoints() const { return m_lostPoints; }   // Segments that failed to write
+    const QString& errorString() const { return m_error; }
+
+private:
+    struct Track {
+        uint32_t trackId = 0;
+        std::vector<uint32_t> slots;    // Spilled segments, oldest first
+        uint64_t spilledPoints = 0;
+        TrackLogColumns hot;            // Segment being filled
+    };
+
+    void spill(Track& track);
+    void readSegment(const uchar* slot, TrackLogColumns& out) const;
+
+    TrackIndex m_index;                 // Track id -> index into m_tracks
+    std::vector<Track> m_tracks;
+    std::vector<uint32_t> m_freeSlots;
+    uint64_t m_slotCount;               // Slots in the file, used or free
+    uint64_t m_usedSlots;
+    uint64_t m_lostPoints;
+    QTemporaryFile m_file;
+    std::vector<char> m_scratch;
+    QString m_error;
+};
+
+#endif // TRACKLOGSEGMENTS_H
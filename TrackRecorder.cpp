@@ -0,0 +1,323 @@
+#include "TrackRecorder.h"
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include "TrackRecordingIndex.h"
+
+namespace {
+const char RECORDING_MAGIC[4] = {'T', 'R', 'K', 'R'};
+constexpr uint16_t RECORDING_VERSION = 1;
+constexpr size_t EXPORT_CHUNK_RECORDS = 4096;
+
+// "yyyy-MM-dd HH:mm:ss.zzz" in local time
+void formatSystemTime(qint64 ms, char* out, size_t size)
+{
+    const std::time_t secs = static_cast<std::time_t>(ms / 1000);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &secs);
+#else
+    localtime_r(&secs, &local);
+#endif
+    const size_t n = std::strftime(out, size, "%Y-%m-%d %H:%M:%S", &local);
+    std::snprintf(out + n, size - n, ".%03d", static_cast<int>(ms % 1000));
+}
+
+void setError(std::string* error, const std::string& message)
+{
+    if (error) *error = message;
+}
+}
+
+TrackRecord TrackRecord::fromTarget(const TargetTrack& target, qint64 timestamp,
+                                    float velocityKmh, float avgRange)
+{
+    TrackRecord r;
+    r.timestamp = timestamp;
+    r.target_id = target.target_id;
+    r.level = target.level;
+    r.radius = target.radius;
+    r.azimuth = target.azimuth;
+    r.elevation = target.elevation;
+    r.radial_speed = target.radial_speed;
+    r.azimuth_speed = target.azimuth_speed;
+    r.elevation_speed = target.elevation_speed;
+    r.velocity_kmh = velocityKmh;
+    r.avg_range = avgRange;
+    return r;
+}
+
+TrackRecorder::TrackRecorder()
+    : m_file(nullptr)
+    , m_fullBlocks(NUM_BLOCKS)
+    , m_freeBlocks(NUM_BLOCKS)
+    , m_currentBlock(-1)
+    , m_blockStartTime(0)
+    , m_stopping(false)
+    , m_index(new TrackRecordingIndex)
+    , m_recordsWritten(0)
+    , m_recordsDropped(0)
+    , m_writeFailed(false)
+{
+    m_blocks.reserve(NUM_BLOCKS);
+    m_blockUsed.assign(NUM_BLOCKS, 0);
+    for (uint32_t b = 0; b < NUM_BLOCKS; ++b) {
+        m_blocks.emplace_back(new char[BLOCK_BYTES]);
+        m_freeBlocks.push(b);
+    }
+}
+
+TrackRecorder::~TrackRecorder()
+{
+    stop();
+}
+
+bool TrackRecorder::start(const std::string& path, TrackRecordKind kind, qint64 startTime)
+{
+    stop();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) return false;
+
+    // Blocks are already write-sized; skip stdio's own buffering
+    std::setvbuf(m_file, nullptr, _IONBF, 0);
+
+    TrackRecordingHeader header;
+    std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+    header.version = RECORDING_VERSION;
+    header.recordSize = static_cast<uint16_t>(sizeof(TrackRecord));
+    header.kind = static_cast<uint32_t>(kind);
+    header.reserved = 0;
+    header.startTime = startTime;
+    if (std::fwrite(&header, sizeof(header), 1, m_file) != 1) {
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+
+    // An index left by an earlier recording at this path no longer applies
+    std::remove(TrackRecordingIndex::indexPath(path).c_str());
+    m_index->clear();
+
+    m_path = path;
+    m_recordsWritten.store(0, std::memory_order_relaxed);
+    m_recordsDropped.store(0, std::memory_order_relaxed);
+    m_writeFailed.store(false, std::memory_order_relaxed);
+    m_stopping.store(false, std::memory_order_relaxed);
+    m_writer = std::thread(&TrackRecorder::writerLoop, this);
+    return true;
+}
+
+void TrackRecorder::stop()
+{
+    if (!m_file) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_blockMutex);
+        if (m_currentBlock >= 0) {
+            submitBlock();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping.store(true, std::memory_order_release);
+    }
+    m_wake.notify_one();
+    m_writer.join();
+
+    std::fclose(m_file);
+    m_file = nullptr;
+
+    // After a failed write the file no longer matches the index; readers
+    // rebuild it from the file instead
+    if (!m_writeFailed.load(std::memory_order_relaxed)) {
+        m_index->save(TrackRecordingIndex::indexPath(m_path));
+    }
+    m_index->clear();
+}
+
+void TrackRecorder::record(const TrackRecord& record)
+{
+    if (!m_file) return;
+
+    std::lock_guard<std::mutex> lock(m_blockMutex);
+    if (m_currentBlock < 0 && !acquireBlock()) {
+        m_recordsDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    size_t& used = m_blockUsed[m_currentBlock];
+    if (used == 0) {
+        m_blockStartTime = record.timestamp;
+        m_blockOpenedAt = std::chrono::steady_clock::now();
+    }
+    std::memcpy(m_blocks[m_currentBlock].get() + used, &record, sizeof(TrackRecord));
+    used += sizeof(TrackRecord);
+
+    if (used + sizeof(TrackRecord) > BLOCK_BYTES ||
+        record.timestamp - m_blockStartTime >= FLUSH_INTERVAL_MS) {
+        submitBlock();
+    }
+}
+
+bool TrackRecorder::acquireBlock()
+{
+    uint32_t block;
+    if (!m_freeBlocks.pop(block)) return false;
+    m_currentBlock = static_cast<int>(block);
+    m_blockUsed[block] = 0;
+    return true;
+}
+
+void TrackRecorder::submitBlock()
+{
+    // Cannot fail: the queue holds every block
+    m_fullBlocks.push(static_cast<uint32_t>(m_currentBlock));
+    m_currentBlock = -1;
+    m_wake.notify_one();
+}
+
+void TrackRecorder::flushAgedBlock()
+{
+    // A feed that stops leaves its last block partly filled; hand it over
+    // on wall-clock age since no later record will
+    std::lock_guard<std::mutex> lock(m_blockMutex);
+    if (m_currentBlock >= 0 && m_blockUsed[m_currentBlock] > 0 &&
+        std::chrono::steady_clock::now() - m_blockOpenedAt >= std::chrono::milliseconds(FLUSH_INTERVAL_MS)) {
+        submitBlock();
+    }
+}
+
+void TrackRecorder::writerLoop()
+{
+    for (;;) {
+        uint32_t block;
+        while (m_fullBlocks.pop(block)) {
+            const size_t used = m_blockUsed[block];
+            if (std::fwrite(m_blocks[block].get(), 1, used, m_file) == used) {
+                m_index->add(reinterpret_cast<const TrackRecord*>(m_blocks[block].get()), used / sizeof(TrackRecord));
+                m_recordsWritten.fetch_add(used / sizeof(TrackRecord), std::memory_order_relaxed);
+            } else {
+                m_writeFailed.store(true, std::memory_order_relaxed);
+            }
+            m_freeBlocks.push(block);
+        }
+
+        if (m_stopping.load(std::memory_order_acquire)) {
+            if (m_fullBlocks.empty()) break;
+            continue;
+        }
+
+        // Producers notify without the lock, so also wake on a short timeout
+        bool woken;
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            woken = m_wake.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+                return m_stopping.load(std::memory_order_acquire) || !m_fullBlocks.empty();
+            });
+        }
+        if (!woken) {
+            flushAgedBlock();
+        }
+    }
+    std::fflush(m_file);
+}
+
+bool TrackRecorder::exportCsv(const std::string& recordingPath, const std::string& csvPath,
+                              std::string* error, const TrackRecordQuery& query)
+{
+    // A restricted query only reads the blocks the index points at
+    TrackRecordingIndex index;
+    std::vector<uint32_t> blocks;
+    if (!query.isAll()) {
+        if (!index.open(recordingPath, error)) return false;
+        blocks = index.blocksFor(query);
+    }
+
+    std::FILE* in = std::fopen(recordingPath.c_str(), "rb");
+    if (!in) {
+        setError(error, "Cannot open " + recordingPath);
+        return false;
+    }
+
+    TrackRecordingHeader header;
+    if (std::fread(&header, sizeof(header), 1, in) != 1 ||
+        std::memcmp(header.magic, RECORDING_MAGIC, sizeof(header.magic)) != 0 ||
+        header.recordSize != sizeof(TrackRecord)) {
+        std::fclose(in);
+        setError(error, recordingPath + " is not a track recording");
+        return false;
+    }
+
+    std::FILE* out = std::fopen(csvPath.c_str(), "w");
+    if (!out) {
+        std::fclose(in);
+        setError(error, "Cannot create " + csvPath);
+        return false;
+    }
+    std::setvbuf(out, nullptr, _IOFBF, 1 << 20);
+
+    const bool filtered = header.kind == static_cast<uint32_t>(TrackRecordKind::Filtered);
+    if (filtered) {
+        std::fputs("Timestamp_ms,Target_ID,Level_dB,Range_m,Azimuth_deg,Elevation_deg,Radial_Speed_m_s,"
+                   "Azimuth_Speed_deg_s,Elevation_Speed_deg_s,Velocity_kmh,Avg_Range_m\n", out);
+    } else {
+        std::fputs("Timestamp,Target_ID,Range_m,Radial_Speed_m_s,Azimuth_deg,Elevation_deg,Level_dB,"
+                   "Azimuth_Speed_deg_s,Elevation_Speed_deg_s,System_Time\n", out);
+    }
+
+    char systemTime[40] = {0};
+    qint64 systemTimeSecond = -1;
+    auto writeRecord = [&](const TrackRecord& r) {
+        if (filtered) {
+            std::fprintf(out, "%lld,%u,%g,%g,%g,%g,%g,%g,%g,%g,%g\n",
+                         static_cast<long long>(r.timestamp), r.target_id, r.level, r.radius,
+                         r.azimuth, r.elevation, r.radial_speed, r.azimuth_speed,
+                         r.elevation_speed, r.velocity_kmh, r.avg_range);
+        } else {
+            // Date formatting is the slow part; most records share a second
+            if (r.timestamp / 1000 != systemTimeSecond) {
+                systemTimeSecond = r.timestamp / 1000;
+                formatSystemTime(r.timestamp, systemTime, sizeof(systemTime));
+            } else {
+                std::snprintf(systemTime + 20, sizeof(systemTime) - 20, "%03d",
+                              static_cast<int>(r.timestamp % 1000));
+            }
+            std::fprintf(out, "%lld,%u,%g,%g,%g,%g,%g,%g,%g,%s\n",
+                         static_cast<long long>(r.timestamp), r.target_id, r.radius,
+                         r.radial_speed, r.azimuth, r.elevation, r.level, r.azimuth_speed,
+                         r.elevation_speed, systemTime);
+        }
+    };
+
+    std::vector<TrackRecord> chunk(EXPORT_CHUNK_RECORDS);
+    size_t n;
+    bool seekFailed = false;
+    if (query.isAll()) {
+        while ((n = std::fread(chunk.data(), sizeof(TrackRecord), chunk.size(), in)) > 0) {
+            for (size_t i = 0; i < n; ++i) {
+                writeRecord(chunk[i]);
+            }
+        }
+    } else {
+        chunk.resize(TrackRecordingIndex::BLOCK_RECORDS);
+        for (uint32_t block : blocks) {
+            if (!TrackRecordingIndex::seekRecord(in, uint64_t(block) * TrackRecordingIndex::BLOCK_RECORDS)) {
+                seekFailed = true;
+                break;
+            }
+            n = std::fread(chunk.data(), sizeof(TrackRecord), chunk.size(), in);
+            for (size_t i = 0; i < n; ++i) {
+                if (query.matches(chunk[i])) writeRecord(chunk[i]);
+            }
+        }
+    }
+
+    const bool ok = !seekFailed && !std::ferror(in) && !std::ferror(out);
+    std::fclose(in);
+    if (std::fclose(out) != 0 || !ok) {
+        setError(error, "Error writing " + csvPath);
+        return false;
+    }
+    return true;
+}
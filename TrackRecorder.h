@@ -0,0 +1,158 @@
+#ifndef TRACKRECORDER_H
+#define TRACKRECORDER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <QtGlobal>
+#include "DataStructures.h"
+#include "SpscQueue.h"
+
+// One fixed-size record of a track recording (48 bytes, little-endian)
+struct TrackRecord {
+    qint64 timestamp;           // ms since epoch
+    uint32_t target_id;
+    float level;                // dB
+    float radius;               // m
+    float azimuth;              // deg
+    float elevation;            // deg
+    float radial_speed;         // m/s
+    float azimuth_speed;        // deg/s
+    float elevation_speed;      // deg/s
+    float velocity_kmh;         // Filtered recordings only
+    float avg_range;            // m, filtered recordings only
+
+    static TrackRecord fromTarget(const TargetTrack& target, qint64 timestamp,
+                                  float velocityKmh = 0.0f, float avgRange = 0.0f);
+};
+static_assert(sizeof(TrackRecord) == 48, "TrackRecord is an on-disk format");
+
+enum class TrackRecordKind : uint32_t {
+    Raw = 0,                    // Every received target packet
+    Filtered = 1                // Tracks passing the time-series filters
+};
+
+// File header preceding the records
+struct TrackRecordingHeader {
+    char magic[4];              // "TRKR"
+    uint16_t version;
+    uint16_t recordSize;        // sizeof(TrackRecord)
+    uint32_t kind;              // TrackRecordKind
+    uint32_t reserved;
+    qint64 startTime;           // ms since epoch
+};
+static_assert(sizeof(TrackRecordingHeader) == 24, "TrackRecordingHeader is an on-disk format");
+
+// Records of some tracks within a time window
+struct TrackRecordQuery {
+    std::vector<uint32_t> trackIds;             // Empty: every track
+    qint64 from = std::numeric_limits<qint64>::min();
+    qint64 to = std::numeric_limits<qint64>::max();
+
+    bool isAll() const
+    {
+        return trackIds.empty() && from == std::numeric_limits<qint64>::min() &&
+               to == std::numeric_limits<qint64>::max();
+    }
+    bool matches(const TrackRecord& record) const
+    {
+        return record.timestamp >= from && record.timestamp <= to &&
+               (trackIds.empty() ||
+                std::find(trackIds.begin(), trackIds.end(), record.target_id) != trackIds.end());
+    }
+};
+
+class TrackRecordingIndex;
+
+// Asynchronous binary track recorder.
+//
+// The producer (GUI) thread copies each record into the current 64 KiB
+// block; nothing is formatted and no I/O happens on that thread. Full
+// blocks are handed to a writer thread through a lock-free SPSC queue and
+// come back through a second one once written, so the producer fills one
+// block while the writer writes the other (NUM_BLOCKS allows some slack for
+// slow disks). Each block goes to disk as one unbuffered write. A partly
+// filled block is handed over once it holds a second of data, or by the
+// writer once it has been open for a second of wall time when the feed
+// stops, so a crash loses at most about that much. The open block is
+// guarded by a mutex the writer only holds for that hand-over, never across
+// I/O. If the disk falls so far behind that no
+// block is free, records are dropped and counted rather than stalling the
+// GUI. The writer thread also indexes each block it writes; the index
+// (TrackRecordingIndex) is saved next to the recording on stop().
+// exportCsv() converts a recording to CSV offline.
+class TrackRecorder
+{
+public:
+    static constexpr size_t BLOCK_BYTES = 64 * 1024;
+    static constexpr size_t NUM_BLOCKS = 8;
+    static constexpr qint64 FLUSH_INTERVAL_MS = 1000;
+
+    TrackRecorder();
+    ~TrackRecorder();
+
+    TrackRecorder(const TrackRecorder&) = delete;
+    TrackRecorder& operator=(const TrackRecorder&) = delete;
+
+    // Create the file and start the writer thread
+    bool start(const std::string& path, TrackRecordKind kind, qint64 startTime);
+    // Write out everything recorded so far and close the file
+    void stop();
+    bool isRecording() const { return m_file != nullptr; }
+    const std::string& path() const { return m_path; }
+
+    // Producer thread only; never waits on I/O
+    void record(const TrackRecord& record);
+
+    uint64_t recordsWritten() const { return m_recordsWritten.load(std::memory_order_relaxed); }
+    uint64_t recordsDropped() const { return m_recordsDropped.load(std::memory_order_relaxed); }
+    bool writeFailed() const { return m_writeFailed.load(std::memory_order_relaxed); }
+
+    // Convert a recording to CSV with the columns of the former text logs.
+    // A restricted query reads only the blocks its index points at.
+    static bool exportCsv(const std::string& recordingPath, const std::string& csvPath,
+                          std::string* error = nullptr, const TrackRecordQuery& query = TrackRecordQuery());
+
+private:
+    bool acquireBlock();
+    void submitBlock();
+    void flushAgedBlock();
+    void writerLoop();
+
+    std::string m_path;
+    std::FILE* m_file;
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    std::vector<size_t> m_blockUsed;        // Written by the producer before submit
+    SpscQueue<uint32_t> m_fullBlocks;       // Producer -> writer, pushed under m_blockMutex
+    SpscQueue<uint32_t> m_freeBlocks;       // Writer -> producer
+
+    // Open block, shared with the writer's aged-block flush
+    std::mutex m_blockMutex;
+    int m_currentBlock;                     // -1 when no block is held
+    qint64 m_blockStartTime;
+    std::chrono::steady_clock::time_point m_blockOpenedAt;
+
+    // Writer thread
+    std::thread m_writer;
+    std::atomic<bool> m_stopping;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+
+    std::unique_ptr<TrackRecordingIndex> m_index;   // Writer thread only
+
+    std::atomic<uint64_t> m_recordsWritten;
+    std::atomic<uint64_t> m_recordsDropped;
+    std::atomic<bool> m_writeFailed;
+};
+
+#endif // TRACKRECORDER_H
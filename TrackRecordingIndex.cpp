@@ -0,0 +1,292 @@
+#include "TrackRecordingIndex.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+const char INDEX_MAGIC[4] = {'T', 'R', 'K', 'I'};
+constexpr uint16_t INDEX_VERSION = 1;
+
+void setError(std::string* error, const std::string& message)
+{
+    if (error) *error = message;
+}
+
+// fseek/ftell take a long, which is 32 bits on Windows
+bool seek64(std::FILE* file, int64_t offset, int origin)
+{
+#ifdef _WIN32
+    return _fseeki64(file, offset, origin) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+}
+
+int64_t tell64(std::FILE* file)
+{
+#ifdef _WIN32
+    return _ftelli64(file);
+#else
+    return static_cast<int64_t>(ftello(file));
+#endif
+}
+
+bool readRecordingHeader(std::FILE* file, const std::string& path, std::string* error)
+{
+    TrackRecordingHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, "TRKR", sizeof(header.magic)) != 0 ||
+        header.recordSize != sizeof(TrackRecord)) {
+        setError(error, path + " is not a track recording");
+        return false;
+    }
+    return true;
+}
+}
+
+TrackRecordingIndex::TrackRecordingIndex()
+    : m_records(0)
+    , m_boundsValid(false)
+{
+}
+
+void TrackRecordingIndex::clear()
+{
+    m_blocks.clear();
+    m_records = 0;
+    m_trackIndex.clear();
+    m_trackIds.clear();
+    m_postings.clear();
+    m_boundsValid = false;
+}
+
+void TrackRecordingIndex::add(const TrackRecord* records, size_t count)
+{
+    uint32_t lastId = 0;
+    uint32_t lastSlot = TrackIndex::NO_SLOT;
+    for (size_t i = 0; i < count; ++i) {
+        const TrackRecord& r = records[i];
+        const uint32_t blockNumber = static_cast<uint32_t>(m_records / BLOCK_RECORDS);
+        if (blockNumber == m_blocks.size()) {
+            m_blocks.push_back({r.timestamp, r.timestamp});
+        } else {
+            Block& block = m_blocks.back();
+            block.minTime = std::min(block.minTime, r.timestamp);
+            block.maxTime = std::max(block.maxTime, r.timestamp);
+        }
+
+        if (r.target_id != lastId || lastSlot == TrackIndex::NO_SLOT) {
+            lastSlot = m_trackIndex.find(r.target_id);
+            if (lastSlot == TrackIndex::NO_SLOT) {
+                lastSlot = static_cast<uint32_t>(m_postings.size());
+                m_trackIndex.insert(r.target_id, lastSlot);
+                m_trackIds.push_back(r.target_id);
+                m_postings.emplace_back();
+            }
+            lastId = r.target_id;
+        }
+        std::vector<uint32_t>& posting = m_postings[lastSlot];
+        if (posting.empty() || posting.back() != blockNumber) {
+            posting.push_back(blockNumber);
+        }
+        ++m_records;
+    }
+    m_boundsValid = false;
+}
+
+qint64 TrackRecordingIndex::startTime() const
+{
+    updateBounds();
+    return m_minFromBack.empty() ? 0 : m_minFromBack.front();
+}
+
+qint64 TrackRecordingIndex::endTime() const
+{
+    updateBounds();
+    return m_maxFromFront.empty() ? 0 : m_maxFromFront.back();
+}
+
+void TrackRecordingIndex::updateBounds() const
+{
+    if (m_boundsValid) return;
+    const size_t n = m_blocks.size();
+    m_maxFromFront.resize(n);
+    m_minFromBack.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        m_maxFromFront[i] = i ? std::max(m_maxFromFront[i - 1], m_blocks[i].maxTime) : m_blocks[i].maxTime;
+    }
+    for (size_t i = n; i-- > 0; ) {
+        m_minFromBack[i] = i + 1 < n ? std::min(m_minFromBack[i + 1], m_blocks[i].minTime) : m_blocks[i].minTime;
+    }
+    m_boundsValid = true;
+}
+
+std::vector<uint32_t> TrackRecordingIndex::blocksFor(const TrackRecordQuery& query) const
+{
+    std::vector<uint32_t> blocks;
+    if (m_blocks.empty() || query.from > query.to) return blocks;
+    updateBounds();
+
+    // Every block before `first` ends before the window, every block from
+    // `last` on starts after it
+    const uint32_t first = static_cast<uint32_t>(
+        std::lower_bound(m_maxFromFront.begin(), m_maxFromFront.end(), query.from) - m_maxFromFront.begin());
+    const uint32_t last = static_cast<uint32_t>(
+        std::upper_bound(m_minFromBack.begin(), m_minFromBack.end(), query.to) - m_minFromBack.begin());
+    auto overlaps = [this, &query](uint32_t b) {
+        return m_blocks[b].maxTime >= query.from && m_blocks[b].minTime <= query.to;
+    };
+
+    if (query.trackIds.empty()) {
+        for (uint32_t b = first; b < last; ++b) {
+            if (overlaps(b)) blocks.push_back(b);
+        }
+        return blocks;
+    }
+
+    for (uint32_t trackId : query.trackIds) {
+        const uint32_t slot = m_trackIndex.find(trackId);
+        if (slot == TrackIndex::NO_SLOT) continue;
+        const std::vector<uint32_t>& posting = m_postings[slot];
+        for (auto it = std::lower_bound(posting.begin(), posting.end(), first);
+             it != posting.end() && *it < last; ++it) {
+            if (overlaps(*it)) blocks.push_back(*it);
+        }
+    }
+    if (query.trackIds.size() > 1) {
+        std::sort(blocks.begin(), blocks.end());
+        blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+    }
+    return blocks;
+}
+
+bool TrackRecordingIndex::save(const std::string& path, std::string* error) const
+{
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) {
+        setError(error, "Cannot create " + path);
+        return false;
+    }
+
+    TrackRecordingIndexHeader header;
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.version = INDEX_VERSION;
+    header.reserved = 0;
+    header.blockRecords = BLOCK_RECORDS;
+    header.blockCount = static_cast<uint32_t>(m_blocks.size());
+    header.trackCount = static_cast<uint32_t>(m_trackIds.size());
+    header.reserved2 = 0;
+    header.recordCount = m_records;
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(m_blocks.data(), sizeof(Block), m_blocks.size(), out) == m_blocks.size();
+    for (size_t t = 0; ok && t < m_trackIds.size(); ++t) {
+        const uint32_t entry[2] = {m_trackIds[t], static_cast<uint32_t>(m_postings[t].size())};
+        ok = std::fwrite(entry, sizeof(entry), 1, out) == 1 &&
+             std::fwrite(m_postings[t].data(), sizeof(uint32_t), m_postings[t].size(), out) == m_postings[t].size();
+    }
+    if (std::fclose(out) != 0 || !ok) {
+        std::remove(path.c_str());
+        setError(error, "Error writing " + path);
+        return false;
+    }
+    return true;
+}
+
+bool TrackRecordingIndex::load(const std::string& path, std::string* error)
+{
+    clear();
+    std::FILE* in = std::fopen(path.c_str(), "rb");
+    if (!in) {
+        setError(error, "Cannot open " + path);
+        return false;
+    }
+
+    TrackRecordingIndexHeader header;
+    bool ok = std::fread(&header, sizeof(header), 1, in) == 1 &&
+              std::memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) == 0 &&
+              header.version == INDEX_VERSION && header.blockRecords == BLOCK_RECORDS &&
+              header.blockCount == (header.recordCount + BLOCK_RECORDS - 1) / BLOCK_RECORDS;
+    if (ok) {
+        m_blocks.resize(header.blockCount);
+        ok = std::fread(m_blocks.data(), sizeof(Block), m_blocks.size(), in) == m_blocks.size();
+    }
+    for (uint32_t t = 0; ok && t < header.trackCount; ++t) {
+        uint32_t entry[2];
+        ok = std::fread(entry, sizeof(entry), 1, in) == 1 && entry[1] <= header.blockCount &&
+             !m_trackIndex.contains(entry[0]);
+        if (!ok) break;
+        std::vector<uint32_t> posting(entry[1]);
+        ok = std::fread(posting.data(), sizeof(uint32_t), posting.size(), in) == posting.size() &&
+             std::is_sorted(posting.begin(), posting.end()) &&
+             (posting.empty() || posting.back() < header.blockCount);
+        m_trackIndex.insert(entry[0], static_cast<uint32_t>(m_postings.size()));
+        m_trackIds.push_back(entry[0]);
+        m_postings.push_back(std::move(posting));
+    }
+    std::fclose(in);
+
+    if (!ok) {
+        clear();
+        setError(error, path + " is not a valid track recording index");
+        return false;
+    }
+    m_records = header.recordCount;
+    return true;
+}
+
+bool TrackRecordingIndex::build(const std::string& recordingPath, std::string* error)
+{
+    clear();
+    std::FILE* in = std::fopen(recordingPath.c_str(), "rb");
+    if (!in) {
+        setError(error, "Cannot open " + recordingPath);
+        return false;
+    }
+    if (!readRecordingHeader(in, recordingPath, error)) {
+        std::fclose(in);
+        return false;
+    }
+
+    std::vector<TrackRecord> chunk(BLOCK_RECORDS);
+    size_t n;
+    while ((n = std::fread(chunk.data(), sizeof(TrackRecord), chunk.size(), in)) > 0) {
+        add(chunk.data(), n);
+    }
+    const bool ok = !std::ferror(in);
+    std::fclose(in);
+    if (!ok) {
+        clear();
+        setError(error, "Error reading " + recordingPath);
+    }
+    return ok;
+}
+
+bool TrackRecordingIndex::open(const std::string& recordingPath, std::string* error)
+{
+    std::FILE* in = std::fopen(recordingPath.c_str(), "rb");
+    if (!in) {
+        setError(error, "Cannot open " + recordingPath);
+        return false;
+    }
+    const bool isRecording = readRecordingHeader(in, recordingPath, error);
+    const int64_t size = isRecording && seek64(in, 0, SEEK_END) ? tell64(in) : -1;
+    std::fclose(in);
+    if (!isRecording) return false;
+    const uint64_t records = size > static_cast<int64_t>(sizeof(TrackRecordingHeader))
+        ? static_cast<uint64_t>(size - static_cast<int64_t>(sizeof(TrackRecordingHeader))) / sizeof(TrackRecord)
+        : 0;
+
+    // A recording cut short (crash, failed write) has a missing or stale index
+    if (load(indexPath(recordingPath)) && m_records == records) {
+        return true;
+    }
+    if (!build(recordingPath, error)) {
+        return false;
+    }
+    save(indexPath(recordingPath));         // Best effort: the media may be read-only
+    return true;
+}
+
+bool TrackRecordingIndex::seekRecord(std::FILE* file, uint64_t index)
+{
+    return seek64(file, static_cast<int64_t>(sizeof(TrackRecordingHeader) + index * sizeof(TrackRecord)), SEEK_SET);
+}
@@ -0,0 +1,93 @@
+#ifndef TRACKRECORDINGINDEX_H
+#define TRACKRECORDINGINDEX_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <QtGlobal>
+#include "TrackRecorder.h"
+#include "TrackStateStore.h"
+
+// Index file header, followed by blockCount TrackRecordingIndex::Block
+// entries, then for each track its id, its block count and the block
+// numbers (uint32, ascending)
+struct TrackRecordingIndexHeader {
+    char magic[4];              // "TRKI"
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t blockRecords;      // BLOCK_RECORDS when written
+    uint32_t blockCount;
+    uint32_t trackCount;
+    uint32_t reserved2;
+    uint64_t recordCount;       // Records in the recording when indexed
+};
+static_assert(sizeof(TrackRecordingIndexHeader) == 32, "TrackRecordingIndexHeader is an on-disk format");
+
+// Sparse index of a track recording (.trk).
+//
+// The records are taken in fixed blocks of BLOCK_RECORDS; for each block
+// the index keeps its time span, and for each track id a posting list of
+// the blocks holding its records. A query ("track 17 between 10:02 and
+// 10:05") binary-searches the time spans and intersects them with the
+// tracks' posting lists, so only the blocks returned need to be read.
+// Time spans need not be ordered: the search runs over running maxima
+// and minima of the spans, which are.
+//
+// TrackRecorder builds the index while writing and saves it next to the
+// recording (indexPath()); open() loads it, or rebuilds and saves it if it
+// is missing or does not cover the whole recording.
+class TrackRecordingIndex
+{
+public:
+    static constexpr uint32_t BLOCK_RECORDS = 1024;
+
+    struct Block {
+        qint64 minTime;         // ms since epoch
+        qint64 maxTime;
+    };
+
+    TrackRecordingIndex();
+
+    void clear();
+    // Index the next `count` records of the recording
+    void add(const TrackRecord* records, size_t count);
+
+    uint64_t recordCount() const { return m_records; }
+    size_t blockCount() const { return m_blocks.size(); }
+    const Block& block(size_t i) const { return m_blocks[i]; }
+    const std::vector<uint32_t>& trackIds() const { return m_trackIds; }
+    // Earliest and latest record time (0 when empty)
+    qint64 startTime() const;
+    qint64 endTime() const;
+
+    // Blocks that may hold records matching `query`, ascending
+    std::vector<uint32_t> blocksFor(const TrackRecordQuery& query) const;
+
+    bool save(const std::string& path, std::string* error = nullptr) const;
+    bool load(const std::string& path, std::string* error = nullptr);
+    // Index a recording by reading it through once
+    bool build(const std::string& recordingPath, std::string* error = nullptr);
+    // Load the recording's index file, rebuilding it if needed
+    bool open(const std::string& recordingPath, std::string* error = nullptr);
+
+    static std::string indexPath(const std::string& recordingPath) { return recordingPath + ".idx"; }
+    // Position `file` (a recording) at record `index`; 64-bit safe
+    static bool seekRecord(std::FILE* file, uint64_t index);
+
+private:
+    void updateBounds() const;
+
+    std::vector<Block> m_blocks;
+    uint64_t m_records;
+    TrackIndex m_trackIndex;                        // Track id -> posting list
+    std::vector<uint32_t> m_trackIds;
+    std::vector<std::vector<uint32_t>> m_postings;  // Blocks per track, ascending
+
+    // Running max of maxTime from the front and min of minTime from the back
+    mutable std::vector<qint64> m_maxFromFront;
+    mutable std::vector<qint64> m_minFromBack;
+    mutable bool m_boundsValid;
+};
+
+#endif // TRACKRECORDINGINDEX_H
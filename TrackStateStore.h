@@ -0,0 +1,385 @@
+#ifndef TRACKSTATESTORE_H
+#define TRACKSTATESTORE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <QtGlobal>
+
+// Open-addressing map from track id to a dense slot index.
+//
+// Entries live in one power-of-two array probed linearly from the hashed id,
+// so a lookup touches one or two adjacent cache lines instead of chasing
+// buckets. Deletion shifts the following run back into the hole (no
+// tombstones), which keeps probe lengths short under constant track churn.
+// The table doubles when it would pass half full.
+class TrackIndex
+{
+public:
+    static constexpr uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    explicit TrackIndex(size_t expectedTracks = 32)
+        : m_mask(0)
+        , m_size(0)
+    {
+        reserve(expectedTracks);
+    }
+
+    // Size the table for n tracks without further growth
+    void reserve(size_t n)
+    {
+        size_t cap = 16;
+        while (cap < 2 * n) {
+            cap <<= 1;
+        }
+        if (cap > m_entries.size()) {
+            rehash(cap);
+        }
+    }
+
+    uint32_t find(uint32_t trackId) const
+    {
+        for (size_t i = home(trackId); ; i = (i + 1) & m_mask) {
+            const Entry& e = m_entries[i];
+            if (e.slot == NO_SLOT) return NO_SLOT;
+            if (e.id == trackId) return e.slot;
+        }
+    }
+
+    bool contains(uint32_t trackId) const { return find(trackId) != NO_SLOT; }
+
+    // Insert or overwrite the slot for trackId
+    void insert(uint32_t trackId, uint32_t slot)
+    {
+        if (2 * (m_size + 1) > m_entries.size()) {
+            rehash(2 * m_entries.size());
+        }
+        size_t i = home(trackId);
+        while (m_entries[i].slot != NO_SLOT && m_entries[i].id != trackId) {
+            i = (i + 1) & m_mask;
+        }
+        if (m_entries[i].slot == NO_SLOT) {
+            ++m_size;
+        }
+        m_entries[i].id = trackId;
+        m_entries[i].slot = slot;
+    }
+
+    bool erase(uint32_t trackId)
+    {
+        size_t i = home(trackId);
+        for (; ; i = (i + 1) & m_mask) {
+            if (m_entries[i].slot == NO_SLOT) return false;
+            if (m_entries[i].id == trackId) break;
+        }
+
+        // Backward-shift: move later entries of the run into the hole unless
+        // their home position lies cyclically in (hole, j]
+        size_t hole = i;
+        for (size_t j = (i + 1) & m_mask; m_entries[j].slot != NO_SLOT; j = (j + 1) & m_mask) {
+            const size_t k = home(m_entries[j].id);
+            const bool stays = (hole <= j) ? (hole < k && k <= j) : (hole < k || k <= j);
+            if (!stays) {
+                m_entries[hole] = m_entries[j];
+                hole = j;
+            }
+        }
+        m_entries[hole].slot = NO_SLOT;
+        --m_size;
+        return true;
+    }
+
+    void clear()
+    {
+        for (Entry& e : m_entries) {
+            e.slot = NO_SLOT;
+        }
+        m_size = 0;
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    struct Entry {
+        uint32_t id = 0;
+        uint32_t slot = NO_SLOT;
+    };
+
+    size_t home(uint32_t id) const
+    {
+        // 32-bit integer finaliser: sequential track ids spread over the table
+        id ^= id >> 16;
+        id *= 0x7feb352du;
+        id ^= id >> 15;
+        id *= 0x846ca68bu;
+        id ^= id >> 16;
+        return id & m_mask;
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<Entry> old;
+        old.swap(m_entries);
+        m_entries.assign(capacity, Entry());
+        m_mask = capacity - 1;
+        m_size = 0;
+        for (const Entry& e : old) {
+            if (e.slot != NO_SLOT) {
+                insert(e.id, e.slot);
+            }
+        }
+    }
+
+    std::vector<Entry> m_entries;
+    size_t m_mask;
+    size_t m_size;
+};
+
+// Read/write view of one track's history ring, oldest sample first
+template<typename T>
+class TrackHistoryView
+{
+public:
+    TrackHistoryView(T* base, size_t capacity, size_t start, size_t count)
+        : m_base(base), m_capacity(capacity), m_start(start), m_count(count) {}
+
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+    T& operator[](size_t i) const
+    {
+        size_t k = m_start + i;
+        if (k >= m_capacity) k -= m_capacity;
+        return m_base[k];
+    }
+    T& front() const { return (*this)[0]; }
+    T& back() const { return (*this)[m_count - 1]; }
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::remove_const<T>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator(const TrackHistoryView* view, size_t i) : m_view(view), m_i(i) {}
+        reference operator*() const { return (*m_view)[m_i]; }
+        pointer operator->() const { return &(*m_view)[m_i]; }
+        iterator& operator++() { ++m_i; return *this; }
+        bool operator==(const iterator& other) const { return m_i == other.m_i; }
+        bool operator!=(const iterator& other) const { return m_i != other.m_i; }
+
+    private:
+        const TrackHistoryView* m_view;
+        size_t m_i;
+    };
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, m_count); }
+
+private:
+    T* m_base;
+    size_t m_capacity;
+    size_t m_start;
+    size_t m_count;
+};
+
+struct NoTrackMeta {};
+
+// Fixed-capacity per-track state: an id -> slot index plus a history ring of
+// up to `historyLength` samples for each of `maxTracks` slots.
+//
+// A slot's ring grows as samples arrive and is freed when the slot is
+// released, so short-lived tracks cost little and the footprint never
+// passes maxTracks x historyLength however many tracks come and go. Tracks
+// not seen for a given age are evicted with evictOlderThan(); when every
+// slot is taken, acquire() recycles the least recently seen track. Meta is
+// optional per-track bookkeeping, reset to Meta() whenever its slot is
+// released.
+template<typename T, typename Meta = NoTrackMeta>
+class TrackStateStore
+{
+public:
+    static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+
+    TrackStateStore(size_t maxTracks, size_t historyLength)
+        : m_index(maxTracks)
+        , m_maxTracks(maxTracks)
+        , m_historyLength(historyLength)
+        , m_rings(maxTracks)
+        , m_trackId(maxTracks, 0)
+        , m_active(maxTracks, 0)
+        , m_head(maxTracks, 0)
+        , m_count(maxTracks, 0)
+        , m_firstSeen(maxTracks, 0)
+        , m_lastSeen(maxTracks, 0)
+        , m_meta(maxTracks)
+    {
+        clear();
+    }
+
+    size_t find(uint32_t trackId) const
+    {
+        const uint32_t slot = m_index.find(trackId);
+        return slot == TrackIndex::NO_SLOT ? NO_SLOT : slot;
+    }
+
+    bool contains(uint32_t trackId) const { return m_index.contains(trackId); }
+
+    // Slot for trackId, creating it if needed; refreshes the last-seen time.
+    // A recycled track's id is appended to `evicted` when given. NO_SLOT
+    // only for a store with no slots at all.
+    size_t acquire(uint32_t trackId, qint64 timestamp, std::vector<uint32_t>* evicted = nullptr)
+    {
+        size_t slot = find(trackId);
+        if (slot == NO_SLOT) {
+            if (m_maxTracks == 0) return NO_SLOT;
+            if (m_freeSlots.empty()) {
+                const size_t oldest = leastRecentlySeen();
+                if (evicted) evicted->push_back(m_trackId[oldest]);
+                release(oldest);
+            }
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            m_index.insert(trackId, static_cast<uint32_t>(slot));
+            m_trackId[slot] = trackId;
+            m_active[slot] = 1;
+            m_head[slot] = 0;
+            m_count[slot] = 0;
+            m_firstSeen[slot] = timestamp;
+            m_lastSeen[slot] = timestamp;
+        } else {
+            if (timestamp < m_firstSeen[slot]) m_firstSeen[slot] = timestamp;
+            if (timestamp > m_lastSeen[slot]) m_lastSeen[slot] = timestamp;
+        }
+        return slot;
+    }
+
+    // Append a sample, overwriting the oldest once the ring is full
+    void push(size_t slot, const T& sample)
+    {
+        if (m_historyLength == 0) return;
+        std::vector<T>& ring = m_rings[slot];
+        if (ring.size() < m_historyLength) {
+            ring.push_back(sample);
+        } else {
+            ring[m_head[slot]] = sample;
+        }
+        m_head[slot] = (m_head[slot] + 1 == m_historyLength) ? 0 : m_head[slot] + 1;
+        if (m_count[slot] < m_historyLength) ++m_count[slot];
+    }
+
+    // Drop every track last seen before `cutoff`; returns the number dropped
+    size_t evictOlderThan(qint64 cutoff, std::vector<uint32_t>* evicted = nullptr)
+    {
+        return evictOlderThan(cutoff, evicted, [](size_t) { return false; });
+    }
+
+    // As above, but slots for which keep(slot) is true are never dropped
+    template<typename KeepFn>
+    size_t evictOlderThan(qint64 cutoff, std::vector<uint32_t>* evicted, KeepFn keep)
+    {
+        size_t dropped = 0;
+        for (size_t slot = 0; slot < m_maxTracks; ++slot) {
+            if (m_active[slot] && m_lastSeen[slot] < cutoff && !keep(slot)) {
+                if (evicted) evicted->push_back(m_trackId[slot]);
+                release(slot);
+                ++dropped;
+            }
+        }
+        return dropped;
+    }
+
+    void release(size_t slot)
+    {
+        if (!m_active[slot]) return;
+        m_index.erase(m_trackId[slot]);
+        m_active[slot] = 0;
+        m_count[slot] = 0;
+        std::vector<T>().swap(m_rings[slot]);
+        m_meta[slot] = Meta();
+        m_freeSlots.push_back(slot);
+    }
+
+    bool remove(uint32_t trackId)
+    {
+        const size_t slot = find(trackId);
+        if (slot == NO_SLOT) return false;
+        release(slot);
+        return true;
+    }
+
+    void clear()
+    {
+        m_index.clear();
+        m_freeSlots.clear();
+        // Hand out low slots first
+        for (size_t slot = m_maxTracks; slot-- > 0; ) {
+            m_active[slot] = 0;
+            m_count[slot] = 0;
+            std::vector<T>().swap(m_rings[slot]);
+            m_meta[slot] = Meta();
+            m_freeSlots.push_back(slot);
+        }
+    }
+
+    size_t size() const { return m_index.size(); }
+    bool empty() const { return m_index.empty(); }
+    size_t maxTracks() const { return m_maxTracks; }
+    size_t historyLength() const { return m_historyLength; }
+
+    // Slots are 0 .. maxTracks()-1; only active slots hold a track
+    bool isActive(size_t slot) const { return m_active[slot] != 0; }
+    uint32_t trackId(size_t slot) const { return m_trackId[slot]; }
+    qint64 firstSeen(size_t slot) const { return m_firstSeen[slot]; }
+    qint64 lastSeen(size_t slot) const { return m_lastSeen[slot]; }
+    Meta& meta(size_t slot) { return m_meta[slot]; }
+    const Meta& meta(size_t slot) const { return m_meta[slot]; }
+
+    TrackHistoryView<T> history(size_t slot)
+    {
+        return TrackHistoryView<T>(m_rings[slot].data(), m_historyLength, ringStart(slot), m_count[slot]);
+    }
+    TrackHistoryView<const T> history(size_t slot) const
+    {
+        return TrackHistoryView<const T>(m_rings[slot].data(), m_historyLength, ringStart(slot), m_count[slot]);
+    }
+
+private:
+    size_t ringStart(size_t slot) const
+    {
+        const size_t head = m_head[slot];
+        const size_t count = m_count[slot];
+        return head >= count ? head - count : head + m_historyLength - count;
+    }
+
+    size_t leastRecentlySeen() const
+    {
+        size_t oldest = 0;
+        for (size_t slot = 1; slot < m_maxTracks; ++slot) {
+            if (m_lastSeen[slot] < m_lastSeen[oldest]) oldest = slot;
+        }
+        return oldest;
+    }
+
+    TrackIndex m_index;
+    size_t m_maxTracks;
+    size_t m_historyLength;
+
+    std::vector<std::vector<T>> m_rings;    // Per slot, grown up to historyLength
+    std::vector<uint32_t> m_trackId;
+    std::vector<uint8_t> m_active;
+    std::vector<size_t> m_head;         // Next write position in the slot's ring
+    std::vector<size_t> m_count;
+    std::vector<qint64> m_firstSeen;
+    std::vector<qint64> m_lastSeen;
+    std::vector<Meta> m_meta;
+    std::vector<size_t> m_freeSlots;
+};
+
+#endif // TRACKSTATESTORE_H
@@ -13,6 +13,7 @@ UdpHandler::UdpHandler(QObject *parent)
     , remotePort(5001)
     , maxDetections(1000)
     , detectionTimeoutMs(60000) // 60 seconds
+    , clusteringEnabled(true)
     , packetsReceived(0)
     , packetsDropped(0)
     , lastStatisticsUpdate(0)
@@ -117,6 +118,42 @@ int UdpHandler::getDetectionCount() const
     return detections.size();
 }
 
+TargetTrackData UdpHandler::getConfirmedTracks() const
+{
+    QMutexLocker locker(&detectionsMutex);
+    return tracker.confirmedTracks();
+}
+
+void UdpHandler::setTrackerConfig(const DetectionTracker::Config& config)
+{
+    QMutexLocker locker(&detectionsMutex);
+    tracker.setConfig(config);
+}
+
+std::vector<DetectionClusterer::Cluster> UdpHandler::getLastClusters() const
+{
+    QMutexLocker locker(&detectionsMutex);
+    return clusterer.clusters();
+}
+
+void UdpHandler::setClusteringEnabled(bool enabled)
+{
+    QMutexLocker locker(&detectionsMutex);
+    clusteringEnabled = enabled;
+}
+
+bool UdpHandler::isClusteringEnabled() const
+{
+    QMutexLocker locker(&detectionsMutex);
+    return clusteringEnabled;
+}
+
+void UdpHandler::setClustererConfig(const DetectionClusterer::Config& config)
+{
+    QMutexLocker locker(&detectionsMutex);
+    clusterer.setConfig(config);
+}
+
 double UdpHandler::getDataRate() const
 {
     qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
@@ -185,6 +222,7 @@ bool UdpHandler::parseDetectionData(const QString& data)
 //    return false;
 
     QStringList lines = data.split("\n", QString::SkipEmptyParts);
+    frameDetections.clear();
 
     //QVector<DetectionData> targets;
     DetectionData targets;
@@ -211,7 +249,23 @@ bool UdpHandler::parseDetectionData(const QString& data)
         }
        // targets.append(target);
         addDetection(targets);
+        frameDetections.push_back(targets);
+    }
+
+    // All lines of one datagram belong to the same frame. Several detections
+    // of one vehicle are merged into a single object before association.
+    {
+        QMutexLocker locker(&detectionsMutex);
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        if (clusteringEnabled) {
+            clusterer.process(frameDetections);
+            clusterer.centroids(clusterCentroids);
+            tracker.processFrame(clusterCentroids, now);
+        } else {
+            tracker.processFrame(frameDetections, now);
+        }
     }
+    emit tracksUpdated();
     return true;
 }
 
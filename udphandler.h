@@ -16,6 +16,8 @@
 #include <vector>
 #include <memory>
 #include "structures.h"
+#include "DetectionTracker.h"
+#include "DetectionClusterer.h"
 
 class UdpHandler : public QObject
 {
@@ -38,6 +40,17 @@ public:
     // Data access
     std::vector<DetectionData> getRecentDetections() const;
     int getDetectionCount() const;
+
+    // Tracks built from the detections of each datagram (one datagram = one frame)
+    TargetTrackData getConfirmedTracks() const;
+    void setTrackerConfig(const DetectionTracker::Config& config);
+
+    // Objects formed by clustering the last frame's detections; when enabled,
+    // the tracker is fed cluster centroids instead of raw detections
+    std::vector<DetectionClusterer::Cluster> getLastClusters() const;
+    void setClusteringEnabled(bool enabled);
+    bool isClusteringEnabled() const;
+    void setClustererConfig(const DetectionClusterer::Config& config);
     
     // Send DSP settings to radar
     bool sendDSPSettings(const DSP_Settings_t& settings);
@@ -51,6 +64,7 @@ signals:
     void connectionStatusChanged(bool connected);
     void newDetectionReceived(const DetectionData& detection);
     void detectionsUpdated();
+    void tracksUpdated();
     void errorOccurred(const QString& error);
     void statisticsUpdated(int packetsReceived, int packetsDropped, double dataRate);
     void dspSettingsSent(bool success);
@@ -77,6 +91,13 @@ private:
     std::vector<DetectionData> detections;
     int maxDetections;
     int detectionTimeoutMs;
+
+    // Detection-to-track association (guarded by detectionsMutex)
+    DetectionTracker tracker;
+    std::vector<DetectionData> frameDetections;
+    DetectionClusterer clusterer;
+    std::vector<DetectionData> clusterCentroids;
+    bool clusteringEnabled;
     
     // Statistics
     QTimer* cleanupTimer;